@@ -6,14 +6,31 @@
 // Usage example:
 //   AppSettings s; // default-construct a handle to the shared instance
 //   s->setValue("foo", 123);
+//
+// High-frequency keys (e.g. frame addresses that change on every SPA hash
+// update) should use the write-behind path instead:
+//   AppSettings::setValueDeferred("addresses", list);
+// Deferred values are coalesced in memory for WRITE_BEHIND_DELAY_MS and then
+// written by a background thread with its own QSettings on the same file.
+// Call AppSettings::flushDeferred() before quitting/closing (main.cpp and
+// SplitWindow::closeEvent already do) or before synchronously writing a key
+// that may also have a deferred write pending.
 
 #pragma once
 
+#include <QDebug>
 #include <QDir>
 #include <QFileInfo>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+#include <atomic>
 
 class AppSettings {
 public:
@@ -38,7 +55,119 @@ public:
     return base + QLatin1Char('/') + customSettingsFileName();
   }
 
+  // Coalescing window for deferred writes. The timer is not restarted by
+  // further writes, so a steady stream of updates still lands on disk at
+  // most this long after the first one.
+  static constexpr int WRITE_BEHIND_DELAY_MS = 2000;
+
+  // Record a value to be written later. `key` is an absolute path; groups
+  // opened on the shared handle do not apply. Must be called from the GUI
+  // thread (the coalescing timer lives there). Repeated writes to the same
+  // key within the window collapse into one.
+  static void setValueDeferred(const QString &key, const QVariant &value) {
+    {
+      QMutexLocker lock(&deferredMutex());
+      deferredValues().insert(key, value);
+    }
+    ++deferredState().setCount;
+    QTimer &timer = deferredTimer();
+    if (!timer.isActive()) timer.start();
+  }
+
+  // Returns the pending deferred value for `key`, or the stored value when
+  // nothing is pending. Use this to read keys written with setValueDeferred.
+  static QVariant deferredValue(const QString &key, const QVariant &defaultValue = QVariant()) {
+    {
+      QMutexLocker lock(&deferredMutex());
+      const auto it = deferredValues().constFind(key);
+      if (it != deferredValues().constEnd()) return it.value();
+    }
+    return underlying().value(key, defaultValue);
+  }
+
+  // Write all pending deferred values now and block until every queued
+  // background write has reached the settings file.
+  static void flushDeferred() {
+    deferredTimer().stop();
+    scheduleDeferredWrite();
+    deferredPool().waitForDone();
+    underlying().sync(); // pick up the background writes in the shared handle
+  }
+
+  // Number of setValueDeferred() calls since startup.
+  static quint64 deferredSetCount() { return deferredState().setCount.load(); }
+
+  // Number of settings file writes performed by the write-behind thread.
+  static quint64 deferredWriteCount() { return deferredState().writeCount.load(); }
+
 private:
+  struct DeferredState {
+    std::atomic<quint64> setCount{0};   // setValueDeferred() calls
+    std::atomic<quint64> writeCount{0}; // background file writes
+  };
+
+  static DeferredState &deferredState() {
+    static DeferredState state;
+    return state;
+  }
+
+  static QMutex &deferredMutex() {
+    static QMutex mutex;
+    return mutex;
+  }
+
+  // Dirty keys not yet handed to the write-behind thread (guarded by deferredMutex()).
+  static QMap<QString, QVariant> &deferredValues() {
+    static QMap<QString, QVariant> values;
+    return values;
+  }
+
+  static QTimer &deferredTimer() {
+    static QTimer *timer = []() {
+      auto *t = new QTimer();
+      t->setSingleShot(true);
+      t->setInterval(WRITE_BEHIND_DELAY_MS);
+      QObject::connect(t, &QTimer::timeout, t, []() { scheduleDeferredWrite(); });
+      return t;
+    }();
+    return *timer;
+  }
+
+  // Single worker so batches reach the file in the order they were queued.
+  static QThreadPool &deferredPool() {
+    static QThreadPool *pool = []() {
+      auto *p = new QThreadPool();
+      p->setMaxThreadCount(1);
+      p->setExpiryTimeout(WRITE_BEHIND_DELAY_MS * 2);
+      return p;
+    }();
+    return *pool;
+  }
+
+  // Hand the current dirty set to the worker thread. QSettings instances on
+  // the same path share their parsed file in-process, so the worker's sync()
+  // merges with (and is visible to) the shared GUI-thread handle.
+  static void scheduleDeferredWrite() {
+    QMap<QString, QVariant> batch;
+    {
+      QMutexLocker lock(&deferredMutex());
+      batch.swap(deferredValues());
+    }
+    if (batch.isEmpty()) return;
+    const QString path = customSettingsPath();
+    deferredPool().start([batch, path]() {
+      QSettings writer(path, QSettings::IniFormat);
+      for (auto it = batch.constBegin(); it != batch.constEnd(); ++it) writer.setValue(it.key(), it.value());
+      writer.sync();
+      const quint64 writes = ++deferredState().writeCount;
+      if (writer.status() != QSettings::NoError) {
+        qWarning() << "AppSettings: write-behind sync failed, status=" << writer.status();
+      }
+      qDebug() << "AppSettings: write-behind wrote" << batch.size() << "key(s); writes=" << writes
+               << "deferred sets=" << deferredState().setCount.load();
+    });
+  }
+
   // Create (once) and return the underlying shared QSettings instance.
   static QSettings &underlying() {
     static QSettings *inst = []() {
@@ -0,0 +1,644 @@
+#include "ContentBlocker.h"
+#include "AppSettings.h"
+#include "Trace.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QWebEngineProfile>
+#include <QWebEngineUrlRequestInfo>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace {
+  constexpr char CACHE_MAGIC[8] = {'P', 'H', 'R', 'C', 'B', 'L', 'K', '1'};
+  constexpr quint32 CACHE_VERSION = 1;
+  constexpr int MIN_KEY_LENGTH = 3;        // shorter literals would match nearly every URL
+  constexpr int MAX_WILDCARDS = 4;         // bounds the backtracking in matchHere()
+  constexpr int MAX_COUNTED_SITES = 4096;  // blockedBySite_ is cleared beyond this
+
+  enum RuleFlag : quint32 {
+    RuleException = 1u << 0,   // @@ rule
+    RuleThirdParty = 1u << 1,  // $third-party
+    RuleFirstParty = 1u << 2,  // $~third-party
+    RuleTypeShift = 8          // resource type mask (TypeBit) in bits 8-15; 0 = any type
+  };
+
+  enum TypeBit : quint32 {
+    TypeScript = 1u << 0,
+    TypeImage = 1u << 1,
+    TypeStylesheet = 1u << 2,
+    TypeXhr = 1u << 3,
+    TypeSubdocument = 1u << 4,
+    TypeFont = 1u << 5,
+    TypeMedia = 1u << 6,
+  };
+
+  // Blob layout: header, then the arrays below in this order, then the
+  // pattern string pool. Every record is a multiple of 8 or 4 bytes so the
+  // arrays stay aligned when the file is mapped.
+  struct CacheHeader {
+    char magic[8];
+    quint32 version;
+    quint32 ruleCount;
+    quint64 fingerprint;
+    quint32 domainCount;
+    quint32 stateCount;
+    quint32 edgeCount;
+    quint32 outputCount;
+    quint32 patternCount;
+    quint32 poolSize;
+  };
+  struct DomainEntry { quint64 hash; quint32 flags; quint32 reserved; };
+  struct AcState { quint32 firstEdge, edgeCount, fail, dictLink, firstOutput, outputCount; };
+  struct AcEdge { quint32 label; quint32 target; };
+  struct PatternRule { quint32 offset, length, flags, reserved; };
+  static_assert(sizeof(CacheHeader) == 48 && sizeof(DomainEntry) == 16, "cache layout must stay packed");
+  static_assert(std::is_trivially_copyable_v<AcState> && std::is_trivially_copyable_v<PatternRule>);
+
+  quint64 fnv1a(const char *data, qsizetype size, quint64 hash = 14695981039346656037ULL) {
+    for (qsizetype i = 0; i < size; ++i) {
+      hash ^= uchar(data[i]);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /** @brief Read-only view over a compiled blob (mapped file or QByteArray). */
+  struct FilterView {
+    const CacheHeader *header = nullptr;
+    const DomainEntry *domains = nullptr;
+    const AcState *states = nullptr;
+    const AcEdge *edges = nullptr;
+    const quint32 *outputs = nullptr;
+    const PatternRule *patterns = nullptr;
+    const char *pool = nullptr;
+
+    bool attach(const uchar *data, qint64 size, quint64 fingerprint) {
+      if (!data || size < qint64(sizeof(CacheHeader))) return false;
+      const auto *h = reinterpret_cast<const CacheHeader *>(data);
+      if (std::memcmp(h->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) return false;
+      if (h->version != CACHE_VERSION || h->fingerprint != fingerprint || h->stateCount == 0) return false;
+      const qint64 need = qint64(sizeof(CacheHeader)) + qint64(h->domainCount) * sizeof(DomainEntry)
+                          + qint64(h->stateCount) * sizeof(AcState) + qint64(h->edgeCount) * sizeof(AcEdge)
+                          + qint64(h->outputCount) * sizeof(quint32) + qint64(h->patternCount) * sizeof(PatternRule)
+                          + h->poolSize;
+      if (need != size) return false;
+      const uchar *p = data + sizeof(CacheHeader);
+      domains = reinterpret_cast<const DomainEntry *>(p);
+      p += qint64(h->domainCount) * sizeof(DomainEntry);
+      states = reinterpret_cast<const AcState *>(p);
+      p += qint64(h->stateCount) * sizeof(AcState);
+      edges = reinterpret_cast<const AcEdge *>(p);
+      p += qint64(h->edgeCount) * sizeof(AcEdge);
+      outputs = reinterpret_cast<const quint32 *>(p);
+      p += qint64(h->outputCount) * sizeof(quint32);
+      patterns = reinterpret_cast<const PatternRule *>(p);
+      p += qint64(h->patternCount) * sizeof(PatternRule);
+      pool = reinterpret_cast<const char *>(p);
+      header = h;
+      return true;
+    }
+
+    quint32 step(quint32 state, uchar c) const {
+      for (;;) {
+        const AcState &s = states[state];
+        const AcEdge *begin = edges + s.firstEdge;
+        const AcEdge *end = begin + s.edgeCount;
+        const AcEdge *e = std::lower_bound(begin, end, quint32(c), [](const AcEdge &a, quint32 l) { return a.label < l; });
+        if (e != end && e->label == c) return e->target;
+        if (state == 0) return 0;
+        state = s.fail;
+      }
+    }
+  };
+
+  struct Request {
+    QByteArray url;       // lowercased, encoded
+    QByteArray host;      // lowercased
+    int hostBegin = 0;    // host offsets within url
+    int hostEnd = 0;
+    quint32 type = 0;     // TypeBit, 0 when the type has no option
+    bool thirdParty = false;
+  };
+
+  bool applies(quint32 flags, const Request &r) {
+    const quint32 typeMask = (flags >> RuleTypeShift) & 0xff;
+    if (typeMask && !(typeMask & r.type)) return false;
+    if ((flags & RuleThirdParty) && !r.thirdParty) return false;
+    if ((flags & RuleFirstParty) && r.thirdParty) return false;
+    return true;
+  }
+
+  bool isSeparator(char c) {
+    return !((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.' || c == '%');
+  }
+
+  // Adblock wildcard match of p against the start of s: '*' is any run,
+  // '^' is a separator character or the end of the URL.
+  bool matchHere(const char *p, const char *pe, const char *s, const char *se, bool anchorEnd) {
+    while (p < pe) {
+      if (*p == '*') {
+        ++p;
+        if (p == pe) return true;
+        for (const char *t = s; t <= se; ++t) {
+          if (matchHere(p, pe, t, se, anchorEnd)) return true;
+        }
+        return false;
+      }
+      if (*p == '^') {
+        if (s == se) {
+          ++p;
+          continue;
+        }
+        if (!isSeparator(*s)) return false;
+      } else if (s == se || *p != *s) {
+        return false;
+      }
+      ++p;
+      ++s;
+    }
+    return !anchorEnd || s == se;
+  }
+
+  bool verify(const char *pattern, quint32 length, const Request &r) {
+    const char *p = pattern;
+    const char *pe = pattern + length;
+    const bool anchorEnd = pe > p && pe[-1] == '|';
+    if (anchorEnd) --pe;
+    const char *s = r.url.constData();
+    const char *se = s + r.url.size();
+    if (pe - p >= 2 && p[0] == '|' && p[1] == '|') {
+      // host anchor: the host itself or any of its parent domains
+      p += 2;
+      for (int i = r.hostBegin; i < r.hostEnd; ++i) {
+        if ((i == r.hostBegin || s[i - 1] == '.') && matchHere(p, pe, s + i, se, anchorEnd)) return true;
+      }
+      return false;
+    }
+    if (p < pe && *p == '|') return matchHere(p + 1, pe, s, se, anchorEnd);
+    for (const char *t = s; t < se; ++t) {
+      if (matchHere(p, pe, t, se, anchorEnd)) return true;
+    }
+    return false;
+  }
+
+  // Returns true to block: some blocking rule matches and no exception does.
+  bool evaluate(const FilterView &view, const Request &r) {
+    bool block = false;
+    bool allow = false;
+    auto note = [&](quint32 flags) {
+      if (!applies(flags, r)) return;
+      if (flags & RuleException) allow = true;
+      else block = true;
+    };
+
+    // host rules: the host and each parent domain
+    const char *host = r.host.constData();
+    const qsizetype hostSize = r.host.size();
+    const DomainEntry *dBegin = view.domains;
+    const DomainEntry *dEnd = view.domains + view.header->domainCount;
+    for (qsizetype i = 0; i < hostSize && !allow; ++i) {
+      if (i > 0 && host[i - 1] != '.') continue;
+      const quint64 hash = fnv1a(host + i, hostSize - i);
+      auto range = std::equal_range(dBegin, dEnd, DomainEntry{hash, 0, 0},
+                                    [](const DomainEntry &a, const DomainEntry &b) { return a.hash < b.hash; });
+      for (const DomainEntry *d = range.first; d != range.second; ++d) note(d->flags);
+    }
+    if (allow) return false;
+
+    // pattern rules: one automaton pass over the URL, then full verification
+    quint32 state = 0;
+    for (const char c : r.url) {
+      state = view.step(state, uchar(c));
+      for (quint32 s = state; s != 0; s = view.states[s].dictLink) {
+        const AcState &st = view.states[s];
+        for (quint32 o = 0; o < st.outputCount; ++o) {
+          const PatternRule &rule = view.patterns[view.outputs[st.firstOutput + o]];
+          const bool exception = rule.flags & RuleException;
+          if ((exception && allow) || (!exception && block)) continue;
+          if (!applies(rule.flags, r) || !verify(view.pool + rule.offset, rule.length, r)) continue;
+          if (exception) return false;
+          block = true;
+        }
+      }
+    }
+    return block && !allow;
+  }
+
+  // Parses "$opt1,opt2" into flags; false for options we cannot honor.
+  bool parseOptions(const QByteArray &options, quint32 *flags) {
+    quint32 types = 0;
+    for (const QByteArray &raw : options.split(',')) {
+      const QByteArray opt = raw.trimmed();
+      if (opt == "third-party" || opt == "3p") *flags |= RuleThirdParty;
+      else if (opt == "~third-party" || opt == "1p" || opt == "first-party") *flags |= RuleFirstParty;
+      else if (opt == "script") types |= TypeScript;
+      else if (opt == "image") types |= TypeImage;
+      else if (opt == "stylesheet" || opt == "css") types |= TypeStylesheet;
+      else if (opt == "xmlhttprequest" || opt == "xhr") types |= TypeXhr;
+      else if (opt == "subdocument" || opt == "frame") types |= TypeSubdocument;
+      else if (opt == "font") types |= TypeFont;
+      else if (opt == "media") types |= TypeMedia;
+      else if (opt == "important" || opt.isEmpty()) continue;
+      else return false;
+    }
+    *flags |= types << RuleTypeShift;
+    return true;
+  }
+
+  bool isHostName(const QByteArray &s) {
+    if (s.isEmpty()) return false;
+    for (const char c : s) {
+      if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '_')) return false;
+    }
+    return true;
+  }
+
+  // Longest run without wildcards or anchors; the automaton key of a rule.
+  QByteArray longestLiteral(const QByteArray &pattern) {
+    QByteArray best;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= pattern.size(); ++i) {
+      if (i == pattern.size() || pattern[i] == '*' || pattern[i] == '^' || pattern[i] == '|') {
+        if (i - start > best.size()) best = pattern.mid(start, i - start);
+        start = i + 1;
+      }
+    }
+    return best;
+  }
+
+  struct TrieNode {
+    std::map<uchar, quint32> next;
+    std::vector<quint32> outputs;
+    quint32 fail = 0;
+    quint32 dictLink = 0;
+  };
+
+  QByteArray compileFilterLists(const QStringList &paths, quint64 fingerprint) {
+    std::vector<DomainEntry> domains;
+    std::vector<PatternRule> patterns;
+    QByteArray pool;
+    std::vector<TrieNode> trie(1);
+    int skipped = 0;
+
+    auto addPattern = [&](const QByteArray &pattern, quint32 flags) {
+      const QByteArray key = longestLiteral(pattern);
+      if (key.size() < MIN_KEY_LENGTH || pattern.count('*') > MAX_WILDCARDS) {
+        ++skipped;
+        return;
+      }
+      const quint32 index = quint32(patterns.size());
+      patterns.push_back(PatternRule{quint32(pool.size()), quint32(pattern.size()), flags, 0});
+      pool.append(pattern);
+      quint32 node = 0;
+      for (const char c : key) {
+        auto it = trie[node].next.find(uchar(c));
+        if (it == trie[node].next.end()) {
+          trie.emplace_back();
+          it = trie[node].next.emplace(uchar(c), quint32(trie.size() - 1)).first;
+        }
+        node = it->second;
+      }
+      trie[node].outputs.push_back(index);
+    };
+
+    for (const QString &path : paths) {
+      QFile file(path);
+      if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "ContentBlocker: cannot read filter list" << path << file.errorString();
+        continue;
+      }
+      while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed().toLower();
+        if (line.isEmpty() || line.startsWith('!') || line.startsWith('[') || line.startsWith('#')) continue;
+        if (line.contains("##") || line.contains("#@#") || line.contains("#?#") || line.contains("#$#")) continue;
+
+        // hosts file: "0.0.0.0 ads.example.com  # comment"
+        if (line.startsWith("0.0.0.0 ") || line.startsWith("127.0.0.1 ") || line.startsWith("::1 ")) {
+          const QList<QByteArray> parts = line.split('#').first().simplified().split(' ');
+          if (parts.size() >= 2 && isHostName(parts[1]) && parts[1] != "localhost" && parts[1] != "0.0.0.0") {
+            domains.push_back(DomainEntry{fnv1a(parts[1].constData(), parts[1].size()), 0, 0});
+          }
+          continue;
+        }
+
+        quint32 flags = 0;
+        if (line.startsWith("@@")) {
+          flags |= RuleException;
+          line.remove(0, 2);
+        }
+        if (line.size() > 1 && line.startsWith('/') && line.endsWith('/')) {
+          ++skipped; // regex rules
+          continue;
+        }
+        const qsizetype dollar = line.lastIndexOf('$');
+        if (dollar >= 0) {
+          if (!parseOptions(line.mid(dollar + 1), &flags)) {
+            ++skipped;
+            continue;
+          }
+          line.truncate(dollar);
+        }
+        if (line.isEmpty()) continue;
+
+        // "||host^" (or "||host" / "||host^|") is a pure host rule
+        if (line.startsWith("||")) {
+          QByteArray host = line.mid(2);
+          if (host.endsWith('|')) host.chop(1);
+          if (host.endsWith('^')) host.chop(1);
+          if (isHostName(host)) {
+            domains.push_back(DomainEntry{fnv1a(host.constData(), host.size()), flags, 0});
+            continue;
+          }
+        }
+        addPattern(line, flags);
+      }
+    }
+
+    std::sort(domains.begin(), domains.end(), [](const DomainEntry &a, const DomainEntry &b) { return a.hash < b.hash; });
+
+    // failure and dictionary links, breadth first
+    std::queue<quint32> queue;
+    for (const auto &edge : trie[0].next) queue.push(edge.second);
+    while (!queue.empty()) {
+      const quint32 node = queue.front();
+      queue.pop();
+      for (const auto &edge : trie[node].next) {
+        quint32 f = trie[node].fail;
+        while (f != 0 && !trie[f].next.count(edge.first)) f = trie[f].fail;
+        auto it = trie[f].next.find(edge.first);
+        const quint32 fail = (it != trie[f].next.end() && it->second != edge.second) ? it->second : 0;
+        trie[edge.second].fail = fail;
+        trie[edge.second].dictLink = trie[fail].outputs.empty() ? trie[fail].dictLink : fail;
+        queue.push(edge.second);
+      }
+    }
+
+    std::vector<AcState> states;
+    std::vector<AcEdge> edges;
+    std::vector<quint32> outputs;
+    states.reserve(trie.size());
+    for (const TrieNode &node : trie) {
+      AcState s{quint32(edges.size()), quint32(node.next.size()), node.fail, node.dictLink,
+                quint32(outputs.size()), quint32(node.outputs.size())};
+      for (const auto &edge : node.next) edges.push_back(AcEdge{edge.first, edge.second});
+      outputs.insert(outputs.end(), node.outputs.begin(), node.outputs.end());
+      states.push_back(s);
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.ruleCount = quint32(domains.size() + patterns.size());
+    header.fingerprint = fingerprint;
+    header.domainCount = quint32(domains.size());
+    header.stateCount = quint32(states.size());
+    header.edgeCount = quint32(edges.size());
+    header.outputCount = quint32(outputs.size());
+    header.patternCount = quint32(patterns.size());
+    header.poolSize = quint32(pool.size());
+
+    QByteArray blob;
+    auto append = [&blob](const void *data, size_t size) { blob.append(static_cast<const char *>(data), qsizetype(size)); };
+    append(&header, sizeof(header));
+    append(domains.data(), domains.size() * sizeof(DomainEntry));
+    append(states.data(), states.size() * sizeof(AcState));
+    append(edges.data(), edges.size() * sizeof(AcEdge));
+    append(outputs.data(), outputs.size() * sizeof(quint32));
+    append(patterns.data(), patterns.size() * sizeof(PatternRule));
+    blob.append(pool);
+    qDebug() << "ContentBlocker: compiled" << domains.size() << "host rule(s)," << patterns.size()
+             << "pattern rule(s)," << states.size() << "automaton state(s); skipped" << skipped;
+    return blob;
+  }
+
+  quint32 typeBitFor(QWebEngineUrlRequestInfo::ResourceType type) {
+    switch (type) {
+      case QWebEngineUrlRequestInfo::ResourceTypeScript:
+      case QWebEngineUrlRequestInfo::ResourceTypeWorker:
+      case QWebEngineUrlRequestInfo::ResourceTypeSharedWorker:
+        return TypeScript;
+      case QWebEngineUrlRequestInfo::ResourceTypeImage:
+      case QWebEngineUrlRequestInfo::ResourceTypeFavicon:
+        return TypeImage;
+      case QWebEngineUrlRequestInfo::ResourceTypeStylesheet: return TypeStylesheet;
+      case QWebEngineUrlRequestInfo::ResourceTypeXhr: return TypeXhr;
+      case QWebEngineUrlRequestInfo::ResourceTypeSubFrame: return TypeSubdocument;
+      case QWebEngineUrlRequestInfo::ResourceTypeFontResource: return TypeFont;
+      case QWebEngineUrlRequestInfo::ResourceTypeMedia: return TypeMedia;
+      default: return 0;
+    }
+  }
+
+  // Approximate registrable domain: last two labels, or three for
+  // "example.co.uk"-style hosts. Good enough to tell third parties apart.
+  QByteArray siteOf(const QByteArray &host) {
+    const QList<QByteArray> labels = host.split('.');
+    if (labels.size() <= 2) return host;
+    const int keep = (labels.last().size() == 2 && labels[labels.size() - 2].size() <= 3) ? 3 : 2;
+    return labels.mid(labels.size() - keep).join('.');
+  }
+}
+
+ContentBlockInterceptor::ContentBlockInterceptor(QWebEngineProfile *profile)
+    : QWebEngineUrlRequestInterceptor(profile), profile_(profile) {}
+
+void ContentBlockInterceptor::interceptRequest(QWebEngineUrlRequestInfo &info) {
+  if (ContentBlocker::instance().filter(profile_, info)) info.block(true);
+}
+
+ContentBlocker &ContentBlocker::instance() {
+  static ContentBlocker *inst = new ContentBlocker(qApp);
+  return *inst;
+}
+
+ContentBlocker::ContentBlocker(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  enabled_ = s->value("contentBlocker/enabled", true).toBool();
+  worker_.setMaxThreadCount(1);
+  qDebug() << "ContentBlocker: enabled=" << enabled_ << "lists=" << listsDirectory();
+  if (!enabled_) return;
+  // users drop filter lists here
+  QDir().mkpath(listsDirectory());
+  reload();
+}
+
+QString ContentBlocker::listsDirectory() {
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/content-filters");
+}
+
+QString ContentBlocker::cachePath() {
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/content-filters.bin");
+}
+
+QStringList ContentBlocker::listFiles() const {
+  QStringList files;
+  const QFileInfoList found = QDir(listsDirectory()).entryInfoList({QStringLiteral("*.txt")}, QDir::Files, QDir::Name);
+  for (const QFileInfo &info : found) files << info.absoluteFilePath();
+  AppSettings s;
+  for (const QString &extra : s->value("contentBlocker/lists").toStringList()) {
+    if (!extra.trimmed().isEmpty()) files << QFileInfo(extra.trimmed()).absoluteFilePath();
+  }
+  files.removeDuplicates();
+  return files;
+}
+
+void ContentBlocker::attach(QWebEngineProfile *profile) {
+  if (!enabled_ || !profile) return;
+  profile->setUrlRequestInterceptor(new ContentBlockInterceptor(profile));
+}
+
+void ContentBlocker::reload() {
+  if (!enabled_) return;
+  const QStringList lists = listFiles();
+  // Paths, sizes and mtimes identify a compile; any change rebuilds.
+  quint64 fingerprint = fnv1a(reinterpret_cast<const char *>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+  for (const QString &path : lists) {
+    const QFileInfo info(path);
+    const QByteArray id = path.toUtf8() + '\0' + QByteArray::number(info.size()) + '\0'
+                          + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    fingerprint = fnv1a(id.constData(), id.size(), fingerprint);
+  }
+  if (data_ && fingerprint == fingerprint_) return;
+  if (lists.isEmpty()) {
+    release();
+    fingerprint_ = fingerprint;
+    return;
+  }
+  if (!data_ && mapCache(fingerprint)) return;
+
+  const int generation = ++generation_;
+  worker_.start([this, lists, fingerprint, generation]() {
+    PHRAIMS_TRACE_SCOPE("ContentBlocker: compile filter lists");
+    QElapsedTimer timer;
+    timer.start();
+    const QByteArray blob = compileFilterLists(lists, fingerprint);
+    const qint64 ms = timer.elapsed();
+    QMetaObject::invokeMethod(this, [this, blob, fingerprint, generation, ms]() {
+      adopt(blob, fingerprint, generation, ms);
+    }, Qt::QueuedConnection);
+  });
+}
+
+bool ContentBlocker::mapCache(quint64 fingerprint) {
+  cacheFile_.setFileName(cachePath());
+  if (!cacheFile_.open(QIODevice::ReadOnly)) return false;
+  const qint64 size = cacheFile_.size();
+  uchar *mapped = size > 0 ? cacheFile_.map(0, size) : nullptr;
+  FilterView view;
+  if (!mapped || !view.attach(mapped, size, fingerprint)) {
+    if (mapped) cacheFile_.unmap(mapped);
+    cacheFile_.close();
+    qDebug() << "ContentBlocker: cache is stale or unreadable; recompiling";
+    return false;
+  }
+  mapped_ = mapped;
+  data_ = mapped;
+  size_ = size;
+  fingerprint_ = fingerprint;
+  qDebug() << "ContentBlocker: mapped" << view.header->ruleCount << "rule(s) from" << cachePath();
+  emit rulesChanged();
+  return true;
+}
+
+void ContentBlocker::adopt(const QByteArray &blob, quint64 fingerprint, int generation, qint64 compileMs) {
+  if (generation != generation_) return;
+  FilterView view;
+  if (!view.attach(reinterpret_cast<const uchar *>(blob.constData()), blob.size(), fingerprint)) {
+    qWarning() << "ContentBlocker: compiled rules failed validation";
+    return;
+  }
+  // Unmap before the cache file is replaced (Windows cannot replace a mapped file).
+  release();
+  blob_ = blob;
+  data_ = reinterpret_cast<const uchar *>(blob_.constData());
+  size_ = blob_.size();
+  fingerprint_ = fingerprint;
+  qDebug() << "ContentBlocker: activated" << view.header->ruleCount << "rule(s) compiled in" << compileMs << "ms";
+  emit rulesChanged();
+
+  worker_.start([blob, path = cachePath()]() {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(blob) != blob.size() || !file.commit()) {
+      qWarning() << "ContentBlocker: cannot write cache" << path << file.errorString();
+    }
+  });
+}
+
+void ContentBlocker::release() {
+  data_ = nullptr;
+  size_ = 0;
+  blob_.clear();
+  if (mapped_) {
+    cacheFile_.unmap(mapped_);
+    mapped_ = nullptr;
+  }
+  if (cacheFile_.isOpen()) cacheFile_.close();
+}
+
+int ContentBlocker::ruleCount() const {
+  FilterView view;
+  return view.attach(data_, size_, fingerprint_) ? int(view.header->ruleCount) : 0;
+}
+
+QString ContentBlocker::siteKey(QWebEngineProfile *profile, const QUrl &url) {
+  return QString::number(quintptr(profile), 16) + QLatin1Char('/') + url.host();
+}
+
+bool ContentBlocker::filter(QWebEngineProfile *profile, const QWebEngineUrlRequestInfo &info) {
+  if (!data_) return false;
+  // never block what the user navigated to
+  if (info.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMainFrame) return false;
+  const QUrl url = info.requestUrl();
+  const QString scheme = url.scheme();
+  if (scheme != QLatin1String("http") && scheme != QLatin1String("https")
+      && scheme != QLatin1String("ws") && scheme != QLatin1String("wss")) {
+    return false;
+  }
+
+  FilterView view;
+  // data_ was validated when it was activated; this only sets up the pointers
+  if (!view.attach(data_, size_, fingerprint_)) return false;
+
+  Request request;
+  request.url = url.toEncoded().toLower();
+  request.host = url.host(QUrl::FullyEncoded).toLower().toUtf8();
+  // Locate the already parsed host inside the encoded URL: the authority
+  // may start with user info (`user@`) and IPv6 hosts are bracketed.
+  const int schemeEnd = request.url.indexOf("://");
+  const int authorityBegin = schemeEnd >= 0 ? schemeEnd + 3 : 0;
+  int authorityEnd = authorityBegin;
+  while (authorityEnd < request.url.size() && !strchr("/?#", request.url[authorityEnd])) ++authorityEnd;
+  const int at = authorityEnd > authorityBegin ? int(request.url.lastIndexOf('@', authorityEnd - 1)) : -1;
+  request.hostBegin = at >= authorityBegin ? at + 1 : authorityBegin;
+  if (request.hostBegin < authorityEnd && request.url[request.hostBegin] == '[') ++request.hostBegin;
+  request.hostEnd = request.hostBegin;
+  if (!request.host.isEmpty() && request.url.mid(request.hostBegin, request.host.size()) == request.host) {
+    request.hostEnd += int(request.host.size());
+  } else {
+    while (request.hostEnd < authorityEnd && !strchr(":]", request.url[request.hostEnd])) ++request.hostEnd;
+  }
+  request.type = typeBitFor(info.resourceType());
+  const QByteArray firstParty = info.firstPartyUrl().host(QUrl::FullyEncoded).toLower().toUtf8();
+  request.thirdParty = !firstParty.isEmpty() && siteOf(firstParty) != siteOf(request.host);
+
+  if (!evaluate(view, request)) return false;
+
+  if (blockedBySite_.size() >= MAX_COUNTED_SITES) blockedBySite_.clear();
+  ++blockedBySite_[siteKey(profile, info.firstPartyUrl())];
+  return true;
+}
+
+int ContentBlocker::blockedCount(QWebEngineProfile *profile, const QUrl &pageUrl) const {
+  return blockedBySite_.value(siteKey(profile, pageUrl));
+}
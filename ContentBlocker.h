@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QWebEngineUrlRequestInterceptor>
+
+class QUrl;
+class QWebEngineProfile;
+
+/**
+ * @brief Profile request interceptor that asks ContentBlocker about every subresource.
+ *
+ * One per profile, parented to it; installed by ContentBlocker::attach().
+ * Qt 6 calls interceptRequest() on the GUI thread.
+ */
+class ContentBlockInterceptor : public QWebEngineUrlRequestInterceptor {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Creates the interceptor for a profile.
+   * @param profile Profile whose requests are filtered (also the parent)
+   */
+  explicit ContentBlockInterceptor(QWebEngineProfile *profile);
+
+  /** @brief Blocks the request when ContentBlocker matches it. */
+  void interceptRequest(QWebEngineUrlRequestInfo &info) override;
+
+private:
+  QWebEngineProfile *profile_ = nullptr; ///< Profile the blocked counts are recorded against
+};
+
+/**
+ * @brief Precompiled filter-list matcher shared by every profile.
+ *
+ * Filter lists are the `*.txt` files in listsDirectory() plus any paths in
+ * `contentBlocker/lists`. Supported lines: Adblock-style network rules
+ * (`||host^`, `|prefix`, `suffix|`, `*` and `^` wildcards, `@@` exceptions,
+ * and the `third-party`, `~third-party` and resource type options) and hosts
+ * files (`0.0.0.0 host`). Cosmetic rules, regex rules and rules with other
+ * options are skipped.
+ *
+ * The lists are compiled off the GUI thread into one flat, position-
+ * independent blob:
+ * - pure host rules become a sorted array of 64-bit FNV-1a host hashes,
+ *   looked up for the request host and each of its parent domains;
+ * - every other rule contributes its longest literal run to an Aho-Corasick
+ *   automaton (array-encoded states, edges and outputs) that scans the URL
+ *   once, and candidate rules are then verified against their full pattern.
+ *
+ * The blob is written to cachePath() and memory-mapped at the next startup
+ * when its fingerprint (paths, sizes and modification times of the lists)
+ * still matches, so startup does not parse anything. Top-level navigations
+ * are never blocked.
+ *
+ * Blocked requests are counted per profile and top-level site
+ * (QWebEngineUrlRequestInfo::firstPartyUrl()); Qt does not say which page
+ * issued a request, so frames showing the same site share a count.
+ */
+class ContentBlocker : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared blocker, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static ContentBlocker &instance();
+
+  /** @brief Returns whether blocking is on (`contentBlocker/enabled`, read at startup). */
+  bool isEnabled() const { return enabled_; }
+
+  /**
+   * @brief Installs a ContentBlockInterceptor on a profile.
+   * @param profile Profile from getProfileByName() or createIncognitoProfile()
+   *
+   * A no-op when blocking is disabled.
+   */
+  void attach(QWebEngineProfile *profile);
+
+  /**
+   * @brief Rescans the filter lists and recompiles them in the background if they changed.
+   *
+   * The previous rules stay active until the new ones are ready.
+   */
+  void reload();
+
+  /**
+   * @brief Decides one request and records it when blocked.
+   * @param profile Profile the request belongs to
+   * @param info Request being intercepted
+   * @return true when the request should be blocked
+   */
+  bool filter(QWebEngineProfile *profile, const QWebEngineUrlRequestInfo &info);
+
+  /**
+   * @brief Returns how many requests were blocked for a page's site this session.
+   * @param profile Profile the page belongs to
+   * @param pageUrl Top-level URL of the page
+   * @return Blocked request count (0 when none)
+   */
+  int blockedCount(QWebEngineProfile *profile, const QUrl &pageUrl) const;
+
+  /** @brief Returns the number of compiled rules currently active. */
+  int ruleCount() const;
+
+  /** @brief Returns the directory scanned for `*.txt` filter lists. */
+  static QString listsDirectory();
+
+  /** @brief Returns the path of the compiled, memory-mapped matcher cache. */
+  static QString cachePath();
+
+signals:
+  /** @brief Emitted when a newly compiled (or mapped) rule set becomes active. */
+  void rulesChanged();
+
+private:
+  explicit ContentBlocker(QObject *parent = nullptr);
+
+  /** @brief Returns the filter list files to compile, in a stable order. */
+  QStringList listFiles() const;
+
+  /** @brief Maps cachePath() and activates it if it was compiled from @p fingerprint. */
+  bool mapCache(quint64 fingerprint);
+
+  /** @brief Activates a freshly compiled blob and writes it to the cache file. */
+  void adopt(const QByteArray &blob, quint64 fingerprint, int generation, qint64 compileMs);
+
+  /** @brief Drops the active rules and unmaps the cache file. */
+  void release();
+
+  /** @brief Returns the blocked-count key for a profile and page. */
+  static QString siteKey(QWebEngineProfile *profile, const QUrl &url);
+
+  bool enabled_ = true;                ///< contentBlocker/enabled
+  const uchar *data_ = nullptr;        ///< Active compiled rules (mapped file or blob_), null if none
+  qint64 size_ = 0;                    ///< Size of data_ in bytes
+  QFile cacheFile_;                    ///< Mapped cache file while data_ points into it
+  uchar *mapped_ = nullptr;            ///< QFile::map() result, unmapped in release()
+  QByteArray blob_;                    ///< Freshly compiled rules (until the next startup maps them)
+  quint64 fingerprint_ = 0;            ///< Fingerprint of the lists data_ was compiled from
+  int generation_ = 0;                 ///< Drops results of superseded compiles
+  QThreadPool worker_;                 ///< Single thread: compiles lists and writes the cache
+  QHash<QString, int> blockedBySite_;  ///< siteKey() -> blocked requests this session
+};
@@ -0,0 +1,159 @@
+#include "DevToolsHost.h"
+#include "AppSettings.h"
+#include "MyWebEnginePage.h"
+#include <QAction>
+#include <QApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QKeySequence>
+#include <QWebEngineProfile>
+#include <QWebEngineView>
+#include <algorithm>
+
+namespace {
+  constexpr int DEFAULT_IDLE_TEARDOWN_SECS = 120;
+  constexpr int MAX_IDLE_TEARDOWN_SECS = 24 * 60 * 60;
+  constexpr int DEVTOOLS_WIDTH = 980;
+  constexpr int DEVTOOLS_HEIGHT = 720;
+}
+
+DevToolsHost &DevToolsHost::instance() {
+  static DevToolsHost *inst = new DevToolsHost(qApp);
+  return *inst;
+}
+
+DevToolsHost::DevToolsHost(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  const int idleSecs = std::clamp(s->value("devTools/idleTeardownSeconds", DEFAULT_IDLE_TEARDOWN_SECS).toInt(), 0,
+                                  MAX_IDLE_TEARDOWN_SECS);
+  timer_.setSingleShot(true);
+  timer_.setInterval(idleSecs * 1000);
+  connect(&timer_, &QTimer::timeout, this, [this]() {
+    qDebug() << "DevToolsHost: idle for" << timer_.interval() / 1000 << "s; releasing the DevTools renderer";
+    tearDown();
+  });
+  // Pages must go before their profiles, which qApp deletes at shutdown
+  connect(qApp, &QCoreApplication::aboutToQuit, this, &DevToolsHost::tearDown);
+}
+
+DevToolsHost::~DevToolsHost() {
+  // view_ is a top-level window, not a child of this object
+  tearDown();
+}
+
+bool DevToolsHost::isVisible() const {
+  return view_ && view_->isVisible();
+}
+
+void DevToolsHost::ensureView(QWebEngineProfile *profile) {
+  if (devPage_ && devPage_->profile() != profile) {
+    // DevTools state lives in the profile; never inspect across profiles
+    devPage_->setInspectedPage(nullptr);
+    delete devPage_;
+    devPage_ = nullptr;
+  }
+  if (!view_) {
+    // Top-level tool window: it must not die with whichever SplitWindow asked first
+    view_ = new QWebEngineView();
+    view_->setWindowFlag(Qt::Tool, true);
+    view_->resize(DEVTOOLS_WIDTH, DEVTOOLS_HEIGHT);
+    view_->setWindowTitle(tr("DevTools"));
+    view_->installEventFilter(this);
+
+    // Cmd/Ctrl+W hides the window; hiding keeps the DevTools page and its
+    // preferences (e.g., theme choice) until the idle teardown.
+    QAction *closeAct = new QAction(view_);
+    closeAct->setShortcut(QKeySequence::Close);
+    connect(closeAct, &QAction::triggered, view_, &QWidget::hide);
+    view_->addAction(closeAct);
+  }
+  if (!devPage_) {
+    devPage_ = new MyWebEnginePage(profile, view_);
+    view_->setPage(devPage_);
+  }
+}
+
+void DevToolsHost::show(QWebEnginePage *page) {
+  if (!page) return;
+  ensureView(page->profile());
+  if (devPage_->inspectedPage() != page) {
+    if (inspected_) disconnect(inspected_, &QObject::destroyed, this, nullptr);
+    devPage_->setInspectedPage(page);
+    inspected_ = page;
+    connect(page, &QObject::destroyed, this, &DevToolsHost::onInspectedPageDestroyed);
+  }
+  view_->show();
+  view_->raise();
+  view_->activateWindow();
+  updateIdleTimer();
+}
+
+void DevToolsHost::toggle(QWebEnginePage *page) {
+  // only a request for the page already inspected hides; others re-point the window
+  if (isVisible() && (!page || page == inspected_)) {
+    view_->hide();
+    return;
+  }
+  show(page);
+}
+
+void DevToolsHost::onInspectedPageDestroyed() {
+  if (!view_) return;
+  if (devPage_ && devPage_->profile()->isOffTheRecord()) {
+    // an Incognito page usually goes with its window and profile; drop its DevTools now
+    qDebug() << "DevToolsHost: inspected off-the-record page closed; releasing the DevTools renderer";
+    tearDown();
+    return;
+  }
+  // nothing left to inspect; don't leave an empty tool window on screen
+  view_->hide();
+  updateIdleTimer();
+}
+
+bool DevToolsHost::eventFilter(QObject *watched, QEvent *event) {
+  if (watched == view_) {
+    switch (event->type()) {
+    case QEvent::Close:
+      // the window's close button hides, like Cmd/Ctrl+W
+      event->ignore();
+      view_->hide();
+      return true;
+    case QEvent::Show:
+    case QEvent::Hide:
+      QTimer::singleShot(0, this, [this]() { updateIdleTimer(); });
+      break;
+    default:
+      break;
+    }
+  }
+  return QObject::eventFilter(watched, event);
+}
+
+void DevToolsHost::updateIdleTimer() {
+  if (!view_) {
+    timer_.stop();
+    return;
+  }
+  if (view_->isVisible() && inspected_) {
+    timer_.stop();
+  } else if (!timer_.isActive()) {
+    timer_.start();
+  }
+}
+
+void DevToolsHost::tearDown() {
+  timer_.stop();
+  if (inspected_) {
+    disconnect(inspected_, &QObject::destroyed, this, nullptr);
+    // only detach if the page still points at our DevTools page
+    if (inspected_->devToolsPage() == devPage_) inspected_->setDevToolsPage(nullptr);
+  }
+  inspected_.clear();
+  if (!view_) return;
+  view_->removeEventFilter(this);
+  // devPage_ is a child of view_; delete it first so no page outlives its view
+  delete devPage_;
+  devPage_ = nullptr;
+  delete view_;
+  view_ = nullptr;
+}
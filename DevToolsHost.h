@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+class QWebEngineProfile;
+class QWebEnginePage;
+class QWebEngineView;
+
+/**
+ * @brief The application's only DevTools window, shared by every frame in every window.
+ *
+ * Each DevTools instance is a full web page with its own renderer, so
+ * instead of one per SplitWindow there is a single view, created on first
+ * use and re-pointed (QWebEnginePage::setInspectedPage()) at whichever page
+ * asks. Inspecting a page of another profile replaces the DevTools page
+ * with one of that profile, so Incognito pages are inspected from their own
+ * off-the-record profile.
+ *
+ * The window hides when the inspected page is destroyed (its frame or
+ * window closed); for an off-the-record page it is torn down right away.
+ * Closing the window (or Cmd/Ctrl+W) only hides it, keeping DevTools
+ * preferences for the next show. After `devTools/idleTeardownSeconds`
+ * hidden, or without an inspected page, the view is destroyed to free its
+ * renderer and is created again on the next request.
+ */
+class DevToolsHost : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared host, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static DevToolsHost &instance();
+
+  ~DevToolsHost() override;
+
+  /**
+   * @brief Inspects a page and shows, raises and activates the DevTools window.
+   * @param page Page to inspect
+   */
+  void show(QWebEnginePage *page);
+
+  /**
+   * @brief Hides the DevTools window if it is visible and inspecting @p page, otherwise shows it for @p page.
+   * @param page Page to inspect when showing (nullptr only hides)
+   */
+  void toggle(QWebEnginePage *page);
+
+  /** @brief Returns whether the DevTools window is currently visible. */
+  bool isVisible() const;
+
+  /** @brief Returns the page being inspected, or nullptr. */
+  QWebEnginePage *inspectedPage() const { return inspected_; }
+
+protected:
+  /** @brief Turns closing the view into hiding it and tracks its visibility. */
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+  explicit DevToolsHost(QObject *parent = nullptr);
+
+  /**
+   * @brief Creates the view, and a DevTools page for @p profile, as needed.
+   * @param profile Profile of the page about to be inspected
+   */
+  void ensureView(QWebEngineProfile *profile);
+
+  /** @brief Hides the window (or tears it down for an off-the-record page) once the inspected page is gone. */
+  void onInspectedPageDestroyed();
+
+  /** @brief Starts timer_ when the window is hidden or has nothing to inspect. */
+  void updateIdleTimer();
+
+  /** @brief Detaches the inspected page and destroys the view and its DevTools page. */
+  void tearDown();
+
+  QWebEngineView *view_ = nullptr;      ///< DevTools window, null until needed
+  QWebEnginePage *devPage_ = nullptr;   ///< DevTools page shown in view_ (child of view_)
+  QPointer<QWebEnginePage> inspected_;  ///< Page devPage_ inspects
+  QTimer timer_;                        ///< Idle teardown countdown
+};
@@ -13,11 +13,19 @@
 #include <QLineEdit>
 #include <QListWidget>
 #include <QListWidgetItem>
+#include <QMap>
 #include <QPushButton>
 #include <QStandardPaths>
+#include <QStringList>
 #include <QUuid>
 #include <QVBoxLayout>
 #include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWebEngineScript>
+#include <QWebEngineScriptCollection>
+#include <memory>
+#include <utility>
+#include <vector>
 
 bool DEBUG_DOM_PATCH_VERBOSE = 0;
 
@@ -38,49 +46,393 @@ QString escapeForJs(const QString &s) {
   return out;
 }
 
-QList<DomPatch> loadDomPatches() {
-  // Cache patches in-memory to avoid reading the JSON file on every
+namespace {
+  // Name of the compiled script installed in each profile's script collection.
+  const QString kDomPatchScriptName = QStringLiteral("phraims-dom-patches");
+  // Dynamic property recording which compiled generation a profile/page carries.
+  constexpr const char *kDomPatchGenerationProperty = "phraimsDomPatchGeneration";
+  // Observe-mode passes run at most this often, each inside requestAnimationFrame.
+  constexpr int OBSERVE_MIN_INTERVAL_MS = 100;
+
+  // Patches are cached in-memory to avoid reading the JSON file on every
   // applyDomPatchesToPage call. The file is re-read only when its
-  // modification time changes.
-  static QList<DomPatch> cache;
-  static QDateTime cacheMtime;
+  // modification time changes; every re-read bumps the generation.
+  QList<DomPatch> g_patchCache;
+  QDateTime g_patchCacheMtime;
+  quint64 g_patchGeneration = 1;
+
+  /**
+   * @brief Radix-trie node over URL prefixes.
+   *
+   * Each prefix bucket is attached to the node where its prefix ends. Edge
+   * labels of sibling edges never share a first character, so a lookup
+   * follows at most one edge per node.
+   */
+  struct PrefixTrieNode {
+    QList<int> buckets;                                          ///< Buckets whose prefix ends here
+    std::vector<std::pair<QString, std::unique_ptr<PrefixTrieNode>>> edges; ///< Labelled children
+  };
+
+  void insertPrefix(PrefixTrieNode *node, QString prefix, int bucket) {
+    while (!prefix.isEmpty()) {
+      PrefixTrieNode *next = nullptr;
+      for (auto &edge : node->edges) {
+        const QString &label = edge.first;
+        int common = 0;
+        while (common < label.size() && common < prefix.size() && label[common] == prefix[common]) ++common;
+        if (common == 0) continue;
+        if (common < label.size()) {
+          // split the edge so the shared part becomes its own node
+          auto mid = std::make_unique<PrefixTrieNode>();
+          mid->edges.emplace_back(label.mid(common), std::move(edge.second));
+          edge.first = label.left(common);
+          edge.second = std::move(mid);
+        }
+        next = edge.second.get();
+        prefix = prefix.mid(common);
+        break;
+      }
+      if (!next) {
+        auto leaf = std::make_unique<PrefixTrieNode>();
+        leaf->buckets.push_back(bucket);
+        node->edges.emplace_back(prefix, std::move(leaf));
+        return;
+      }
+      node = next;
+    }
+    node->buckets.push_back(bucket);
+  }
+
+  /** @brief Serializes a trie node as {"b":[buckets],"e":[[label,node],...]}. */
+  QJsonObject trieToJson(const PrefixTrieNode &node, int *nodeCount) {
+    ++*nodeCount;
+    QJsonArray buckets;
+    for (int b : node.buckets) buckets.append(b);
+    QJsonArray edges;
+    for (const auto &edge : node.edges) {
+      edges.append(QJsonArray{edge.first, trieToJson(*edge.second, nodeCount)});
+    }
+    return QJsonObject{{"b", buckets}, {"e", edges}};
+  }
+
+  /**
+   * @brief Splits a declaration block at its top-level semicolons.
+   *
+   * Semicolons inside quoted strings or parentheses belong to the value
+   * (`url("data:image/png;base64,...")`, `content: "a;b"`).
+   */
+  QStringList splitDeclarations(const QString &css) {
+    QStringList parts;
+    QString current;
+    QChar quote;
+    int depth = 0;
+    for (int i = 0; i < css.size(); ++i) {
+      const QChar c = css.at(i);
+      if (!quote.isNull()) {
+        current += c;
+        if (c == QLatin1Char('\\') && i + 1 < css.size()) current += css.at(++i);
+        else if (c == quote) quote = QChar();
+        continue;
+      }
+      if (c == QLatin1Char('"') || c == QLatin1Char('\'')) quote = c;
+      else if (c == QLatin1Char('(')) ++depth;
+      else if (c == QLatin1Char(')') && depth > 0) --depth;
+      else if (c == QLatin1Char(';') && depth == 0) {
+        parts << current;
+        current.clear();
+        continue;
+      }
+      current += c;
+    }
+    parts << current;
+    return parts;
+  }
+
+  /** @brief Appends !important to each declaration so patches beat page styles. */
+  QString importantDeclarations(const QString &css) {
+    QStringList out;
+    for (const QString &part : splitDeclarations(css)) {
+      const QString decl = part.trimmed();
+      if (decl.isEmpty()) continue;
+      if (decl.endsWith(QStringLiteral("!important"), Qt::CaseInsensitive)) out << decl;
+      else out << decl + QStringLiteral(" !important");
+    }
+    return out.join(QStringLiteral("; "));
+  }
+
+  /** @brief Splits declarations into [property, value] pairs for inline styles. */
+  QJsonArray inlineDeclarations(const QString &css) {
+    QJsonArray out;
+    for (const QString &part : splitDeclarations(css)) {
+      const int colon = part.indexOf(':');
+      if (colon <= 0) continue;
+      const QString prop = part.left(colon).trimmed();
+      QString value = part.mid(colon + 1).trimmed();
+      if (value.endsWith(QStringLiteral("!important"), Qt::CaseInsensitive)) {
+        value = value.left(value.size() - 10).trimmed();
+      }
+      if (prop.isEmpty() || value.isEmpty()) continue;
+      out.append(QJsonArray{prop, value});
+    }
+    return out;
+  }
+
+  /** @brief Stylesheet and observe-mode rules sharing one URL prefix. */
+  struct PrefixBucket {
+    QStringList rules;   ///< "selector { decls !important }" entries
+    QJsonArray observe;  ///< [selector, [[prop, value], ...]] entries for observe-mode patches
+  };
+
+  /** @brief Compiled runtime for the current patch generation. */
+  struct CompiledDomPatches {
+    quint64 generation = 0; ///< g_patchGeneration this was built from
+    QString source;         ///< Document-creation script (empty when no patch is enabled)
+  };
+
+  const CompiledDomPatches &compiledDomPatches() {
+    static CompiledDomPatches compiled;
+    const QList<DomPatch> patches = loadDomPatches();
+    if (compiled.generation == g_patchGeneration) return compiled;
+
+    // One bucket per distinct prefix; all of its rules share one stylesheet.
+    QMap<QString, PrefixBucket> rulesByPrefix;
+    int ruleCount = 0;
+    int observeCount = 0;
+    for (const DomPatch &p : patches) {
+      if (!p.enabled || p.selector.trimmed().isEmpty()) continue;
+      PrefixBucket &bucket = rulesByPrefix[p.urlPrefix];
+      bucket.rules << QStringLiteral("%1 { %2 }").arg(p.selector, importantDeclarations(p.css));
+      ++ruleCount;
+      if (p.observe) {
+        const QJsonArray decls = inlineDeclarations(p.css);
+        if (!decls.isEmpty()) {
+          bucket.observe.append(QJsonArray{p.selector, decls});
+          ++observeCount;
+        }
+      }
+    }
+
+    compiled.generation = g_patchGeneration;
+    compiled.source.clear();
+    if (rulesByPrefix.isEmpty()) {
+      qDebug() << "compileDomPatches: no enabled patches";
+      return compiled;
+    }
+
+    PrefixTrieNode root;
+    QJsonArray buckets;
+    for (auto it = rulesByPrefix.constBegin(); it != rulesByPrefix.constEnd(); ++it) {
+      insertPrefix(&root, it.key(), buckets.size());
+      buckets.append(QJsonObject{{"css", it.value().rules.join('\n')}, {"observe", it.value().observe}});
+    }
+    int nodeCount = 0;
+    const QJsonObject trie = trieToJson(root, &nodeCount);
+
+    compiled.source = QString(R"JS(
+(function(){
+  try {
+    var prev = window.__phraimsDomPatch;
+    if (prev && prev.dispose) prev.dispose();
+    var generation = %1;
+    var buckets = %2;
+    var trie = %3;
+    var styles = {};
+    var waiter = null;
+    var observed = [];     // [selector, decls] of observe-mode patches for the current URL
+    var observer = null;
+    var passQueued = false;
+    var lastPass = 0;
+
+    function matching(url) {
+      var hit = {};
+      var node = trie, pos = 0;
+      while (node) {
+        for (var i = 0; i < node.b.length; i++) hit[node.b[i]] = true;
+        var next = null;
+        for (var j = 0; j < node.e.length; j++) {
+          var label = node.e[j][0];
+          if (url.startsWith(label, pos)) { pos += label.length; next = node.e[j][1]; break; }
+        }
+        node = next;
+      }
+      return hit;
+    }
+
+    // The browser serializes inline values ("0" reads back as "0px", "#fff"
+    // as "rgb(255, 255, 255)"); compare against that form, or every pass
+    // would rewrite style and re-trigger the observer.
+    function normalized(decls) {
+      var scratch = document.createElement('div').style;
+      var out = [];
+      for (var i = 0; i < decls.length; i++) {
+        scratch.setProperty(decls[i][0], decls[i][1], 'important');
+        var value = scratch.getPropertyValue(decls[i][0]);
+        out.push([decls[i][0], value !== '' ? value : decls[i][1]]);
+      }
+      return out;
+    }
+
+    // Observe mode: one shared MutationObserver per document re-applies the
+    // inline styles of all active observe-mode patches in batched passes.
+    function applyInline() {
+      passQueued = false;
+      lastPass = Date.now();
+      for (var i = 0; i < observed.length; i++) {
+        var els;
+        try { els = document.querySelectorAll(observed[i][0]); } catch (e) { continue; }
+        var decls = observed[i][1];
+        for (var j = 0; j < els.length; j++) {
+          var st = els[j].style;
+          if (!st) continue;
+          for (var k = 0; k < decls.length; k++) {
+            // only write when different so matching elements are left untouched
+            if (st.getPropertyValue(decls[k][0]) !== decls[k][1] || st.getPropertyPriority(decls[k][0]) !== 'important') {
+              st.setProperty(decls[k][0], decls[k][1], 'important');
+            }
+          }
+        }
+      }
+      // drop the records of our own writes so they never schedule another pass
+      if (observer) observer.takeRecords();
+    }
 
+    function queuePass() {
+      if (passQueued) return;
+      passQueued = true;
+      var wait = Math.max(0, lastPass + %4 - Date.now());
+      setTimeout(function() { requestAnimationFrame(applyInline); }, wait);
+    }
+
+    function updateObserver(hit) {
+      observed = [];
+      for (var i = 0; i < buckets.length; i++) {
+        if (!hit[i]) continue;
+        var b = buckets[i];
+        if (!b.normalized) {
+          b.normalized = true;
+          for (var j = 0; j < b.observe.length; j++) b.observe[j][1] = normalized(b.observe[j][1]);
+        }
+        observed = observed.concat(b.observe);
+      }
+      if (!observed.length) {
+        if (observer) { observer.disconnect(); observer = null; }
+        return;
+      }
+      if (!observer) {
+        observer = new MutationObserver(queuePass);
+        observer.observe(document, { childList: true, subtree: true, attributes: true, attributeFilter: ['style', 'class'] });
+      }
+      queuePass();
+    }
+
+    function sync() {
+      var started = performance.now();
+      syncNow();
+      api.lastSyncMs = performance.now() - started;
+    }
+
+    function syncNow() {
+      var root = document.head || document.documentElement;
+      if (!root) {
+        // document-creation runs before the root element exists
+        if (!waiter) {
+          waiter = new MutationObserver(function() {
+            if (!document.documentElement) return;
+            waiter.disconnect();
+            waiter = null;
+            sync();
+          });
+          waiter.observe(document, { childList: true });
+        }
+        return;
+      }
+      var hit = matching(location.href);
+      updateObserver(hit);
+      for (var i = 0; i < buckets.length; i++) {
+        var s = styles[i];
+        if (!s) {
+          if (!hit[i]) continue;
+          s = document.createElement('style');
+          s.setAttribute('data-phraims-dom-patch', String(i));
+          s.textContent = buckets[i].css;
+          styles[i] = s;
+        }
+        if (!s.isConnected) root.appendChild(s);
+        s.media = hit[i] ? 'all' : 'not all';
+      }
+    }
+
+    function dispose() {
+      if (waiter) { waiter.disconnect(); waiter = null; }
+      if (observer) { observer.disconnect(); observer = null; }
+      observed = [];
+      for (var k in styles) { if (styles[k].isConnected) styles[k].remove(); }
+      styles = {};
+    }
+
+    // lastSyncMs is read by the performance HUD (FrameMetrics.cpp)
+    var api = { generation: generation, sync: sync, dispose: dispose, lastSyncMs: -1 };
+    window.__phraimsDomPatch = api;
+    window.addEventListener('popstate', sync);
+    window.addEventListener('hashchange', sync);
+    sync();
+  } catch (e) {
+    var msg = (e && e.name ? (e.name + ': ') : '') + (e && e.message ? e.message : String(e));
+    console.error('dom-patch-inject-error', msg);
+  }
+})();
+)JS")
+      .arg(QString::number(compiled.generation),
+           QString::fromUtf8(QJsonDocument(buckets).toJson(QJsonDocument::Compact)),
+           QString::fromUtf8(QJsonDocument(trie).toJson(QJsonDocument::Compact)),
+           QString::number(OBSERVE_MIN_INTERVAL_MS));
+
+    qDebug() << "compileDomPatches: compiled" << ruleCount << "rule(s) (" << observeCount << "observed) into" << buckets.size()
+             << "prefix bucket(s)," << nodeCount << "trie node(s), generation" << compiled.generation;
+    if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "compileDomPatches: js=" << compiled.source;
+    return compiled;
+  }
+}
+
+QList<DomPatch> loadDomPatches() {
   const QString path = domPatchesPath();
   QFileInfo fi(path);
   if (!fi.exists()) {
-    if (!cache.isEmpty()) {
-      cache.clear();
-      cacheMtime = QDateTime();
+    if (g_patchCacheMtime.isValid() || !g_patchCache.isEmpty()) {
+      g_patchCache.clear();
+      g_patchCacheMtime = QDateTime();
+      ++g_patchGeneration;
       if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "loadDomPatches: cleared cache (file removed):" << path;
     }
-    return cache;
+    return g_patchCache;
   }
 
   const QDateTime mtime = fi.lastModified();
-  if (!cache.isEmpty() && cacheMtime.isValid() && cacheMtime >= mtime) {
+  if (g_patchCacheMtime.isValid() && g_patchCacheMtime >= mtime) {
     // cached and up-to-date
-    return cache;
+    return g_patchCache;
   }
 
+  ++g_patchGeneration;
+  g_patchCache.clear();
+  // Remember the mtime even for unreadable files so they aren't re-read on
+  // every navigation; a later save changes the mtime and retries.
+  g_patchCacheMtime = mtime;
+
   QFile f(path);
   if (!f.open(QIODevice::ReadOnly)) {
     if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "loadDomPatches: cannot open" << path;
-    cache.clear();
-    cacheMtime = QDateTime();
-    return cache;
+    return g_patchCache;
   }
   const QByteArray b = f.readAll();
   f.close();
   const QJsonDocument d = QJsonDocument::fromJson(b);
   if (!d.isArray()) {
     if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "loadDomPatches: file exists but JSON is not an array:" << path;
-    cache.clear();
-    cacheMtime = QDateTime();
-    return cache;
+    return g_patchCache;
   }
 
   const QJsonArray arr = d.array();
-  cache.clear();
   for (const QJsonValue &v : arr) {
     if (!v.isObject()) continue;
     const QJsonObject o = v.toObject();
@@ -90,11 +442,11 @@ QList<DomPatch> loadDomPatches() {
     p.selector = o.value("selector").toString();
     p.css = o.value("css").toString();
     p.enabled = o.value("enabled").toBool(true);
-    cache.push_back(p);
+    p.observe = o.value("observe").toBool(false);
+    g_patchCache.push_back(p);
   }
-  cacheMtime = mtime;
-  if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "loadDomPatches: loaded" << cache.size() << "entries from" << path;
-  return cache;
+  if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "loadDomPatches: loaded" << g_patchCache.size() << "entries from" << path;
+  return g_patchCache;
 }
 
 bool saveDomPatches(const QList<DomPatch> &patches) {
@@ -106,6 +458,7 @@ bool saveDomPatches(const QList<DomPatch> &patches) {
     o["selector"] = p.selector;
     o["css"] = p.css;
     o["enabled"] = p.enabled;
+    o["observe"] = p.observe;
     arr.append(o);
   }
   QJsonDocument d(arr);
@@ -114,87 +467,65 @@ bool saveDomPatches(const QList<DomPatch> &patches) {
   if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
   f.write(d.toJson(QJsonDocument::Indented));
   f.close();
+  // Force a re-read even if the write landed within the old mtime's resolution.
+  g_patchCacheMtime = QDateTime();
   if (DEBUG_DOM_PATCH_VERBOSE) qDebug() << "saveDomPatches: wrote" << arr.size() << "entries to" << path;
   return true;
 }
 
-void applyDomPatchesToPage(QWebEnginePage *page) {
-  if (!page) return;
-  const QUrl url = page->url();
-  const QString urlStr = url.toString();
-  const QList<DomPatch> patches = loadDomPatches();
-  // Helper: produce a JSON-quoted JS string for safe embedding
-  auto jsonQuoted = [](const QString &s) {
-    QJsonArray a;
-    a.append(s);
-    QString j = QString::fromUtf8(QJsonDocument(a).toJson(QJsonDocument::Compact));
-    // j looks like ["..."] -- strip the surrounding [ and ]
-    if (j.size() >= 2 && j.front() == '[' && j.back() == ']') return j.mid(1, j.size() - 2);
-    return j; // fallback
-  };
+void installDomPatchScript(QWebEngineProfile *profile) {
+  if (!profile) return;
+  const CompiledDomPatches &compiled = compiledDomPatches();
+  if (profile->property(kDomPatchGenerationProperty).toULongLong() == compiled.generation) return;
+  profile->setProperty(kDomPatchGenerationProperty, compiled.generation);
 
-  for (const DomPatch &p : patches) {
-    if (!p.enabled) continue;
-    if (p.urlPrefix.isEmpty() || urlStr.startsWith(p.urlPrefix)) {
-      const QString idQ = jsonQuoted(p.id);
-      const QString selQ = jsonQuoted(p.selector);
-      const QString cssQ = jsonQuoted(p.css);
+  QWebEngineScriptCollection *scripts = profile->scripts();
+  for (const QWebEngineScript &old : scripts->find(kDomPatchScriptName)) scripts->remove(old);
+  if (compiled.source.isEmpty()) {
+    qDebug() << "installDomPatchScript: removed patch script from profile" << profile->storageName();
+    return;
+  }
 
-      const QString js = QString(R"JS(
-(function(){
-  try {
-    var id = %1;
-    var sel = %2;
-    var css = %3;
-
-    // remove any previous style with the same id
-    try {
-      var existing = document.querySelector('style[data-dom-patch-id="' + id + '"]');
-      if (existing) existing.remove();
-    } catch(e) {}
-
-    // insert/update a stylesheet in document head
-    try {
-      var s = document.createElement('style');
-      s.setAttribute('data-dom-patch-id', id);
-      s.textContent = sel + '{' + css + '}';
-      document.head.appendChild(s);
-    } catch(e) {}
-
-    // Try to set an inline style on the first matching element (if present)
-    try {
-      var el = document.querySelector(sel);
-      if (el) {
-        try {
-          var decl = css.replace(/;\s*$/,'');
-          var parts = decl.split(':');
-          if (parts.length >= 2) {
-            var prop = parts[0].trim();
-            var val = parts.slice(1).join(':').trim();
-            el.style.setProperty(prop, val, 'important');
-          } else {
-            el.style.cssText += (' ' + css + ' !important;');
-          }
-        } catch(e) {}
-      }
-    } catch(e) {}
+  QWebEngineScript script;
+  script.setName(kDomPatchScriptName);
+  script.setSourceCode(compiled.source);
+  script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+  script.setWorldId(QWebEngineScript::ApplicationWorld);
+  script.setRunsOnSubFrames(false);
+  scripts->insert(script);
+  qDebug() << "installDomPatchScript: installed generation" << compiled.generation
+           << "on profile" << profile->storageName();
+}
 
-  } catch (e) {
-    var msg = (e && e.name ? (e.name + ': ') : '') + (e && e.message ? e.message : String(e));
-    console.error('dom-patch-inject-error', msg);
-  }
-})();
+void prepareDomPatchesForPage(QWebEnginePage *page) {
+  if (!page) return;
+  installDomPatchScript(page->profile());
+  // Every document this page creates from now on runs the installed script.
+  page->setProperty(kDomPatchGenerationProperty, compiledDomPatches().generation);
+}
 
-)JS").arg(idQ, selQ, cssQ);
+void applyDomPatchesToPage(QWebEnginePage *page) {
+  if (!page) return;
+  installDomPatchScript(page->profile());
+  const CompiledDomPatches &compiled = compiledDomPatches();
 
-      // High-level log for every applied patch (always enabled).
-      qDebug() << "applyDomPatchesToPage: applying patch id=" << p.id << " url=" << urlStr << " selector=" << p.selector << " css=" << p.css;
-      // Detailed injected-JS payload logging gated behind NVK_DOM_PATCH_VERBOSE.
-      if (DEBUG_DOM_PATCH_VERBOSE) {
-        qDebug() << "applyDomPatchesToPage: js=" << js;
-      }
-      page->runJavaScript(js);
-    }
+  if (page->property(kDomPatchGenerationProperty).toULongLong() != compiled.generation) {
+    // The current document was created with an older script (or none):
+    // swap the runtime in place; it disposes the previous one itself.
+    page->setProperty(kDomPatchGenerationProperty, compiled.generation);
+    qDebug() << "applyDomPatchesToPage: updating page to generation" << compiled.generation << "url=" << page->url();
+    const QString js = compiled.source.isEmpty()
+      ? QStringLiteral("window.__phraimsDomPatch && window.__phraimsDomPatch.dispose();")
+      : compiled.source;
+    page->runJavaScript(js, QWebEngineScript::ApplicationWorld);
+    return;
+  }
+
+  // Same-document navigations (pushState/replaceState) happen in the page's
+  // main world where we can't hook history; re-evaluate the prefix match.
+  if (!compiled.source.isEmpty()) {
+    page->runJavaScript(QStringLiteral("window.__phraimsDomPatch && window.__phraimsDomPatch.sync();"),
+                        QWebEngineScript::ApplicationWorld);
   }
 }
 
@@ -230,7 +561,8 @@ void DomPatchesDialog::loadList() {
   for (const DomPatch &p : std::as_const(patches_)) {
     // show URL prefix, selector and the CSS declarations in the list
     const QString cssPreview = p.css.isEmpty() ? QStringLiteral("(no style)") : p.css;
-    const QString enabledSuffix = p.enabled ? QString() : QStringLiteral(" (disabled)");
+    QString enabledSuffix = p.enabled ? QString() : QStringLiteral(" (disabled)");
+    if (p.observe) enabledSuffix += QStringLiteral(" (observe)");
     QListWidgetItem *it = new QListWidgetItem(
       QStringLiteral("%1 | %2 | %3%4")
         .arg(p.urlPrefix, p.selector, cssPreview, enabledSuffix),
@@ -293,6 +625,9 @@ void DomPatchesDialog::editPatchDialog(const DomPatch &p_in, bool isNew) {
   auto *cssEdit = new QLineEdit(p.css, d);
   auto *enabledChk = new QCheckBox(tr("Enabled"), d);
   enabledChk->setChecked(p.enabled);
+  auto *observeChk = new QCheckBox(tr("Keep applying to elements added later (single-page apps)"), d);
+  observeChk->setChecked(p.observe);
+  observeChk->setToolTip(tr("Watches the page for changes and re-applies the declarations as inline styles"));
   lay->addWidget(urlLabel);
   lay->addWidget(urlEdit);
   lay->addWidget(selLabel);
@@ -300,6 +635,7 @@ void DomPatchesDialog::editPatchDialog(const DomPatch &p_in, bool isNew) {
   lay->addWidget(cssLabel);
   lay->addWidget(cssEdit);
   lay->addWidget(enabledChk);
+  lay->addWidget(observeChk);
   auto *btnRow = new QHBoxLayout();
   auto *ok = new QPushButton(tr("OK"), d);
   auto *cancel = new QPushButton(tr("Cancel"), d);
@@ -309,12 +645,13 @@ void DomPatchesDialog::editPatchDialog(const DomPatch &p_in, bool isNew) {
   lay->addLayout(btnRow);
 
   // OK: capture current widget values, persist, refresh list, then close
-  connect(ok, &QPushButton::clicked, this, [this, d, urlEdit, selEdit, cssEdit, enabledChk, p]() mutable {
+  connect(ok, &QPushButton::clicked, this, [this, d, urlEdit, selEdit, cssEdit, enabledChk, observeChk, p]() mutable {
     DomPatch newP = p; // start from original id
     newP.urlPrefix = urlEdit->text();
     newP.selector = selEdit->text();
     newP.css = cssEdit->text();
     newP.enabled = enabledChk->isChecked();
+    newP.observe = observeChk->isChecked();
     if (/*isNew*/ d->property("isNew").toBool()) {
       // append new patch
       patches_.push_back(newP);
@@ -6,6 +6,7 @@
 
 class QListWidget;
 class QWebEnginePage;
+class QWebEngineProfile;
 
 /** @brief Debug flag to enable verbose DOM patch logging */
 extern bool DEBUG_DOM_PATCH_VERBOSE;
@@ -22,6 +23,7 @@ struct DomPatch {
   QString selector;   ///< CSS selector for targeting elements
   QString css;        ///< CSS declarations (e.g., "display: none;")
   bool enabled = true; ///< Whether this patch is currently active
+  bool observe = false; ///< Also re-apply as inline styles to elements added later (SPA mode)
 };
 
 /**
@@ -58,12 +60,40 @@ QList<DomPatch> loadDomPatches();
 bool saveDomPatches(const QList<DomPatch> &patches);
 
 /**
- * @brief Applies all enabled DOM patches to the given page.
+ * @brief Installs the compiled DOM patch script into a profile's script collection.
+ * @param profile The profile whose pages should receive the patches
+ *
+ * All enabled patches are compiled once per loadDomPatches() cache refresh:
+ * patches sharing a URL prefix are merged into one stylesheet (declarations
+ * marked !important) and the prefixes are indexed in a trie. The result is a
+ * single QWebEngineScript that runs at DocumentCreation in the
+ * ApplicationWorld, so matching stylesheets exist before first paint and no
+ * per-page IPC is needed. Reinstalls only when the compiled generation changed.
+ *
+ * Patches with DomPatch::observe set are additionally applied as inline
+ * styles by one throttled MutationObserver per document, in batched
+ * requestAnimationFrame passes, so elements rendered later are covered too.
+ */
+void installDomPatchScript(QWebEngineProfile *profile);
+
+/**
+ * @brief Prepares a freshly created page for DOM patches.
+ * @param page The new QWebEnginePage
+ *
+ * Installs the current script on the page's profile and records that the
+ * page's future documents are covered by it. Call once when a page is created.
+ */
+void prepareDomPatchesForPage(QWebEnginePage *page);
+
+/**
+ * @brief Brings the page's current document up to date with the DOM patches.
  * @param page The QWebEnginePage to apply patches to
  *
- * Injects CSS rules via JavaScript by creating/updating <style> elements
- * with data-dom-patch-id attributes. Should be called after page loads
- * and on URL changes for single-page app support.
+ * If the patches changed since the current document was created, the
+ * compiled runtime is injected again (replacing the old stylesheets).
+ * Otherwise only a lightweight sync() call re-evaluates the URL prefix match,
+ * which is needed for same-document navigations in single-page apps.
+ * Call on URL changes and after editing patches.
  */
 void applyDomPatchesToPage(QWebEnginePage *page);
 
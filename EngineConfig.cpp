@@ -0,0 +1,197 @@
+#include "EngineConfig.h"
+#include "AppSettings.h"
+#include "Trace.h"
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDebug>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace {
+  constexpr const char *CHROMIUM_FLAGS_ENV_VAR = "QTWEBENGINE_CHROMIUM_FLAGS";
+  constexpr const char *SAFE_MODE_ENV_VAR = "PHRAIMS_SAFE_MODE";
+  constexpr int SAFE_MODE_CRASH_THRESHOLD = 2;  // consecutive failed startups before ignoring engine/*
+  constexpr int MAX_RENDERER_PROCESS_LIMIT = 64;
+
+  bool g_engineSafeMode = false;
+  bool g_engineStartupConfirmed = false;
+  QString g_effectiveChromiumFlags;
+
+  bool isKnownProcessModel(const QString &model) {
+    return model == QLatin1String("site-instance") || model == QLatin1String("site");
+  }
+}
+
+EngineSettings EngineSettings::load() {
+  AppSettings s;
+  EngineSettings e;
+  const QString model = s->value("engine/processModel", e.processModel).toString().trimmed().toLower();
+  if (isKnownProcessModel(model)) {
+    e.processModel = model;
+  } else {
+    qWarning() << "EngineSettings::load: unknown engine/processModel" << model << "- using" << e.processModel;
+  }
+  e.rendererProcessLimit = std::clamp(s->value("engine/rendererProcessLimit", 0).toInt(), 0, MAX_RENDERER_PROCESS_LIMIT);
+  e.gpuRasterization = s->value("engine/gpuRasterization", false).toBool();
+  e.zeroCopy = s->value("engine/zeroCopy", false).toBool();
+  e.extraFlags = s->value("engine/extraFlags").toString().simplified();
+  return e;
+}
+
+void EngineSettings::save() const {
+  AppSettings s;
+  s->setValue("engine/processModel", processModel);
+  s->setValue("engine/rendererProcessLimit", rendererProcessLimit);
+  s->setValue("engine/gpuRasterization", gpuRasterization);
+  s->setValue("engine/zeroCopy", zeroCopy);
+  s->setValue("engine/extraFlags", extraFlags.simplified());
+  // explicit new settings get a fresh chance on the next launch
+  s->setValue("engine/crashCount", 0);
+  s->sync();
+  qDebug() << "EngineSettings::save: flags on next launch:" << chromiumFlags().join(QLatin1Char(' '));
+}
+
+QStringList EngineSettings::chromiumFlags() const {
+  QStringList flags;
+  if (processModel == QLatin1String("site")) flags << QStringLiteral("--process-per-site");
+  if (rendererProcessLimit > 0) flags << QStringLiteral("--renderer-process-limit=%1").arg(rendererProcessLimit);
+  if (gpuRasterization) flags << QStringLiteral("--enable-gpu-rasterization");
+  if (zeroCopy) flags << QStringLiteral("--enable-zero-copy");
+  if (!extraFlags.isEmpty()) flags << extraFlags.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+  return flags;
+}
+
+void applyEngineConfig() {
+  PHRAIMS_TRACE_SCOPE("applyEngineConfig");
+  AppSettings s;
+  int crashCount = s->value("engine/crashCount", 0).toInt();
+  if (s->value("engine/startupPending", false).toBool()) {
+    ++crashCount;
+    qWarning() << "applyEngineConfig: previous launch did not finish starting up; failed startups in a row:" << crashCount;
+  }
+  const QByteArray safeEnv = qgetenv(SAFE_MODE_ENV_VAR).trimmed();
+  g_engineSafeMode = crashCount >= SAFE_MODE_CRASH_THRESHOLD || (!safeEnv.isEmpty() && safeEnv != "0");
+  // Written before any engine code runs so a crash anywhere in startup is seen next time.
+  s->setValue("engine/crashCount", crashCount);
+  s->setValue("engine/startupPending", true);
+  s->sync();
+
+  QStringList flags;
+  if (g_engineSafeMode) {
+    qWarning() << "applyEngineConfig: SAFE MODE - ignoring engine/* settings";
+  } else {
+    flags = EngineSettings::load().chromiumFlags();
+  }
+  const QString existing = QString::fromLocal8Bit(qgetenv(CHROMIUM_FLAGS_ENV_VAR)).simplified();
+  if (!existing.isEmpty()) flags << existing;
+  g_effectiveChromiumFlags = flags.join(QLatin1Char(' '));
+  if (!g_effectiveChromiumFlags.isEmpty()) {
+    qputenv(CHROMIUM_FLAGS_ENV_VAR, g_effectiveChromiumFlags.toLocal8Bit());
+  }
+  qDebug() << "applyEngineConfig:" << CHROMIUM_FLAGS_ENV_VAR << "=" << g_effectiveChromiumFlags;
+}
+
+void markEngineStartupSucceeded() {
+  if (g_engineStartupConfirmed) return;
+  g_engineStartupConfirmed = true;
+  AppSettings s;
+  s->setValue("engine/startupPending", false);
+  // safe mode sticks until the settings are saved again (EngineSettings::save)
+  if (!g_engineSafeMode) s->setValue("engine/crashCount", 0);
+  s->sync();
+  qDebug() << "markEngineStartupSucceeded: safeMode=" << g_engineSafeMode;
+}
+
+bool isEngineSafeMode() {
+  return g_engineSafeMode;
+}
+
+QString effectiveChromiumFlags() {
+  return g_effectiveChromiumFlags;
+}
+
+EngineSettingsDialog::EngineSettingsDialog(QWidget *parent) : QDialog(parent) {
+  setWindowTitle(tr("Engine Settings"));
+  resize(560, 0);
+  auto *lay = new QVBoxLayout(this);
+
+  if (isEngineSafeMode()) {
+    auto *safeLabel = new QLabel(tr("<b>Safe mode:</b> the last launches crashed during startup, so these settings "
+                                    "are currently ignored. Save to try them (or new ones) again on the next launch."),
+                                 this);
+    safeLabel->setWordWrap(true);
+    lay->addWidget(safeLabel);
+  }
+
+  auto *form = new QFormLayout();
+  processModelCombo_ = new QComboBox(this);
+  processModelCombo_->addItem(tr("Process per site instance (default, most isolated)"), QStringLiteral("site-instance"));
+  processModelCombo_->addItem(tr("Process per site (fewer renderers, less memory)"), QStringLiteral("site"));
+  form->addRow(tr("Renderer processes:"), processModelCombo_);
+
+  rendererLimitSpin_ = new QSpinBox(this);
+  rendererLimitSpin_->setRange(0, MAX_RENDERER_PROCESS_LIMIT);
+  rendererLimitSpin_->setSpecialValueText(tr("No limit"));
+  form->addRow(tr("Renderer process limit:"), rendererLimitSpin_);
+
+  gpuRasterCheck_ = new QCheckBox(tr("GPU rasterization"), this);
+  form->addRow(QString(), gpuRasterCheck_);
+  zeroCopyCheck_ = new QCheckBox(tr("Zero-copy texture uploads"), this);
+  form->addRow(QString(), zeroCopyCheck_);
+
+  extraFlagsEdit_ = new QLineEdit(this);
+  extraFlagsEdit_->setPlaceholderText(QStringLiteral("--flag --other-flag=value"));
+  form->addRow(tr("Extra Chromium flags:"), extraFlagsEdit_);
+  lay->addLayout(form);
+
+  const QString running = effectiveChromiumFlags();
+  auto *runningLabel = new QLabel(tr("Running with: %1").arg(running.isEmpty() ? tr("(no flags)") : running), this);
+  runningLabel->setWordWrap(true);
+  runningLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  lay->addWidget(runningLabel);
+  auto *restartLabel = new QLabel(tr("Changes take effect after restarting Phraims."), this);
+  lay->addWidget(restartLabel);
+
+  auto *buttons = new QDialogButtonBox(QDialogButtonBox::Save | QDialogButtonBox::Cancel | QDialogButtonBox::RestoreDefaults, this);
+  connect(buttons, &QDialogButtonBox::accepted, this, &EngineSettingsDialog::onSave);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  connect(buttons->button(QDialogButtonBox::RestoreDefaults), &QPushButton::clicked, this, &EngineSettingsDialog::onRestoreDefaults);
+  lay->addWidget(buttons);
+
+  populate(EngineSettings::load());
+}
+
+void EngineSettingsDialog::populate(const EngineSettings &settings) {
+  const int modelIndex = processModelCombo_->findData(settings.processModel);
+  processModelCombo_->setCurrentIndex(modelIndex >= 0 ? modelIndex : 0);
+  rendererLimitSpin_->setValue(settings.rendererProcessLimit);
+  gpuRasterCheck_->setChecked(settings.gpuRasterization);
+  zeroCopyCheck_->setChecked(settings.zeroCopy);
+  extraFlagsEdit_->setText(settings.extraFlags);
+}
+
+void EngineSettingsDialog::onSave() {
+  EngineSettings e;
+  e.processModel = processModelCombo_->currentData().toString();
+  e.rendererProcessLimit = rendererLimitSpin_->value();
+  e.gpuRasterization = gpuRasterCheck_->isChecked();
+  e.zeroCopy = zeroCopyCheck_->isChecked();
+  e.extraFlags = extraFlagsEdit_->text().simplified();
+  e.save();
+  const QString next = e.chromiumFlags().join(QLatin1Char(' '));
+  if (next != effectiveChromiumFlags() || isEngineSafeMode()) {
+    QMessageBox::information(this, tr("Engine Settings"), tr("Restart Phraims to apply the new engine settings."));
+  }
+  accept();
+}
+
+void EngineSettingsDialog::onRestoreDefaults() {
+  populate(EngineSettings());
+}
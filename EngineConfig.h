@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QDialog>
+#include <QString>
+#include <QStringList>
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QSpinBox;
+
+/**
+ * @brief Chromium engine options stored under `engine/*` in AppSettings.
+ *
+ * QtWebEngine reads its Chromium command line (QTWEBENGINE_CHROMIUM_FLAGS)
+ * once, when the first profile is created, so these settings only take effect
+ * on the next launch. The renderer process model matters most with many
+ * frames: Chromium's default gives every site instance its own renderer,
+ * while `--process-per-site` and a renderer process limit trade isolation for
+ * a much smaller memory footprint.
+ */
+struct EngineSettings {
+  QString processModel = QStringLiteral("site-instance"); ///< `site-instance` (Chromium default) or `site`
+  int rendererProcessLimit = 0;                           ///< Max renderer processes; 0 lets Chromium decide
+  bool gpuRasterization = false;                          ///< Adds `--enable-gpu-rasterization`
+  bool zeroCopy = false;                                  ///< Adds `--enable-zero-copy`
+  QString extraFlags;                                     ///< Additional switches, space separated
+
+  /**
+   * @brief Reads the `engine/*` keys.
+   * @return Stored settings, with defaults for missing keys
+   */
+  static EngineSettings load();
+
+  /**
+   * @brief Writes the `engine/*` keys and leaves safe mode.
+   *
+   * Saving resets the crash counter so the next launch applies the new
+   * settings even if the previous ones triggered safe mode.
+   */
+  void save() const;
+
+  /**
+   * @brief Builds the Chromium switches for these settings.
+   * @return Switches in a stable order, e.g. `--process-per-site --renderer-process-limit=8`
+   */
+  QStringList chromiumFlags() const;
+};
+
+/**
+ * @brief Applies the engine settings to the environment; call before constructing QApplication.
+ *
+ * Also runs the startup crash sentinel: `engine/startupPending` is set (and
+ * synced to disk) here and cleared by markEngineStartupSucceeded(). Finding it
+ * still set means the previous launch died during startup; after
+ * SAFE_MODE_CRASH_THRESHOLD such launches in a row the `engine/*` settings
+ * are ignored (safe mode) until they are saved again. `PHRAIMS_SAFE_MODE=1`
+ * forces safe mode for one launch.
+ *
+ * Flags already present in QTWEBENGINE_CHROMIUM_FLAGS are kept and placed
+ * after ours, so an explicit environment always wins.
+ */
+void applyEngineConfig();
+
+/**
+ * @brief Clears the startup crash sentinel once the session is up.
+ *
+ * Called when the session restore finishes and on a clean quit. Outside safe
+ * mode this also resets the crash counter. Safe to call more than once.
+ */
+void markEngineStartupSucceeded();
+
+/**
+ * @brief Returns whether this launch ignored the engine settings.
+ * @return true when safe mode was entered by applyEngineConfig()
+ */
+bool isEngineSafeMode();
+
+/**
+ * @brief Returns the Chromium flags this process was started with.
+ * @return The final QTWEBENGINE_CHROMIUM_FLAGS value set by applyEngineConfig()
+ */
+QString effectiveChromiumFlags();
+
+/**
+ * @brief Preferences page for the `engine/*` settings (Tools -> Engine Settings).
+ *
+ * Saving writes the settings and reminds the user that they apply after a
+ * restart; the dialog also shows the flags the running process uses and
+ * whether it is in safe mode.
+ */
+class EngineSettingsDialog : public QDialog {
+  Q_OBJECT
+public:
+  /**
+   * @brief Constructs the dialog populated from the stored settings.
+   * @param parent Optional parent widget
+   */
+  explicit EngineSettingsDialog(QWidget *parent = nullptr);
+
+private slots:
+  /** @brief Saves the edited settings and closes the dialog. */
+  void onSave();
+
+  /** @brief Restores the default values in the form (not saved until Save). */
+  void onRestoreDefaults();
+
+private:
+  /** @brief Copies @p settings into the form widgets. */
+  void populate(const EngineSettings &settings);
+
+  QComboBox *processModelCombo_ = nullptr;  ///< Renderer process model
+  QSpinBox *rendererLimitSpin_ = nullptr;   ///< Renderer process limit (0 = unlimited)
+  QCheckBox *gpuRasterCheck_ = nullptr;     ///< GPU rasterization
+  QCheckBox *zeroCopyCheck_ = nullptr;      ///< Zero-copy uploads
+  QLineEdit *extraFlagsEdit_ = nullptr;     ///< Free-form extra switches
+};
@@ -0,0 +1,257 @@
+#include "FrameHibernation.h"
+#include "AppSettings.h"
+#include "FramePool.h"
+#include "RestoreScheduler.h"
+#include "SplitFrameWidget.h"
+#include "SplitWindow.h"
+#include <QApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QWebEnginePage>
+#include <QWidget>
+#include <QWindow>
+#include <algorithm>
+
+namespace {
+  constexpr int HIBERNATION_TICK_MS = 5000;          // how often idle transitions are evaluated
+  constexpr int DEFAULT_FREEZE_AFTER_SECONDS = 60;   // hidden + idle this long -> Frozen
+  constexpr int DEFAULT_DISCARD_AFTER_SECONDS = 600; // hidden + idle this long -> Discarded
+}
+
+FrameHibernationManager &FrameHibernationManager::instance() {
+  static FrameHibernationManager *inst = new FrameHibernationManager(qApp);
+  return *inst;
+}
+
+FrameHibernationManager::FrameHibernationManager(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  enabled_ = s->value("hibernation/enabled", true).toBool();
+  defaultPolicy_ = policyFromKey(s->value("background/defaultPolicy").toString(), BackgroundPolicy::Throttle);
+  const int freezeSec = std::max(0, s->value("hibernation/freezeAfterSeconds", DEFAULT_FREEZE_AFTER_SECONDS).toInt());
+  const int discardSec = std::max(freezeSec, s->value("hibernation/discardAfterSeconds", DEFAULT_DISCARD_AFTER_SECONDS).toInt());
+  freezeAfterMs_ = qint64(freezeSec) * 1000;
+  discardAfterMs_ = qint64(discardSec) * 1000;
+  qDebug() << "FrameHibernationManager: enabled=" << enabled_
+           << "freezeAfterSeconds=" << freezeSec << "discardAfterSeconds=" << discardSec
+           << "defaultPolicy=" << policyKey(defaultPolicy_);
+
+  timer_.setInterval(HIBERNATION_TICK_MS);
+  connect(&timer_, &QTimer::timeout, this, &FrameHibernationManager::tick);
+  if (enabled_) timer_.start();
+}
+
+void FrameHibernationManager::registerFrame(SplitFrameWidget *frame) {
+  if (!frame || frames_.contains(frame)) return;
+  frames_.insert(frame);
+  frame->installEventFilter(this);
+  // destroyed() fires from ~QObject, so only the pointer value is used here
+  connect(frame, &QObject::destroyed, this, [this](QObject *obj) {
+    frames_.remove(static_cast<SplitFrameWidget *>(obj));
+    keepAlive_.remove(static_cast<SplitFrameWidget *>(obj));
+  });
+}
+
+void FrameHibernationManager::setWindowPolicy(QWidget *window, BackgroundPolicy policy) {
+  if (!window) return;
+  if (!windowPolicies_.contains(window)) {
+    // destroyed() fires from ~QObject, so only the pointer value is used here
+    connect(window, &QObject::destroyed, this, [this](QObject *obj) {
+      windowPolicies_.remove(static_cast<QWidget *>(obj));
+    });
+  }
+  windowPolicies_.insert(window, policy);
+  qDebug() << "FrameHibernationManager: window" << window << "background policy" << policyKey(policy);
+  // windows still being constructed are evaluated once shown
+  if (window->isVisible()) evaluateWindow(window);
+}
+
+FrameHibernationManager::BackgroundPolicy FrameHibernationManager::windowPolicy(QWidget *window) const {
+  return windowPolicies_.value(window, defaultPolicy_);
+}
+
+void FrameHibernationManager::setKeepAlive(SplitFrameWidget *frame, bool keepAlive) {
+  if (!frame || keepAlive == keepAlive_.contains(frame)) return;
+  if (keepAlive) keepAlive_.insert(frame);
+  else keepAlive_.remove(frame);
+  evaluateFrame(frame);
+}
+
+bool FrameHibernationManager::isKeepAlive(SplitFrameWidget *frame) const {
+  return keepAlive_.contains(frame);
+}
+
+QString FrameHibernationManager::policyKey(BackgroundPolicy policy) {
+  switch (policy) {
+    case BackgroundPolicy::Freeze: return QStringLiteral("freeze");
+    case BackgroundPolicy::KeepLive: return QStringLiteral("live");
+    case BackgroundPolicy::Throttle: default: return QStringLiteral("throttle");
+  }
+}
+
+FrameHibernationManager::BackgroundPolicy FrameHibernationManager::policyFromKey(const QString &key, BackgroundPolicy fallback) {
+  if (key == QLatin1String("throttle")) return BackgroundPolicy::Throttle;
+  if (key == QLatin1String("freeze")) return BackgroundPolicy::Freeze;
+  if (key == QLatin1String("live")) return BackgroundPolicy::KeepLive;
+  return fallback;
+}
+
+void FrameHibernationManager::evaluateWindow(QWidget *window) {
+  if (!window) return;
+  for (SplitFrameWidget *frame : std::as_const(frames_)) {
+    if (frame->window() == window) evaluateFrame(frame);
+  }
+}
+
+void FrameHibernationManager::evaluateFrame(SplitFrameWidget *frame) {
+  if (!enabled_ || !frame) return;
+  // pool spares are hidden by design and must stay ready to use
+  if (FramePool::instance().contains(frame)) return;
+  QWebEnginePage *page = frame->page();
+  if (!page) return;
+
+  watchWindowHandle(frame);
+
+  if (frame->isContentVisible()) {
+    wakeFrame(frame);
+    return;
+  }
+
+  // Exempt frames and KeepLive windows run as if visible (feeds, audio).
+  const BackgroundPolicy policy = keepAlive_.contains(frame) ? BackgroundPolicy::KeepLive : windowPolicy(frame->window());
+  if (policy == BackgroundPolicy::KeepLive) {
+    wakeFrame(frame);
+    return;
+  }
+
+  // Let the page's Page Visibility API report it hidden so well-behaved
+  // sites throttle themselves before we escalate to freezing.
+  if (page->isVisible()) page->setVisible(false);
+
+  // Qt keeps pages with audible media or attached DevTools Active; honor that.
+  if (page->recommendedState() == QWebEnginePage::LifecycleState::Active) return;
+
+  const qint64 idleMs = frame->msecsSinceInteraction();
+  auto target = QWebEnginePage::LifecycleState::Active;
+  if (idleMs >= discardAfterMs_) target = QWebEnginePage::LifecycleState::Discarded;
+  else if (idleMs >= freezeAfterMs_) target = QWebEnginePage::LifecycleState::Frozen;
+  // Freeze applies to whole-window backgrounding; collapsed panes in a
+  // visible window keep the idle timeouts.
+  if (policy == BackgroundPolicy::Freeze && target < QWebEnginePage::LifecycleState::Frozen
+      && isWindowBackgrounded(frame)) {
+    target = QWebEnginePage::LifecycleState::Frozen;
+  }
+
+  // Only ever move deeper while hidden; waking is handled by wakeFrame().
+  if (target <= page->lifecycleState()) return;
+  qDebug() << "FrameHibernationManager: moving frame" << frame << "from" << int(page->lifecycleState())
+           << "to" << int(target) << "idleMs=" << idleMs << "url=" << page->url();
+  // last chance to grab the content; minimized and covered windows still grab
+  if (page->lifecycleState() == QWebEnginePage::LifecycleState::Active) frame->captureSnapshot();
+  page->setLifecycleState(target);
+}
+
+bool FrameHibernationManager::discardHiddenFrame(SplitFrameWidget *frame) {
+  if (!frame || frame->isContentVisible() || keepAlive_.contains(frame)) return false;
+  if (FramePool::instance().contains(frame)) return false;
+  QWebEnginePage *page = frame->page();
+  if (!page || page->lifecycleState() == QWebEnginePage::LifecycleState::Discarded) return false;
+  // Qt keeps pages with audible media or attached DevTools Active; honor that.
+  if (page->recommendedState() == QWebEnginePage::LifecycleState::Active) return false;
+  if (page->isVisible()) page->setVisible(false);
+  qDebug() << "FrameHibernationManager: discarding hidden frame" << frame << "url=" << page->url();
+  if (page->lifecycleState() == QWebEnginePage::LifecycleState::Active) frame->captureSnapshot();
+  page->setLifecycleState(QWebEnginePage::LifecycleState::Discarded);
+  return true;
+}
+
+int FrameHibernationManager::countInState(QWebEnginePage::LifecycleState state) const {
+  int count = 0;
+  for (SplitFrameWidget *frame : frames_) {
+    if (QWebEnginePage *page = frame->page()) {
+      if (page->lifecycleState() == state) ++count;
+    }
+  }
+  return count;
+}
+
+bool FrameHibernationManager::eventFilter(QObject *watched, QEvent *event) {
+  switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::Resize:
+      if (auto *frame = qobject_cast<SplitFrameWidget *>(watched)) {
+        if (frames_.contains(frame) && frame->isContentVisible()) wakeFrame(frame);
+      }
+      break;
+    case QEvent::Hide:
+      // a hidden window hides its frames; apply the background policy now
+      if (auto *frame = qobject_cast<SplitFrameWidget *>(watched)) {
+        if (frames_.contains(frame)) evaluateFrame(frame);
+      }
+      break;
+    case QEvent::Expose:
+      // Expose also reports a window becoming fully covered (isExposed() false)
+      if (auto *handle = qobject_cast<QWindow *>(watched)) {
+        for (SplitFrameWidget *frame : std::as_const(frames_)) {
+          if (frame->window()->windowHandle() == handle) evaluateFrame(frame);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  return QObject::eventFilter(watched, event);
+}
+
+void FrameHibernationManager::tick() {
+  for (SplitFrameWidget *frame : std::as_const(frames_)) {
+    evaluateFrame(frame);
+  }
+}
+
+void FrameHibernationManager::wakeFrame(SplitFrameWidget *frame) {
+  if (!enabled_ || !frame) return;
+  QWebEnginePage *page = frame->page();
+  if (!page) return;
+  if (!page->isVisible()) page->setVisible(true);
+  const auto state = page->lifecycleState();
+  if (state == QWebEnginePage::LifecycleState::Active) return;
+
+  qDebug() << "FrameHibernationManager: waking frame" << frame << "from" << int(state) << "url=" << page->url();
+  // a discarded page reloads from scratch; paint its snapshot meanwhile
+  if (state == QWebEnginePage::LifecycleState::Discarded) {
+    frame->showSnapshot(page->url().isEmpty() ? frame->address() : page->url().toString());
+  }
+  page->setLifecycleState(QWebEnginePage::LifecycleState::Active);
+
+  // Activating a discarded page reloads its last committed URL. If nothing
+  // was ever committed (e.g. it was discarded mid-navigation) fall back to
+  // the address persisted in the owning window's FrameState.
+  // Frames still waiting for their session-restore slot are loaded by
+  // RestoreScheduler once visible; don't race it here.
+  if (state == QWebEnginePage::LifecycleState::Discarded && page->url().isEmpty()
+      && !RestoreScheduler::instance().isPending(frame)) {
+    QString address = frame->address();
+    if (auto *window = qobject_cast<SplitWindow *>(frame->window())) {
+      address = window->frameAddress(frame);
+    }
+    if (!address.isEmpty()) frame->applyAddress(address);
+  }
+}
+
+bool FrameHibernationManager::isWindowBackgrounded(SplitFrameWidget *frame) {
+  const QWidget *top = frame->window();
+  if (!top || !top->isVisible() || top->isMinimized()) return true;
+  const QWindow *handle = top->windowHandle();
+  return handle && !handle->isExposed();
+}
+
+void FrameHibernationManager::watchWindowHandle(SplitFrameWidget *frame) {
+  QWidget *top = frame->window();
+  QWindow *handle = top ? top->windowHandle() : nullptr;
+  if (!handle || watchedWindows_.contains(handle)) return;
+  watchedWindows_.insert(handle);
+  handle->installEventFilter(this);
+  connect(handle, &QObject::destroyed, this, [this](QObject *obj) {
+    watchedWindows_.remove(static_cast<QWindow *>(obj));
+  });
+}
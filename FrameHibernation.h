@@ -0,0 +1,179 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <QWebEnginePage>
+
+class QWindow;
+class QWidget;
+class SplitFrameWidget;
+
+/**
+ * @brief Moves frame pages through the QWebEnginePage lifecycle states.
+ *
+ * The manager watches every registered SplitFrameWidget and drives its page
+ * between Active, Frozen, and Discarded based on two inputs:
+ * - Visibility: the frame's web view is hidden, its window is minimized or
+ *   not exposed (covered), or the frame is collapsed to zero size in a splitter.
+ * - Idle time: milliseconds since the frame last emitted interactionOccurred.
+ *
+ * Hidden frames are marked not visible right away (so the Page Visibility API
+ * reports them hidden), frozen after `hibernation/freezeAfterSeconds`, and
+ * discarded after `hibernation/discardAfterSeconds`. Pages Qt recommends to
+ * keep Active (audible media, attached DevTools) are left alone. As soon as a
+ * frame is shown again it is made Active; a discarded page whose URL was lost
+ * is revived from the owning window's FrameState address.
+ *
+ * Each window has a BackgroundPolicy (stored in its SessionStore entry,
+ * default `background/defaultPolicy`) deciding what happens while the
+ * window is minimized, hidden, or fully covered: Throttle applies the idle
+ * timeouts above, Freeze freezes its pages immediately, KeepLive leaves
+ * them running. Individual frames can be exempted with setKeepAlive()
+ * (e.g. audio or WebSocket feeds); they are never marked hidden or frozen.
+ *
+ * A single application-wide instance is shared by all windows.
+ */
+class FrameHibernationManager : public QObject {
+  Q_OBJECT
+
+public:
+  /** @brief What a window's pages do while the window is in the background. */
+  enum class BackgroundPolicy {
+    Throttle, ///< Mark hidden now; freeze/discard after the hibernation idle timeouts (default)
+    Freeze,   ///< Mark hidden and freeze as soon as the window is minimized, hidden, or covered
+    KeepLive  ///< Never throttle; pages keep running as if visible
+  };
+
+  /**
+   * @brief Returns the shared manager, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static FrameHibernationManager &instance();
+
+  /**
+   * @brief Starts tracking a frame.
+   * @param frame The frame to watch; unregistered automatically on destruction
+   *
+   * Installs an event filter so the frame is woken immediately when it is
+   * shown or resized back to a non-zero size.
+   */
+  void registerFrame(SplitFrameWidget *frame);
+
+  /**
+   * @brief Re-evaluates every frame hosted by the given top-level window.
+   * @param window The window whose state (minimized/hidden/exposed) changed
+   *
+   * Called from SplitWindow::changeEvent so frames wake as soon as a window
+   * is restored instead of waiting for the next periodic tick.
+   */
+  void evaluateWindow(QWidget *window);
+
+  /**
+   * @brief Re-evaluates a single frame right away.
+   * @param frame The frame to check
+   */
+  void evaluateFrame(SplitFrameWidget *frame);
+
+  /**
+   * @brief Discards a hidden frame's page right away, skipping the idle timeouts.
+   * @param frame The frame to discard
+   * @return false if the frame is visible, exempt (keep-alive, audible media, DevTools) or already discarded
+   *
+   * Used by MemoryBudget and the ScrollGrid layout. Works even when
+   * `hibernation/enabled` is false; the page reloads once it is shown again.
+   */
+  bool discardHiddenFrame(SplitFrameWidget *frame);
+
+  /**
+   * @brief Returns how many tracked pages are currently in a lifecycle state.
+   * @param state The lifecycle state to count
+   * @return Number of registered frames whose page is in that state
+   */
+  int countInState(QWebEnginePage::LifecycleState state) const;
+
+  /**
+   * @brief Sets the background policy for a top-level window and re-evaluates its frames.
+   * @param window The SplitWindow (or other top-level widget) hosting frames
+   * @param policy The policy to apply; windows without one use `background/defaultPolicy`
+   */
+  void setWindowPolicy(QWidget *window, BackgroundPolicy policy);
+
+  /**
+   * @brief Returns the policy in effect for a window.
+   * @param window The top-level window
+   * @return The window's policy, or the configured default
+   */
+  BackgroundPolicy windowPolicy(QWidget *window) const;
+
+  /**
+   * @brief Returns the policy used by windows without their own (`background/defaultPolicy`).
+   * @return The configured default policy
+   */
+  BackgroundPolicy defaultPolicy() const { return defaultPolicy_; }
+
+  /**
+   * @brief Exempts a frame from background throttling (or removes the exemption).
+   * @param frame The frame to update
+   * @param keepAlive true to keep the page visible and Active even when hidden
+   */
+  void setKeepAlive(SplitFrameWidget *frame, bool keepAlive);
+
+  /**
+   * @brief Returns whether a frame is exempt from background throttling.
+   * @param frame The frame to check
+   * @return true if setKeepAlive(frame, true) is in effect
+   */
+  bool isKeepAlive(SplitFrameWidget *frame) const;
+
+  /**
+   * @brief Returns the settings value for a policy ("throttle", "freeze", "live").
+   * @param policy The policy to convert
+   * @return Persisted string key
+   */
+  static QString policyKey(BackgroundPolicy policy);
+
+  /**
+   * @brief Parses a persisted policy string.
+   * @param key Value read from settings
+   * @param fallback Policy to return for empty or unknown values
+   * @return The matching policy
+   */
+  static BackgroundPolicy policyFromKey(const QString &key, BackgroundPolicy fallback);
+
+protected:
+  /**
+   * @brief Wakes frames on Show/Resize and windows on Expose events.
+   * @param watched The frame widget or QWindow being watched
+   * @param event The event being filtered
+   * @return Always false so events propagate normally
+   */
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+  explicit FrameHibernationManager(QObject *parent = nullptr);
+
+  /** @brief Periodic pass over all frames applying idle-based transitions. */
+  void tick();
+
+  /** @brief Makes the frame's page visible and Active, reviving it if it was discarded. */
+  void wakeFrame(SplitFrameWidget *frame);
+
+  /** @brief Installs an Expose watcher on the frame's top-level QWindow once. */
+  void watchWindowHandle(SplitFrameWidget *frame);
+
+  /** @brief Returns whether the frame's window is minimized, hidden, or not exposed. */
+  static bool isWindowBackgrounded(SplitFrameWidget *frame);
+
+  QTimer timer_;                         ///< Drives the periodic idle evaluation
+  QSet<SplitFrameWidget *> frames_;      ///< Frames currently being tracked
+  QSet<QWindow *> watchedWindows_;       ///< Top-level windows with an Expose watcher installed
+  QHash<QWidget *, BackgroundPolicy> windowPolicies_; ///< Per-window background policies
+  QSet<SplitFrameWidget *> keepAlive_;   ///< Frames exempt from background throttling
+  BackgroundPolicy defaultPolicy_ = BackgroundPolicy::Throttle; ///< Mirrors background/defaultPolicy
+  bool enabled_ = true;                  ///< Mirrors hibernation/enabled
+  qint64 freezeAfterMs_ = 0;             ///< Idle time before a hidden page is frozen
+  qint64 discardAfterMs_ = 0;            ///< Idle time before a hidden page is discarded
+};
@@ -0,0 +1,551 @@
+#include "FrameMetrics.h"
+#include "AppSettings.h"
+#include "ContentBlocker.h"
+#include "SplitFrameWidget.h"
+#include "SplitWindow.h"
+#include "version.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPushButton>
+#include <QSaveFile>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+#include <QVariantMap>
+#include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWebEngineScript>
+#include <QWebEngineScriptCollection>
+#include <algorithm>
+
+#if defined(Q_OS_MACOS)
+#include <libproc.h>
+#include <mach/mach_time.h>
+#elif defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr int SAMPLE_INTERVAL_MS = 2000; // renderer process sampling period
+  constexpr int DEFAULT_SAMPLES_PER_FRAME = 100; // performance log ring size per frame
+  constexpr int MAX_SAMPLES_PER_FRAME = 10000;
+  constexpr int MAX_LOGGED_FRAMES = 256;         // rings kept; the idlest is dropped beyond this
+
+  constexpr const char *kObserverScriptName = "phraims-perf-observer";
+
+  // Installed at document creation (ApplicationWorld): records long tasks and
+  // the latest largest-contentful-paint candidate, which are only observable
+  // while the page runs.
+  constexpr const char *kObserverScript = R"JS(
+(function(){
+  if (window.__phraimsPerf) return;
+  var perf = window.__phraimsPerf = { longTasks: 0, longTaskMs: 0, lcp: -1 };
+  try {
+    new PerformanceObserver(function(list){
+      list.getEntries().forEach(function(e){ perf.longTasks++; perf.longTaskMs += e.duration; });
+    }).observe({ type: 'longtask', buffered: true });
+  } catch (e) {}
+  try {
+    new PerformanceObserver(function(list){
+      var entries = list.getEntries();
+      if (entries.length) perf.lcp = entries[entries.length - 1].startTime;
+    }).observe({ type: 'largest-contentful-paint', buffered: true });
+  } catch (e) {}
+})();
+)JS";
+
+  // Runs in the ApplicationWorld after a load: Navigation and Paint Timing
+  // (relative to navigation start), the observer's counters, JS heap size and
+  // the DOM patch runtime's last sync() duration.
+  constexpr const char *kPageTimingScript = R"JS(
+(function(){
+  var out = { responseStart: -1, domContentLoaded: -1, loadEvent: -1, domPatch: -1,
+              firstPaint: -1, firstContentfulPaint: -1, lcp: -1, longTasks: -1, longTaskMs: -1,
+              heapUsed: -1, heapTotal: -1 };
+  try {
+    var nav = performance.getEntriesByType('navigation')[0];
+    if (nav) {
+      out.responseStart = nav.responseStart;
+      out.domContentLoaded = nav.domContentLoadedEventEnd;
+      out.loadEvent = nav.loadEventEnd;
+    }
+    performance.getEntriesByType('paint').forEach(function(e){
+      if (e.name === 'first-paint') out.firstPaint = e.startTime;
+      else if (e.name === 'first-contentful-paint') out.firstContentfulPaint = e.startTime;
+    });
+    var perf = window.__phraimsPerf;
+    if (perf) {
+      out.lcp = perf.lcp;
+      out.longTasks = perf.longTasks;
+      out.longTaskMs = perf.longTaskMs;
+    }
+    if (performance.memory) {
+      out.heapUsed = performance.memory.usedJSHeapSize;
+      out.heapTotal = performance.memory.totalJSHeapSize;
+    }
+    var dp = window.__phraimsDomPatch;
+    if (dp && typeof dp.lastSyncMs === 'number') out.domPatch = dp.lastSyncMs;
+  } catch (e) {}
+  return out;
+})();
+)JS";
+
+  /** @brief Quotes a CSV field when it contains a separator, quote or line break. */
+  QString csvField(const QString &value) {
+    if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"')) && !value.contains(QLatin1Char('\n'))) return value;
+    QString quoted = value;
+    quoted.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+    return QLatin1Char('"') + quoted + QLatin1Char('"');
+  }
+
+  QString formatBytes(qint64 bytes) {
+    if (bytes < 0) return QStringLiteral("?");
+    if (bytes >= qint64(1024) * 1024 * 1024) return QStringLiteral("%1 GB").arg(bytes / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+    return QStringLiteral("%1 MB").arg(bytes / (1024 * 1024));
+  }
+
+  /** @brief Higher cost sorts first: CPU, then resident memory. */
+  bool costlier(const FrameMetrics &a, const FrameMetrics &b) {
+    if (a.cpuPercent != b.cpuPercent) return a.cpuPercent > b.cpuPercent;
+    return a.residentBytes > b.residentBytes;
+  }
+}
+
+FrameMetricsSampler &FrameMetricsSampler::instance() {
+  static FrameMetricsSampler *inst = new FrameMetricsSampler(qApp);
+  return *inst;
+}
+
+FrameMetricsSampler::FrameMetricsSampler(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  enabled_ = s->value("perfHud/enabled", false).toBool();
+  logEnabled_ = s->value("perfLog/enabled", true).toBool();
+  samplesPerFrame_ = std::clamp(s->value("perfLog/samplesPerFrame", DEFAULT_SAMPLES_PER_FRAME).toInt(),
+                                1, MAX_SAMPLES_PER_FRAME);
+  clock_.start();
+  timer_.setInterval(SAMPLE_INTERVAL_MS);
+  connect(&timer_, &QTimer::timeout, this, &FrameMetricsSampler::sample);
+  updateTimer();
+}
+
+void FrameMetricsSampler::registerFrame(SplitFrameWidget *frame) {
+  if (!frame || metrics_.contains(frame)) return;
+  metrics_.insert(frame, FrameMetrics());
+  frame->setPerfHudVisible(enabled_);
+
+  connect(frame, &SplitFrameWidget::pageLoadStarted, this, [this](SplitFrameWidget *who) {
+    loadClocks_[who].start();
+  });
+  connect(frame, &SplitFrameWidget::pageLoadFinished, this, [this](SplitFrameWidget *who, bool ok) {
+    auto it = metrics_.find(who);
+    if (it == metrics_.end()) return;
+    const auto clock = loadClocks_.constFind(who);
+    if (clock != loadClocks_.constEnd() && clock->isValid()) it->loadMs = clock->elapsed();
+    if (ok && (enabled_ || viewers_ > 0 || logEnabled_)) collectPageTimings(who);
+    else updateHud(who);
+  });
+  // destroyed() fires from ~QObject, so only the pointer value is used here
+  connect(frame, &QObject::destroyed, this, [this](QObject *obj) {
+    auto *who = static_cast<SplitFrameWidget *>(obj);
+    metrics_.remove(who);
+    loadClocks_.remove(who);
+  });
+}
+
+void FrameMetricsSampler::setEnabled(bool enabled) {
+  if (enabled_ == enabled) return;
+  enabled_ = enabled;
+  AppSettings s;
+  s->setValue("perfHud/enabled", enabled);
+  qDebug() << "FrameMetricsSampler: perf HUD" << (enabled ? "enabled" : "disabled");
+  for (auto it = metrics_.constBegin(); it != metrics_.constEnd(); ++it) {
+    it.key()->setPerfHudVisible(enabled);
+  }
+  updateTimer();
+  if (enabled) sample();
+  emit enabledChanged(enabled);
+}
+
+void FrameMetricsSampler::addViewer() {
+  ++viewers_;
+  updateTimer();
+  sample();
+}
+
+void FrameMetricsSampler::removeViewer() {
+  viewers_ = std::max(0, viewers_ - 1);
+  updateTimer();
+}
+
+FrameMetrics FrameMetricsSampler::metricsFor(SplitFrameWidget *frame) const {
+  return metrics_.value(frame);
+}
+
+void FrameMetricsSampler::updateTimer() {
+  const bool wanted = enabled_ || viewers_ > 0;
+  if (wanted && !timer_.isActive()) timer_.start();
+  else if (!wanted && timer_.isActive()) {
+    timer_.stop();
+    processes_.clear();
+  }
+}
+
+void FrameMetricsSampler::sample() {
+  // Group frames by renderer so each process is read exactly once.
+  QMap<qint64, QList<SplitFrameWidget *>> framesByPid;
+  for (auto it = metrics_.begin(); it != metrics_.end(); ++it) {
+    QWebEnginePage *page = it.key()->page();
+    it->pid = page ? page->renderProcessPid() : 0;
+    it->blockedRequests = page && ContentBlocker::instance().isEnabled()
+                            ? ContentBlocker::instance().blockedCount(page->profile(), page->url()) : -1;
+    if (it->pid > 0) framesByPid[it->pid].push_back(it.key());
+    else {
+      it->residentBytes = -1;
+      it->cpuPercent = -1;
+      it->sharedProcess = false;
+    }
+  }
+
+  const qint64 nowNs = clock_.nsecsElapsed();
+  QMap<qint64, ProcessSample> next;
+  for (auto it = framesByPid.constBegin(); it != framesByPid.constEnd(); ++it) {
+    qint64 resident = -1;
+    qint64 cpuNs = -1;
+    double cpuPercent = -1;
+    if (readProcessStats(it.key(), &resident, &cpuNs)) {
+      const ProcessSample prev = processes_.value(it.key());
+      if (prev.cpuNs >= 0 && nowNs > prev.wallNs) {
+        cpuPercent = 100.0 * double(cpuNs - prev.cpuNs) / double(nowNs - prev.wallNs);
+      }
+      next.insert(it.key(), ProcessSample{cpuNs, nowNs});
+    }
+    for (SplitFrameWidget *frame : it.value()) {
+      FrameMetrics &m = metrics_[frame];
+      m.residentBytes = resident;
+      m.cpuPercent = cpuPercent;
+      m.sharedProcess = it.value().size() > 1;
+    }
+  }
+  processes_ = next; // drops renderers that went away
+
+  if (enabled_) {
+    for (auto it = metrics_.constBegin(); it != metrics_.constEnd(); ++it) updateHud(it.key());
+  }
+  emit sampled();
+}
+
+void FrameMetricsSampler::collectPageTimings(SplitFrameWidget *frame) {
+  QWebEnginePage *page = frame->page();
+  if (!page) return;
+  QPointer<SplitFrameWidget> guard(frame);
+  page->runJavaScript(QString::fromLatin1(kPageTimingScript), QWebEngineScript::ApplicationWorld,
+                      [this, guard](const QVariant &result) {
+    if (!guard) return;
+    auto it = metrics_.find(guard);
+    if (it == metrics_.end()) return;
+    const QVariantMap map = result.toMap();
+    it->responseStartMs = map.value(QStringLiteral("responseStart"), -1).toDouble();
+    it->domContentLoadedMs = map.value(QStringLiteral("domContentLoaded"), -1).toDouble();
+    it->loadEventMs = map.value(QStringLiteral("loadEvent"), -1).toDouble();
+    it->domPatchMs = map.value(QStringLiteral("domPatch"), -1).toDouble();
+    it->firstPaintMs = map.value(QStringLiteral("firstPaint"), -1).toDouble();
+    it->firstContentfulPaintMs = map.value(QStringLiteral("firstContentfulPaint"), -1).toDouble();
+    it->largestContentfulPaintMs = map.value(QStringLiteral("lcp"), -1).toDouble();
+    it->longTasks = map.value(QStringLiteral("longTasks"), -1).toInt();
+    it->longTaskMs = map.value(QStringLiteral("longTaskMs"), -1).toDouble();
+    it->jsHeapUsedBytes = map.value(QStringLiteral("heapUsed"), -1).toLongLong();
+    it->jsHeapTotalBytes = map.value(QStringLiteral("heapTotal"), -1).toLongLong();
+    if (logEnabled_) logSample(guard, *it);
+    updateHud(guard);
+  });
+}
+
+void FrameMetricsSampler::logSample(SplitFrameWidget *frame, const FrameMetrics &m) {
+  // pooled and speculative frames belong to no window yet
+  if (frame->frameId() == 0) return;
+  // the log outlives its frames and is exported to disk; keep private browsing out of it
+  QWebEnginePage *page = frame->page();
+  if (!page || page->profile()->isOffTheRecord()) return;
+  PerfLogSample sample;
+  sample.timestampMs = QDateTime::currentMSecsSinceEpoch();
+  sample.frameId = frame->frameId();
+  sample.url = page->url().toString();
+  sample.metrics = m;
+  if (!timer_.isActive()) {
+    // the sampler is idle without a HUD; read the renderer's memory for this entry
+    sample.metrics.pid = page->renderProcessPid();
+    qint64 cpuNs = -1;
+    if (sample.metrics.pid <= 0 || !readProcessStats(sample.metrics.pid, &sample.metrics.residentBytes, &cpuNs)) {
+      sample.metrics.residentBytes = -1;
+    }
+  }
+
+  if (!perfLog_.contains(sample.frameId) && perfLog_.size() >= MAX_LOGGED_FRAMES) {
+    auto idlest = perfLog_.begin();
+    for (auto it = perfLog_.begin(); it != perfLog_.end(); ++it) {
+      if (it->lastMs < idlest->lastMs) idlest = it;
+    }
+    perfLog_.erase(idlest);
+  }
+  perfLog_[sample.frameId].push(sample, samplesPerFrame_);
+}
+
+void FrameMetricsSampler::PerfLogRing::push(const PerfLogSample &sample, int capacity) {
+  lastMs = sample.timestampMs;
+  if ((int)samples.size() < capacity) {
+    samples.push_back(sample);
+    return;
+  }
+  samples[next] = sample;
+  next = (next + 1) % samples.size();
+}
+
+std::vector<PerfLogSample> FrameMetricsSampler::PerfLogRing::ordered() const {
+  std::vector<PerfLogSample> out;
+  out.reserve(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) out.push_back(samples[(next + i) % samples.size()]);
+  return out;
+}
+
+int FrameMetricsSampler::logSampleCount() const {
+  int count = 0;
+  for (const PerfLogRing &ring : perfLog_) count += int(ring.samples.size());
+  return count;
+}
+
+void FrameMetricsSampler::installPageScript(QWebEngineProfile *profile) {
+  if (!profile) return;
+  QWebEngineScriptCollection *scripts = profile->scripts();
+  if (!scripts->find(QString::fromLatin1(kObserverScriptName)).isEmpty()) return;
+  QWebEngineScript script;
+  script.setName(QString::fromLatin1(kObserverScriptName));
+  script.setSourceCode(QString::fromLatin1(kObserverScript));
+  script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+  script.setWorldId(QWebEngineScript::ApplicationWorld);
+  script.setRunsOnSubFrames(false);
+  scripts->insert(script);
+}
+
+bool FrameMetricsSampler::exportLog(const QString &path, QString *error) const {
+  // frame IDs grow with creation order, so sorting keeps the export stable
+  QList<quint64> ids = perfLog_.keys();
+  std::sort(ids.begin(), ids.end());
+  const bool json = QFileInfo(path).suffix().compare(QLatin1String("json"), Qt::CaseInsensitive) == 0;
+  auto iso = [](qint64 ms) { return QDateTime::fromMSecsSinceEpoch(ms).toUTC().toString(Qt::ISODateWithMs); };
+
+  QByteArray data;
+  if (json) {
+    QJsonArray frames;
+    for (quint64 id : std::as_const(ids)) {
+      QJsonArray samples;
+      for (const PerfLogSample &s : perfLog_.value(id).ordered()) {
+        const FrameMetrics &m = s.metrics;
+        QJsonObject o;
+        o[QStringLiteral("time")] = iso(s.timestampMs);
+        o[QStringLiteral("url")] = s.url;
+        o[QStringLiteral("loadMs")] = double(m.loadMs);
+        o[QStringLiteral("responseStartMs")] = m.responseStartMs;
+        o[QStringLiteral("domContentLoadedMs")] = m.domContentLoadedMs;
+        o[QStringLiteral("loadEventMs")] = m.loadEventMs;
+        o[QStringLiteral("firstPaintMs")] = m.firstPaintMs;
+        o[QStringLiteral("firstContentfulPaintMs")] = m.firstContentfulPaintMs;
+        o[QStringLiteral("largestContentfulPaintMs")] = m.largestContentfulPaintMs;
+        o[QStringLiteral("longTasks")] = m.longTasks;
+        o[QStringLiteral("longTaskMs")] = m.longTaskMs;
+        o[QStringLiteral("jsHeapUsedBytes")] = double(m.jsHeapUsedBytes);
+        o[QStringLiteral("jsHeapTotalBytes")] = double(m.jsHeapTotalBytes);
+        o[QStringLiteral("residentBytes")] = double(m.residentBytes);
+        o[QStringLiteral("cpuPercent")] = m.cpuPercent;
+        o[QStringLiteral("sharedProcess")] = m.sharedProcess;
+        o[QStringLiteral("domPatchMs")] = m.domPatchMs;
+        o[QStringLiteral("blockedRequests")] = m.blockedRequests;
+        samples.append(o);
+      }
+      QJsonObject frame;
+      frame[QStringLiteral("frameId")] = QString::number(id);
+      frame[QStringLiteral("samples")] = samples;
+      frames.append(frame);
+    }
+    QJsonObject root;
+    root[QStringLiteral("app")] = QCoreApplication::applicationName();
+    root[QStringLiteral("version")] = QStringLiteral(PHRAIMS_VERSION);
+    root[QStringLiteral("exported")] = iso(QDateTime::currentMSecsSinceEpoch());
+    root[QStringLiteral("frames")] = frames;
+    data = QJsonDocument(root).toJson(QJsonDocument::Indented);
+  } else {
+    QStringList lines;
+    lines << QStringLiteral("version,time,frameId,url,loadMs,responseStartMs,domContentLoadedMs,loadEventMs,"
+                            "firstPaintMs,firstContentfulPaintMs,largestContentfulPaintMs,longTasks,longTaskMs,"
+                            "jsHeapUsedBytes,jsHeapTotalBytes,residentBytes,cpuPercent,sharedProcess,domPatchMs,blockedRequests");
+    auto num = [](double v) { return QString::number(v, 'f', 1); };
+    for (quint64 id : std::as_const(ids)) {
+      for (const PerfLogSample &s : perfLog_.value(id).ordered()) {
+        const FrameMetrics &m = s.metrics;
+        const QStringList fields = {
+          QStringLiteral(PHRAIMS_VERSION), iso(s.timestampMs), QString::number(id), csvField(s.url),
+          QString::number(m.loadMs), num(m.responseStartMs), num(m.domContentLoadedMs), num(m.loadEventMs),
+          num(m.firstPaintMs), num(m.firstContentfulPaintMs), num(m.largestContentfulPaintMs),
+          QString::number(m.longTasks), num(m.longTaskMs),
+          QString::number(m.jsHeapUsedBytes), QString::number(m.jsHeapTotalBytes), QString::number(m.residentBytes),
+          num(m.cpuPercent), m.sharedProcess ? QStringLiteral("1") : QStringLiteral("0"),
+          QString::number(m.domPatchMs, 'f', 2), QString::number(m.blockedRequests),
+        };
+        lines << fields.join(QLatin1Char(','));
+      }
+    }
+    data = lines.join(QLatin1Char('\n')).toUtf8() + '\n';
+  }
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+    if (error) *error = file.errorString();
+    qWarning() << "FrameMetricsSampler::exportLog: cannot write" << path << file.errorString();
+    return false;
+  }
+  qDebug() << "FrameMetricsSampler::exportLog: wrote" << logSampleCount() << "sample(s) of" << ids.size()
+           << "frame(s) to" << path;
+  return true;
+}
+
+void FrameMetricsSampler::updateHud(SplitFrameWidget *frame) {
+  if (!enabled_) return;
+  frame->setPerfHudText(formatMetrics(metrics_.value(frame)));
+}
+
+QString FrameMetricsSampler::formatMetrics(const FrameMetrics &m) {
+  QStringList parts;
+  if (m.pid > 0) {
+    parts << QStringLiteral("PID %1%2").arg(m.pid).arg(m.sharedProcess ? QStringLiteral(" (shared)") : QString());
+    parts << formatBytes(m.residentBytes);
+    parts << (m.cpuPercent >= 0 ? QStringLiteral("%1% CPU").arg(m.cpuPercent, 0, 'f', 1) : QStringLiteral("?% CPU"));
+  } else {
+    parts << QStringLiteral("no renderer");
+  }
+  if (m.loadMs >= 0) {
+    QString load = QStringLiteral("load %1 ms").arg(m.loadMs);
+    if (m.responseStartMs >= 0 && m.loadEventMs > 0) {
+      load += QStringLiteral(" (TTFB %1, DCL %2, onload %3)")
+                .arg(qRound(m.responseStartMs)).arg(qRound(m.domContentLoadedMs)).arg(qRound(m.loadEventMs));
+    }
+    parts << load;
+  }
+  if (m.firstContentfulPaintMs >= 0) parts << QStringLiteral("FCP %1 ms").arg(qRound(m.firstContentfulPaintMs));
+  if (m.longTasks > 0) parts << QStringLiteral("%1 long task(s)").arg(m.longTasks);
+  if (m.jsHeapUsedBytes >= 0) parts << QStringLiteral("heap %1").arg(formatBytes(m.jsHeapUsedBytes));
+  if (m.domPatchMs >= 0) parts << QStringLiteral("patches %1 ms").arg(m.domPatchMs, 0, 'f', 2);
+  if (m.blockedRequests > 0) parts << QStringLiteral("blocked %1").arg(m.blockedRequests);
+  return parts.join(QStringLiteral(" · "));
+}
+
+bool FrameMetricsSampler::readProcessStats(qint64 pid, qint64 *residentBytes, qint64 *cpuNs) {
+#if defined(Q_OS_MACOS)
+  struct proc_taskinfo info;
+  if (proc_pidinfo(int(pid), PROC_PIDTASKINFO, 0, &info, sizeof(info)) != int(sizeof(info))) return false;
+  // CPU times are reported in Mach absolute time units
+  static mach_timebase_info_data_t timebase = [] {
+    mach_timebase_info_data_t tb;
+    mach_timebase_info(&tb);
+    return tb;
+  }();
+  *residentBytes = qint64(info.pti_resident_size);
+  *cpuNs = qint64((info.pti_total_user + info.pti_total_system) * timebase.numer / timebase.denom);
+  return true;
+#elif defined(Q_OS_WIN)
+  HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, DWORD(pid));
+  if (!process) return false;
+  PROCESS_MEMORY_COUNTERS counters;
+  FILETIME created, exited, kernel, user;
+  const bool ok = GetProcessMemoryInfo(process, &counters, sizeof(counters))
+                  && GetProcessTimes(process, &created, &exited, &kernel, &user);
+  CloseHandle(process);
+  if (!ok) return false;
+  auto ticks = [](const FILETIME &ft) { return (qint64(ft.dwHighDateTime) << 32) | ft.dwLowDateTime; };
+  *residentBytes = qint64(counters.WorkingSetSize);
+  *cpuNs = (ticks(kernel) + ticks(user)) * 100; // FILETIME ticks are 100 ns
+  return true;
+#elif defined(Q_OS_LINUX)
+  QFile statm(QStringLiteral("/proc/%1/statm").arg(pid));
+  QFile stat(QStringLiteral("/proc/%1/stat").arg(pid));
+  if (!statm.open(QIODevice::ReadOnly) || !stat.open(QIODevice::ReadOnly)) return false;
+  const QList<QByteArray> mem = statm.readAll().split(' ');
+  // The command name may contain spaces; fields are counted after its ')'.
+  const QByteArray line = stat.readAll();
+  const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+  if (mem.size() < 2 || fields.size() < 13) return false;
+  static const long pageSize = sysconf(_SC_PAGESIZE);
+  static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+  *residentBytes = mem[1].toLongLong() * pageSize;
+  // fields[0] is field 3 (state); utime/stime are fields 14/15
+  const qint64 ticks = fields[11].toLongLong() + fields[12].toLongLong();
+  *cpuNs = ticks * 1000000000LL / ticksPerSecond;
+  return true;
+#else
+  Q_UNUSED(pid);
+  Q_UNUSED(residentBytes);
+  Q_UNUSED(cpuNs);
+  return false;
+#endif
+}
+
+FramePerfSummaryDialog::FramePerfSummaryDialog(SplitWindow *window) : QDialog(window), window_(window) {
+  setWindowTitle(tr("Frame Performance"));
+  resize(760, 320);
+  auto *lay = new QVBoxLayout(this);
+  tree_ = new QTreeWidget(this);
+  tree_->setRootIsDecorated(false);
+  tree_->setHeaderLabels({tr("Frame"), tr("PID"), tr("Memory"), tr("CPU"), tr("Load"), tr("Patches"), tr("Blocked"), tr("URL")});
+  tree_->header()->setStretchLastSection(true);
+  lay->addWidget(tree_, 1);
+  auto *close = new QPushButton(tr("Close"), this);
+  connect(close, &QPushButton::clicked, this, &QDialog::accept);
+  lay->addWidget(close, 0, Qt::AlignRight);
+
+  connect(&FrameMetricsSampler::instance(), &FrameMetricsSampler::sampled, this, &FramePerfSummaryDialog::refresh);
+  FrameMetricsSampler::instance().addViewer();
+}
+
+FramePerfSummaryDialog::~FramePerfSummaryDialog() {
+  FrameMetricsSampler::instance().removeViewer();
+}
+
+void FramePerfSummaryDialog::refresh() {
+  if (!window_) return;
+  struct Row {
+    int number;
+    SplitFrameWidget *frame;
+    FrameMetrics m;
+  };
+  std::vector<Row> rows;
+  const std::vector<SplitFrameWidget *> &frames = window_->frameWidgets();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    rows.push_back(Row{int(i) + 1, frames[i], FrameMetricsSampler::instance().metricsFor(frames[i])});
+  }
+  std::stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) { return costlier(a.m, b.m); });
+
+  tree_->clear();
+  for (const Row &r : rows) {
+    auto *item = new QTreeWidgetItem(tree_);
+    item->setText(0, QString::number(r.number));
+    item->setText(1, r.m.pid > 0 ? QString::number(r.m.pid) + (r.m.sharedProcess ? QStringLiteral("*") : QString()) : QStringLiteral("-"));
+    item->setText(2, formatBytes(r.m.residentBytes));
+    item->setText(3, r.m.cpuPercent >= 0 ? QStringLiteral("%1%").arg(r.m.cpuPercent, 0, 'f', 1) : QStringLiteral("?"));
+    item->setText(4, r.m.loadMs >= 0 ? QStringLiteral("%1 ms").arg(r.m.loadMs) : QStringLiteral("-"));
+    item->setText(5, r.m.domPatchMs >= 0 ? QStringLiteral("%1 ms").arg(r.m.domPatchMs, 0, 'f', 2) : QStringLiteral("-"));
+    item->setText(6, r.m.blockedRequests >= 0 ? QString::number(r.m.blockedRequests) : QStringLiteral("-"));
+    item->setText(7, r.frame->address());
+    item->setToolTip(1, tr("* renderer process shared with other frames; memory and CPU are per process"));
+  }
+  for (int c = 0; c < tree_->columnCount() - 1; ++c) tree_->resizeColumnToContents(c);
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <QDialog>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <vector>
+
+class QTreeWidget;
+class QWebEngineProfile;
+class SplitFrameWidget;
+class SplitWindow;
+
+/**
+ * @brief Latest performance figures for one frame.
+ *
+ * Process figures describe the frame's renderer process, which Chromium may
+ * share between frames of the same site; sharedProcess is set in that case.
+ * Every value is -1 until it has been measured.
+ */
+struct FrameMetrics {
+  qint64 pid = 0;                 ///< QWebEnginePage::renderProcessPid(), 0 if none
+  qint64 residentBytes = -1;      ///< Resident memory of the renderer process
+  double cpuPercent = -1;         ///< Renderer CPU usage over the last sample interval (100 = one core)
+  bool sharedProcess = false;     ///< Another frame uses the same renderer process
+  qint64 loadMs = -1;             ///< loadStarted -> loadFinished wall time of the last load
+  double responseStartMs = -1;    ///< Navigation Timing: time to first byte
+  double domContentLoadedMs = -1; ///< Navigation Timing: DOMContentLoaded event end
+  double loadEventMs = -1;        ///< Navigation Timing: load event end
+  double firstPaintMs = -1;       ///< Paint Timing: first-paint
+  double firstContentfulPaintMs = -1; ///< Paint Timing: first-contentful-paint
+  double largestContentfulPaintMs = -1; ///< Latest largest-contentful-paint candidate when timings were read
+  int longTasks = -1;             ///< Long tasks (> 50 ms) since the document was created
+  double longTaskMs = -1;         ///< Total duration of those long tasks
+  qint64 jsHeapUsedBytes = -1;    ///< performance.memory.usedJSHeapSize
+  qint64 jsHeapTotalBytes = -1;   ///< performance.memory.totalJSHeapSize
+  double domPatchMs = -1;         ///< Time spent in the DOM patch runtime's last sync()
+  int blockedRequests = -1;       ///< ContentBlocker count for the page's site, -1 if blocking is off
+};
+
+/**
+ * @brief One entry of the performance log: a frame's metrics right after a load.
+ */
+struct PerfLogSample {
+  qint64 timestampMs = 0;  ///< Wall clock (ms since the epoch) when the timings were read
+  quint64 frameId = 0;     ///< SplitFrameWidget::frameId() of the frame
+  QString url;             ///< Page URL at that time
+  FrameMetrics metrics;    ///< Metrics snapshot, including the page timings just read
+};
+
+/**
+ * @brief Central sampler behind the per-frame performance HUD.
+ *
+ * Every SplitFrameWidget registers itself on construction. While the HUD is
+ * enabled (`perfHud/enabled`) or a summary dialog is open, one timer samples
+ * every renderer process once per interval (resident memory and CPU time,
+ * read from the OS) and attributes it to the frames it hosts. Load timings
+ * are taken from the frame's loadStarted/loadFinished signals; after each
+ * successful load a single script reads Navigation Timing and the DOM patch
+ * runtime's last apply time.
+ *
+ * Frames never poll on their own; the sampler pushes text into each frame's
+ * HUD strip and emits sampled() for summary views.
+ *
+ * Independently of the HUD, the timings read after every load are appended
+ * to a performance log (`perfLog/enabled`): a fixed-size ring buffer of
+ * `perfLog/samplesPerFrame` PerfLogSample entries per frame ID, kept after
+ * the frame closes. Paint timings, largest contentful paint, long tasks and
+ * JS heap size come from a small observer script installed on every profile
+ * (installPageScript()). exportLog() writes the log as CSV or JSON.
+ */
+class FrameMetricsSampler : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared sampler, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static FrameMetricsSampler &instance();
+
+  /**
+   * @brief Starts tracking a frame.
+   * @param frame The frame to measure; unregistered automatically on destruction
+   */
+  void registerFrame(SplitFrameWidget *frame);
+
+  /**
+   * @brief Returns whether the per-frame HUD is shown.
+   * @return Mirrors `perfHud/enabled`
+   */
+  bool isEnabled() const { return enabled_; }
+
+  /**
+   * @brief Shows or hides the HUD strip on every frame and persists the choice.
+   * @param enabled true to show the HUD and start sampling
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * @brief Registers an open summary view so sampling runs while it is visible.
+   *
+   * Pair with removeViewer(). Takes an immediate sample.
+   */
+  void addViewer();
+
+  /** @brief Unregisters a summary view added with addViewer(). */
+  void removeViewer();
+
+  /**
+   * @brief Returns the latest metrics for a frame.
+   * @param frame The frame to look up
+   * @return The metrics, or default (unmeasured) values for unknown frames
+   */
+  FrameMetrics metricsFor(SplitFrameWidget *frame) const;
+
+  /**
+   * @brief Formats a frame's metrics as a single HUD line.
+   * @param m The metrics to format
+   * @return Human-readable summary such as "PID 123 · 180 MB · 4% CPU · load 820 ms"
+   */
+  static QString formatMetrics(const FrameMetrics &m);
+
+  /**
+   * @brief Reads OS-level figures for a process.
+   * @param pid Process ID
+   * @param residentBytes Receives resident memory in bytes
+   * @param cpuNs Receives total user + system CPU time in nanoseconds
+   * @return false if the process could not be queried (or the platform is unsupported)
+   */
+  static bool readProcessStats(qint64 pid, qint64 *residentBytes, qint64 *cpuNs);
+
+  /**
+   * @brief Installs the paint / long-task observer script on a profile.
+   * @param profile Profile from getProfileByName() or createIncognitoProfile()
+   *
+   * The script runs at document creation in the ApplicationWorld and only
+   * records; collectPageTimings() reads it after each load.
+   */
+  static void installPageScript(QWebEngineProfile *profile);
+
+  /** @brief Returns whether loads are recorded in the performance log (`perfLog/enabled`). */
+  bool isLogEnabled() const { return logEnabled_; }
+
+  /** @brief Returns the number of samples currently held in the performance log. */
+  int logSampleCount() const;
+
+  /**
+   * @brief Writes the performance log to a file.
+   * @param path Destination; a `.json` suffix selects JSON, anything else CSV
+   * @param error Receives a description when writing fails (may be null)
+   * @return true on success
+   *
+   * Samples are written per frame ID in recording order. Both formats
+   * include the Phraims version so logs of different builds can be compared.
+   */
+  bool exportLog(const QString &path, QString *error = nullptr) const;
+
+signals:
+  /** @brief Emitted after every sample so summary views can refresh. */
+  void sampled();
+
+  /**
+   * @brief Emitted when the HUD is enabled or disabled (from any window).
+   * @param enabled The new state
+   */
+  void enabledChanged(bool enabled);
+
+private:
+  /** @brief CPU time bookkeeping for one renderer process. */
+  struct ProcessSample {
+    qint64 cpuNs = -1;    ///< Total user + system CPU time at the last sample
+    qint64 wallNs = -1;   ///< Sampler clock at the last sample
+  };
+
+  explicit FrameMetricsSampler(QObject *parent = nullptr);
+
+  /** @brief Starts or stops the timer depending on HUD state and open viewers. */
+  void updateTimer();
+
+  /** @brief Samples every renderer process and refreshes all HUDs. */
+  void sample();
+
+  /** @brief Reads Navigation Timing and DOM patch timing after a load. */
+  void collectPageTimings(SplitFrameWidget *frame);
+
+  /** @brief Pushes the frame's formatted metrics into its HUD strip. */
+  void updateHud(SplitFrameWidget *frame);
+
+  /** @brief Appends a frame's current metrics to its ring in the performance log. */
+  void logSample(SplitFrameWidget *frame, const FrameMetrics &m);
+
+  /** @brief Fixed-capacity ring of samples for one frame ID. */
+  struct PerfLogRing {
+    std::vector<PerfLogSample> samples; ///< Up to capacity entries
+    size_t next = 0;                    ///< Slot overwritten by the next push once full
+    qint64 lastMs = 0;                  ///< Timestamp of the newest sample (for dropping idle rings)
+
+    /** @brief Adds a sample, overwriting the oldest one when @p capacity is reached. */
+    void push(const PerfLogSample &sample, int capacity);
+
+    /** @brief Returns the samples oldest first. */
+    std::vector<PerfLogSample> ordered() const;
+  };
+
+  QHash<SplitFrameWidget *, FrameMetrics> metrics_;      ///< Latest metrics per registered frame
+  QHash<SplitFrameWidget *, QElapsedTimer> loadClocks_;  ///< Running since each frame's last loadStarted
+  QMap<qint64, ProcessSample> processes_;                ///< CPU bookkeeping per renderer PID
+  QElapsedTimer clock_;                                  ///< Monotonic clock for CPU percentages
+  QTimer timer_;                                         ///< Periodic sampling timer
+  bool enabled_ = false;                                 ///< Mirrors perfHud/enabled
+  bool logEnabled_ = true;                               ///< perfLog/enabled
+  int samplesPerFrame_ = 100;                            ///< perfLog/samplesPerFrame
+  QHash<quint64, PerfLogRing> perfLog_;                  ///< Performance log rings by frame ID
+  int viewers_ = 0;                                      ///< Open summary dialogs
+};
+
+/**
+ * @brief Modeless window-level summary of frame costs.
+ *
+ * Lists the frames of one SplitWindow sorted by cost (renderer CPU, then
+ * resident memory) and refreshes after every sample.
+ */
+class FramePerfSummaryDialog : public QDialog {
+  Q_OBJECT
+public:
+  /**
+   * @brief Constructs the summary for a window.
+   * @param window The window whose frames are listed (also the parent)
+   */
+  explicit FramePerfSummaryDialog(SplitWindow *window);
+  ~FramePerfSummaryDialog() override;
+
+private:
+  /** @brief Rebuilds the table from the sampler's latest metrics. */
+  void refresh();
+
+  QPointer<SplitWindow> window_;  ///< Window whose frames are summarized
+  QTreeWidget *tree_ = nullptr;   ///< One row per frame
+};
@@ -0,0 +1,218 @@
+#include "FramePool.h"
+#include "AppSettings.h"
+#include "RestoreScheduler.h"
+#include "SplitFrameWidget.h"
+#include "Trace.h"
+#include <QApplication>
+#include <QDebug>
+#include <QTimer>
+#include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <algorithm>
+
+namespace {
+  constexpr int DEFAULT_SPARES_PER_PROFILE = 1; // one ready frame covers the usual "add a frame" burst
+  constexpr int MAX_SPARES_PER_PROFILE = 4;     // each spare holds a page (and possibly a renderer)
+  constexpr int POOL_FILL_DELAY_MS = 1500;      // quiet period before building the next spare
+}
+
+FramePool &FramePool::instance() {
+  static FramePool *inst = new FramePool(qApp);
+  return *inst;
+}
+
+FramePool::FramePool(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  sparesPerProfile_ = std::clamp(s->value("framePool/sparesPerProfile", DEFAULT_SPARES_PER_PROFILE).toInt(),
+                                 0, MAX_SPARES_PER_PROFILE);
+  // opt-in: a speculative load is a credentialed GET for a link the user may never open
+  speculativeLoad_ = s->value("framePool/speculativeLoad", false).toBool();
+  qDebug() << "FramePool: sparesPerProfile=" << sparesPerProfile_ << "speculativeLoad=" << speculativeLoad_;
+  // spare pages must go before their profiles, which are children of qApp
+  connect(qApp, &QCoreApplication::aboutToQuit, this, &FramePool::clear);
+}
+
+SplitFrameWidget *FramePool::take(QWebEngineProfile *profile) {
+  if (!profile || sparesPerProfile_ <= 0) return nullptr;
+  prune(profile);
+  SplitFrameWidget *frame = nullptr;
+  auto it = spares_.find(profile);
+  if (it != spares_.end() && !it->empty()) {
+    frame = it->back();
+    it->pop_back();
+    pooled_.remove(frame);
+  }
+  prewarm(profile);
+  qDebug() << "FramePool::take:" << (frame ? "using spare" : "no spare ready") << frame;
+  return frame;
+}
+
+bool FramePool::recycle(SplitFrameWidget *frame) {
+  if (!frame || sparesPerProfile_ <= 0) return false;
+  QWebEnginePage *page = frame->page();
+  QWebEngineProfile *profile = page ? page->profile() : nullptr;
+  if (!profile || profile->isOffTheRecord()) return false;
+  if (RestoreScheduler::instance().isPending(frame)) return false;
+  prune(profile);
+  auto &list = spares_[profile];
+  if ((int)list.size() >= sparesPerProfile_) return false;
+  if (!frame->resetForReuse()) return false;
+
+  frame->hide();
+  frame->setParent(nullptr);
+  list.push_back(frame);
+  pooled_.insert(frame);
+  connect(frame, &QObject::destroyed, this, &FramePool::forget, Qt::UniqueConnection);
+  if (!warmProfiles_.contains(profile)) warmProfiles_.append(profile);
+  qDebug() << "FramePool::recycle: kept" << frame << "spares=" << list.size();
+  return true;
+}
+
+void FramePool::prewarm(QWebEngineProfile *profile) {
+  if (!profile || profile->isOffTheRecord() || sparesPerProfile_ <= 0) return;
+  if (!warmProfiles_.contains(profile)) warmProfiles_.append(profile);
+  scheduleFill();
+}
+
+void FramePool::releaseProfile(QWebEngineProfile *profile) {
+  if (!profile) return;
+  if (speculative_ && speculative_->page() && speculative_->page()->profile() == profile) {
+    pooled_.remove(speculative_);
+    delete speculative_.data();
+  }
+  warmProfiles_.removeIf([profile](const QPointer<QWebEngineProfile> &p) { return !p || p == profile; });
+  const auto it = spares_.find(profile);
+  if (it == spares_.end()) return;
+  const std::vector<QPointer<SplitFrameWidget>> frames = std::move(*it);
+  spares_.erase(it);
+  for (const QPointer<SplitFrameWidget> &frame : frames) {
+    if (!frame) continue;
+    pooled_.remove(frame);
+    delete frame.data();
+  }
+  qDebug() << "FramePool::releaseProfile: dropped" << frames.size() << "spare(s) for" << profile;
+}
+
+bool FramePool::contains(const SplitFrameWidget *frame) const {
+  return frame && pooled_.contains(frame);
+}
+
+void FramePool::speculate(QWebEngineProfile *profile, const QUrl &url) {
+  if (!speculativeLoad_ || !profile || !url.isValid()) return;
+  if (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")) return;
+  if (speculative_ && speculativeUrl_ == url && speculative_->page() && speculative_->page()->profile() == profile) return;
+  cancelSpeculation();
+
+  PHRAIMS_TRACE_SCOPE("FramePool::speculate");
+  SplitFrameWidget *frame = take(profile);
+  if (!frame) {
+    frame = new SplitFrameWidget(0);
+    frame->setProfile(profile);
+  }
+  // a prerendered page must stay silent until the user actually opens it
+  if (QWebEnginePage *page = frame->page()) page->setAudioMuted(true);
+  frame->setAddress(url.toString());
+  speculative_ = frame;
+  speculativeUrl_ = url;
+  pooled_.insert(frame);
+  connect(frame, &QObject::destroyed, this, &FramePool::forget, Qt::UniqueConnection);
+  qDebug() << "FramePool::speculate: loading" << url << "in" << frame;
+}
+
+SplitFrameWidget *FramePool::takeSpeculative(QWebEngineProfile *profile, const QUrl &url) {
+  if (!speculative_) return nullptr;
+  QWebEnginePage *page = speculative_->page();
+  if (speculativeUrl_ != url || !page || page->profile() != profile) {
+    cancelSpeculation();
+    return nullptr;
+  }
+  SplitFrameWidget *frame = speculative_;
+  speculative_ = nullptr;
+  speculativeUrl_ = QUrl();
+  pooled_.remove(frame);
+  page->setAudioMuted(false);
+  qDebug() << "FramePool::takeSpeculative: adopting" << frame << "url=" << page->url();
+  return frame;
+}
+
+void FramePool::cancelSpeculation() {
+  SplitFrameWidget *frame = speculative_;
+  speculative_ = nullptr;
+  speculativeUrl_ = QUrl();
+  if (!frame) return;
+  pooled_.remove(frame);
+  if (QWebEnginePage *page = frame->page()) page->setAudioMuted(false);
+  const bool kept = recycle(frame);
+  if (!kept) frame->deleteLater();
+  qDebug() << "FramePool::cancelSpeculation:" << (kept ? "recycled" : "deleted") << frame;
+}
+
+void FramePool::forget(QObject *frame) {
+  // destroyed() fires from ~QObject, so only the pointer value is used here
+  pooled_.remove(static_cast<SplitFrameWidget *>(frame));
+}
+
+void FramePool::scheduleFill() {
+  if (fillQueued_ || sparesPerProfile_ <= 0) return;
+  fillQueued_ = true;
+  QTimer::singleShot(POOL_FILL_DELAY_MS, this, [this]() {
+    fillQueued_ = false;
+    fillOne();
+  });
+}
+
+void FramePool::fillOne() {
+  // Building a page is exactly the work we want off the critical path; wait
+  // for the session restore and any ongoing mouse interaction to finish.
+  const RestoreScheduler &restore = RestoreScheduler::instance();
+  if (restore.isRestoring() || restore.isLoading() || QApplication::mouseButtons() != Qt::NoButton
+      || QApplication::activePopupWidget()) {
+    scheduleFill();
+    return;
+  }
+
+  warmProfiles_.removeIf([](const QPointer<QWebEngineProfile> &p) { return !p; });
+  for (const QPointer<QWebEngineProfile> &profile : std::as_const(warmProfiles_)) {
+    prune(profile);
+    auto &list = spares_[profile];
+    if ((int)list.size() >= sparesPerProfile_) continue;
+
+    PHRAIMS_TRACE_SCOPE("FramePool::fillOne");
+    auto *frame = new SplitFrameWidget(0);
+    frame->setProfile(profile);
+    frame->setAddress(QString()); // loads the instruction page, which starts the renderer
+    list.push_back(frame);
+    pooled_.insert(frame);
+    connect(frame, &QObject::destroyed, this, &FramePool::forget, Qt::UniqueConnection);
+    qDebug() << "FramePool::fillOne: built spare" << frame << "for" << profile << "spares=" << list.size();
+    // one spare per idle slot; come back for the rest
+    scheduleFill();
+    return;
+  }
+}
+
+void FramePool::prune(QWebEngineProfile *profile) {
+  auto it = spares_.find(profile);
+  if (it == spares_.end()) return;
+  auto &list = *it;
+  list.erase(std::remove_if(list.begin(), list.end(), [this](const QPointer<SplitFrameWidget> &frame) {
+    if (!frame) return true;
+    QWebEnginePage *page = frame->page();
+    if (page && page->lifecycleState() == QWebEnginePage::LifecycleState::Active) return false;
+    pooled_.remove(frame);
+    frame->deleteLater();
+    return true;
+  }), list.end());
+}
+
+void FramePool::clear() {
+  sparesPerProfile_ = 0; // no refills during shutdown
+  speculativeLoad_ = false;
+  delete speculative_.data();
+  for (auto &list : spares_) {
+    for (const QPointer<SplitFrameWidget> &frame : list) delete frame.data();
+  }
+  spares_.clear();
+  pooled_.clear();
+  warmProfiles_.clear();
+}
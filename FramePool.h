@@ -0,0 +1,132 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
+#include <vector>
+
+class QWebEngineProfile;
+class SplitFrameWidget;
+
+/**
+ * @brief Keeps pre-initialized spare frames so new frames appear instantly.
+ *
+ * Building a SplitFrameWidget creates a web view and page and starts a
+ * renderer process, which shows up as a blank delay every time the user adds
+ * a frame. The pool builds up to `framePool/sparesPerProfile` frames per
+ * profile while the app is idle: the frame already has its page attached
+ * (setProfile) and the instruction page loaded. SplitWindow::addSingleFrame()
+ * takes a spare instead of constructing a frame when one is available.
+ *
+ * Frames removed with the minus button are returned with recycle() when the
+ * pool for their profile has room; the frame keeps its page but is reset
+ * (SplitFrameWidget::resetForReuse()). Off-the-record profiles are never
+ * pooled since each Incognito window owns its profile.
+ *
+ * Spares are parentless hidden widgets. FrameHibernationManager skips them
+ * (contains()) so they are never frozen or discarded while waiting.
+ *
+ * The pool also backs speculative loads for "Open Link in New Frame": when a
+ * link context menu opens, speculate() takes a spare (or builds a frame) and
+ * loads the link in it, muted and hidden. takeSpeculative() hands that frame
+ * to the window when the user picks the action; otherwise cancelSpeculation()
+ * recycles or deletes it. At most one speculative frame exists at a time.
+ */
+class FramePool : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared pool, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static FramePool &instance();
+
+  /**
+   * @brief Takes a ready spare frame for @p profile.
+   * @param profile Profile the frame's page must belong to
+   * @return A hidden, parentless frame showing the instruction page, or nullptr if none is ready
+   *
+   * The caller owns the returned frame. A replacement is built once the app is idle.
+   */
+  SplitFrameWidget *take(QWebEngineProfile *profile);
+
+  /**
+   * @brief Offers a removed frame back to the pool.
+   * @param frame Frame that was removed from its window (signal connections to the window already dropped)
+   * @return true if the pool now owns the frame; false means the caller should delete it
+   */
+  bool recycle(SplitFrameWidget *frame);
+
+  /**
+   * @brief Schedules building spares for @p profile when the app is idle.
+   * @param profile Profile to warm; off-the-record profiles are ignored
+   */
+  void prewarm(QWebEngineProfile *profile);
+
+  /**
+   * @brief Deletes all spares belonging to a profile (e.g. before the profile is deleted).
+   * @param profile Profile whose spares should be dropped
+   */
+  void releaseProfile(QWebEngineProfile *profile);
+
+  /**
+   * @brief Returns whether @p frame is currently waiting in the pool.
+   * @param frame The frame to check
+   * @return true for spares that have not been taken yet
+   */
+  bool contains(const SplitFrameWidget *frame) const;
+
+  /**
+   * @brief Starts loading a link in a hidden frame in case it is opened in a new frame.
+   * @param profile Profile the new frame would use
+   * @param url Link under the context menu; only http(s) links are loaded
+   *
+   * Replaces any other speculation. A no-op when `framePool/speculativeLoad` is false.
+   */
+  void speculate(QWebEngineProfile *profile, const QUrl &url);
+
+  /**
+   * @brief Takes the speculative frame if it was started for @p url.
+   * @param profile Profile the new frame must use
+   * @param url Link being opened
+   * @return The hidden, parentless frame already loading @p url, or nullptr (any other speculation is cancelled)
+   *
+   * The caller owns the returned frame and must not call setAddress() on it.
+   */
+  SplitFrameWidget *takeSpeculative(QWebEngineProfile *profile, const QUrl &url);
+
+  /** @brief Drops the speculative frame, recycling it into the pool when possible. */
+  void cancelSpeculation();
+
+private slots:
+  /** @brief Forgets a pooled frame that was destroyed while waiting. */
+  void forget(QObject *frame);
+
+private:
+  explicit FramePool(QObject *parent = nullptr);
+
+  /** @brief Builds at most one spare, then reschedules itself while any profile is short. */
+  void fillOne();
+
+  /** @brief Starts the idle fill timer if it isn't already pending. */
+  void scheduleFill();
+
+  /** @brief Drops destroyed and no-longer-usable spares for a profile. */
+  void prune(QWebEngineProfile *profile);
+
+  /** @brief Deletes every spare (on quit, before profiles are destroyed). */
+  void clear();
+
+  QHash<QWebEngineProfile *, std::vector<QPointer<SplitFrameWidget>>> spares_; ///< Ready frames per profile
+  QSet<const SplitFrameWidget *> pooled_;          ///< Frames currently held by the pool
+  QList<QPointer<QWebEngineProfile>> warmProfiles_; ///< Profiles to keep topped up, in first-use order
+  int sparesPerProfile_ = 1;                       ///< `framePool/sparesPerProfile`; 0 disables the pool
+  bool fillQueued_ = false;                        ///< An idle fill is already scheduled
+  bool speculativeLoad_ = false;                   ///< `framePool/speculativeLoad` (opt-in)
+  QPointer<SplitFrameWidget> speculative_;         ///< Frame loading a context-menu link, if any
+  QUrl speculativeUrl_;                            ///< Link speculative_ was started for
+};
@@ -0,0 +1,55 @@
+#include "FrameRegistry.h"
+#include "SplitFrameWidget.h"
+#include <QDebug>
+#include <algorithm>
+
+FrameRegistry::FrameId FrameRegistry::nextId_ = 0;
+
+SplitFrameWidget *FrameRegistry::at(int index) const {
+  if (index < 0 || index >= (int)order_.size()) return nullptr;
+  return order_[index];
+}
+
+FrameRegistry::FrameId FrameRegistry::insert(int index, SplitFrameWidget *frame) {
+  if (!frame) return 0;
+  if (contains(frame)) {
+    qWarning() << "FrameRegistry::insert: frame already registered" << frame;
+    return idOf(frame);
+  }
+  index = std::clamp(index, 0, (int)order_.size());
+  order_.insert(order_.begin() + index, frame);
+  reindexFrom(index);
+  const FrameId id = ++nextId_;
+  ids_.insert(frame, id);
+  byId_.insert(id, frame);
+  frame->setFrameId(id);
+  return id;
+}
+
+bool FrameRegistry::remove(const SplitFrameWidget *frame) {
+  const int index = indexOf(frame);
+  if (index < 0) return false;
+  order_.erase(order_.begin() + index);
+  index_.remove(frame);
+  byId_.remove(ids_.take(frame));
+  reindexFrom(index);
+  return true;
+}
+
+void FrameRegistry::swap(int a, int b) {
+  if (a < 0 || b < 0 || a >= (int)order_.size() || b >= (int)order_.size() || a == b) return;
+  std::swap(order_[a], order_[b]);
+  index_.insert(order_[a], a);
+  index_.insert(order_[b], b);
+}
+
+void FrameRegistry::clear() {
+  order_.clear();
+  index_.clear();
+  ids_.clear();
+  byId_.clear();
+}
+
+void FrameRegistry::reindexFrom(int first) {
+  for (int i = std::max(0, first); i < (int)order_.size(); ++i) index_.insert(order_[i], i);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QHash>
+#include <QtGlobal>
+#include <vector>
+
+class SplitFrameWidget;
+
+/**
+ * @brief Logical frame order of one SplitWindow with O(1) lookups.
+ *
+ * Holds the window's frame widgets in logical order (parallel to
+ * SplitWindow::frames_) together with a widget -> index hash and a stable
+ * frame ID per widget. IDs are assigned on insert from a process-wide
+ * counter, survive moves and layout changes, and are never reused, so other
+ * components (hibernation, HUD, IPC commands) can keep referring to a frame
+ * while its index changes.
+ *
+ * remove() only uses the pointer value, so it is safe from a
+ * QObject::destroyed handler.
+ */
+class FrameRegistry {
+public:
+  using FrameId = quint64; ///< Stable frame identifier; 0 means "no frame"
+
+  /** @brief Returns the frames in logical order. */
+  const std::vector<SplitFrameWidget *> &frames() const { return order_; }
+
+  /** @brief Returns the number of registered frames. */
+  int size() const { return (int)order_.size(); }
+
+  /** @brief Returns whether no frame is registered. */
+  bool isEmpty() const { return order_.empty(); }
+
+  /**
+   * @brief Returns the frame at a logical index.
+   * @param index Zero-based logical index
+   * @return The frame, or nullptr if @p index is out of range
+   */
+  SplitFrameWidget *at(int index) const;
+
+  /** @brief Returns the first frame in logical order, or nullptr. */
+  SplitFrameWidget *first() const { return order_.empty() ? nullptr : order_.front(); }
+
+  /** @brief Returns the last frame in logical order, or nullptr. */
+  SplitFrameWidget *last() const { return order_.empty() ? nullptr : order_.back(); }
+
+  /**
+   * @brief Returns a frame's logical index.
+   * @param frame The frame to look up
+   * @return Zero-based index, or -1 if @p frame is not registered
+   */
+  int indexOf(const SplitFrameWidget *frame) const { return index_.value(frame, -1); }
+
+  /** @brief Returns whether @p frame is registered. */
+  bool contains(const SplitFrameWidget *frame) const { return index_.contains(frame); }
+
+  /**
+   * @brief Returns a frame's stable ID.
+   * @param frame The frame to look up
+   * @return The ID, or 0 if @p frame is not registered
+   */
+  FrameId idOf(const SplitFrameWidget *frame) const { return ids_.value(frame, 0); }
+
+  /**
+   * @brief Looks a frame up by its stable ID.
+   * @param id ID previously returned by insert() or idOf()
+   * @return The frame, or nullptr if it has been removed
+   */
+  SplitFrameWidget *byId(FrameId id) const { return byId_.value(id, nullptr); }
+
+  /**
+   * @brief Registers a frame at a logical index and assigns its ID.
+   * @param index Position to insert at (clamped to [0, size()])
+   * @param frame The frame; must not be registered already
+   * @return The frame's new ID
+   */
+  FrameId insert(int index, SplitFrameWidget *frame);
+
+  /** @brief Registers a frame at the end; see insert(). */
+  FrameId append(SplitFrameWidget *frame) { return insert(size(), frame); }
+
+  /**
+   * @brief Unregisters a frame and shifts the following indices down.
+   * @param frame The frame (not dereferenced)
+   * @return true if @p frame was registered
+   */
+  bool remove(const SplitFrameWidget *frame);
+
+  /**
+   * @brief Exchanges the frames at two logical indices; their IDs move with them.
+   * @param a First index
+   * @param b Second index
+   */
+  void swap(int a, int b);
+
+  /** @brief Unregisters every frame. */
+  void clear();
+
+private:
+  /** @brief Rewrites index_ for order_[first..]. */
+  void reindexFrom(int first);
+
+  std::vector<SplitFrameWidget *> order_;           ///< Frames in logical order
+  QHash<const SplitFrameWidget *, int> index_;      ///< Frame -> logical index
+  QHash<const SplitFrameWidget *, FrameId> ids_;    ///< Frame -> stable ID
+  QHash<FrameId, SplitFrameWidget *> byId_;         ///< Stable ID -> frame
+  static FrameId nextId_;                           ///< Process-wide ID counter
+};
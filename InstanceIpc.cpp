@@ -0,0 +1,316 @@
+#include "InstanceIpc.h"
+#include "SplitWindow.h"
+#include "Trace.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QDebug>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <QtEndian>
+#include <memory>
+#include <utility>
+
+namespace {
+  constexpr char IPC_MAGIC[] = "PHR1";           // protocol version 1
+  constexpr int IPC_MAGIC_SIZE = 4;
+  constexpr int IPC_HEADER_SIZE = IPC_MAGIC_SIZE + 4; // magic + quint32 payload length
+  constexpr char IPC_LEGACY_ACTIVATE[] = "ACT";  // payload sent by builds before the framed protocol
+  constexpr int IPC_LEGACY_ACTIVATE_SIZE = 3;
+  constexpr quint32 IPC_MAX_PAYLOAD = 1024 * 1024;
+  constexpr int IPC_CONNECT_ATTEMPTS = 3;        // only retried while a server exists but is busy
+  constexpr int IPC_CONNECT_TIMEOUT_MS = 250;
+  constexpr int IPC_RETRY_DELAY_MS = 100;
+  constexpr int IPC_WRITE_TIMEOUT_MS = 500;
+  constexpr int IPC_BATCH_DELAY_MS = 100;        // collects launches started together (e.g. from a script)
+
+  // Qt options that take a separate value, so the value isn't mistaken for a URL.
+  const QStringList &qtValueOptions() {
+    static const QStringList options = {
+      QStringLiteral("-platform"), QStringLiteral("-platformpluginpath"), QStringLiteral("-platformtheme"),
+      QStringLiteral("-plugin"), QStringLiteral("-style"), QStringLiteral("-stylesheet"),
+      QStringLiteral("-session"), QStringLiteral("-display"), QStringLiteral("-geometry"),
+      QStringLiteral("-title"), QStringLiteral("-qwindowgeometry"), QStringLiteral("-qwindowtitle"),
+      QStringLiteral("-qwindowicon"),
+    };
+    return options;
+  }
+
+  bool decodePayload(const QByteArray &payload, InstanceCommand &command) {
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+      qWarning() << "InstanceIpc: malformed payload:" << error.errorString();
+      return false;
+    }
+    const QJsonObject o = doc.object();
+    command.command = o.value(QStringLiteral("cmd")).toString();
+    for (const QJsonValue &v : o.value(QStringLiteral("urls")).toArray()) command.urls << v.toString();
+    command.newWindow = o.value(QStringLiteral("target")).toString() != QLatin1String("frame");
+    command.layout = o.value(QStringLiteral("layout")).toString();
+    command.profile = o.value(QStringLiteral("profile")).toString();
+    command.scaleAll = o.value(QStringLiteral("scaleAll")).toDouble();
+    command.reloadAll = o.value(QStringLiteral("reloadAll")).toBool();
+    return true;
+  }
+}
+
+QByteArray InstanceCommand::encode() const {
+  QJsonObject o;
+  o[QStringLiteral("cmd")] = command;
+  if (!urls.isEmpty()) o[QStringLiteral("urls")] = QJsonArray::fromStringList(urls);
+  o[QStringLiteral("target")] = newWindow ? QStringLiteral("window") : QStringLiteral("frame");
+  if (!layout.isEmpty()) o[QStringLiteral("layout")] = layout;
+  if (!profile.isEmpty()) o[QStringLiteral("profile")] = profile;
+  if (scaleAll > 0) o[QStringLiteral("scaleAll")] = scaleAll;
+  if (reloadAll) o[QStringLiteral("reloadAll")] = true;
+  const QByteArray payload = QJsonDocument(o).toJson(QJsonDocument::Compact);
+
+  QByteArray frame;
+  frame.reserve(IPC_HEADER_SIZE + payload.size());
+  frame.append(IPC_MAGIC, IPC_MAGIC_SIZE);
+  char length[4];
+  qToBigEndian<quint32>(quint32(payload.size()), length);
+  frame.append(length, 4);
+  frame.append(payload);
+  return frame;
+}
+
+InstanceCommand InstanceCommand::fromArguments(const QStringList &args) {
+  InstanceCommand c;
+  bool open = false;
+  for (int i = 0; i < args.size(); ++i) {
+    const QString &arg = args.at(i);
+    if (arg == QLatin1String("--new-frame")) {
+      c.newWindow = false;
+      open = true;
+    } else if (arg.startsWith(QLatin1String("--layout="))) {
+      c.layout = arg.mid(9).trimmed().toLower();
+      open = true;
+    } else if (arg.startsWith(QLatin1String("--profile="))) {
+      c.profile = arg.mid(10).trimmed();
+      open = true;
+    } else if (arg.startsWith(QLatin1String("--scale-all="))) {
+      bool ok = false;
+      const double scale = arg.mid(12).trimmed().toDouble(&ok);
+      if (ok && scale > 0) {
+        c.scaleAll = scale;
+        open = true;
+      } else {
+        qWarning() << "InstanceCommand::fromArguments: ignoring invalid scale" << arg;
+      }
+    } else if (arg == QLatin1String("--reload-all")) {
+      c.reloadAll = true;
+      open = true;
+    } else if (arg.startsWith(QLatin1Char('-'))) {
+      // Qt/platform switches (e.g. -platform xcb, macOS -psn_*) are not ours
+      if (qtValueOptions().contains(arg)) ++i;
+    } else {
+      // resolve relative paths here; the primary has a different working directory
+      const QUrl url = QUrl::fromUserInput(arg, QDir::currentPath(), QUrl::AssumeLocalFile);
+      if (url.isValid()) {
+        c.urls << url.toString();
+        open = true;
+      } else {
+        qWarning() << "InstanceCommand::fromArguments: ignoring invalid URL" << arg;
+      }
+    }
+  }
+  if (open) c.command = QStringLiteral("open");
+  // bulk options without URLs act on the running window, not a new one
+  if (c.urls.isEmpty() && (c.scaleAll > 0 || c.reloadAll)) c.newWindow = false;
+  return c;
+}
+
+bool takeInstanceCommands(QByteArray &buffer, QList<InstanceCommand> &commands) {
+  const QByteArray magic = QByteArray::fromRawData(IPC_MAGIC, IPC_MAGIC_SIZE);
+  const QByteArray legacy = QByteArray::fromRawData(IPC_LEGACY_ACTIVATE, IPC_LEGACY_ACTIVATE_SIZE);
+  while (!buffer.isEmpty()) {
+    if (buffer.startsWith(legacy)) {
+      commands.append(InstanceCommand());
+      buffer.remove(0, IPC_LEGACY_ACTIVATE_SIZE);
+      continue;
+    }
+    if (buffer.size() < IPC_HEADER_SIZE) {
+      // wait for the rest of the header unless it already can't be ours
+      const QByteArray head = buffer.left(IPC_MAGIC_SIZE);
+      return magic.startsWith(head) || legacy.startsWith(head);
+    }
+    if (!buffer.startsWith(magic)) {
+      qWarning() << "takeInstanceCommands: unknown frame header" << buffer.left(IPC_MAGIC_SIZE);
+      return false;
+    }
+    const quint32 length = qFromBigEndian<quint32>(buffer.constData() + IPC_MAGIC_SIZE);
+    if (length > IPC_MAX_PAYLOAD) {
+      qWarning() << "takeInstanceCommands: payload too large:" << length;
+      return false;
+    }
+    if (buffer.size() < IPC_HEADER_SIZE + qsizetype(length)) return true;
+
+    InstanceCommand command;
+    const bool ok = decodePayload(buffer.mid(IPC_HEADER_SIZE, length), command);
+    buffer.remove(0, IPC_HEADER_SIZE + length);
+    if (!ok) return false;
+    if (command.command != QLatin1String("activate") && command.command != QLatin1String("open")) {
+      // newer senders may know more commands; skip rather than drop the connection
+      qWarning() << "takeInstanceCommands: ignoring unknown command" << command.command;
+      continue;
+    }
+    commands.append(command);
+  }
+  return true;
+}
+
+QString instanceServerName() {
+  return QStringLiteral("LookAtWhatAiCanDo_Phraims_server");
+}
+
+bool sendToRunningInstance(const InstanceCommand &command) {
+  QLocalSocket socket;
+  for (int attempt = 0; attempt < IPC_CONNECT_ATTEMPTS; ++attempt) {
+    PHRAIMS_TRACE_SCOPE("sendToRunningInstance: attempt");
+    socket.connectToServer(instanceServerName());
+    if (socket.waitForConnected(IPC_CONNECT_TIMEOUT_MS)) break;
+    const QLocalSocket::LocalSocketError error = socket.error();
+    if (error == QLocalSocket::ServerNotFoundError || error == QLocalSocket::ConnectionRefusedError) {
+      // no socket, or a stale one left by a crashed instance: we are the primary
+      qDebug() << "sendToRunningInstance: no running instance:" << socket.errorString();
+      return false;
+    }
+    qDebug() << "sendToRunningInstance: server busy, retrying:" << socket.errorString();
+    socket.abort();
+    QThread::msleep(IPC_RETRY_DELAY_MS);
+  }
+  if (socket.state() != QLocalSocket::ConnectedState) return false;
+
+  socket.write(command.encode());
+  socket.flush();
+  socket.waitForBytesWritten(IPC_WRITE_TIMEOUT_MS);
+  socket.disconnectFromServer();
+  qDebug() << "sendToRunningInstance: forwarded" << command.command << command.urls.size() << "URL(s)";
+  return true;
+}
+
+InstanceServer &InstanceServer::instance() {
+  static InstanceServer *inst = new InstanceServer(qApp);
+  return *inst;
+}
+
+InstanceServer::InstanceServer(QObject *parent) : QObject(parent), server_(new QLocalServer(this)) {
+  connect(server_, &QLocalServer::newConnection, this, &InstanceServer::onNewConnection);
+}
+
+bool InstanceServer::listen() {
+  if (server_->isListening()) return true;
+  // Remove any stale server socket before listening
+  QLocalServer::removeServer(instanceServerName());
+  if (!server_->listen(instanceServerName())) {
+    qWarning() << "Failed to listen on local server:" << server_->errorString();
+    return false;
+  }
+  return true;
+}
+
+void InstanceServer::submit(const InstanceCommand &command) {
+  pending_.append(command);
+  if (flushQueued_) return;
+  flushQueued_ = true;
+  QTimer::singleShot(IPC_BATCH_DELAY_MS, this, &InstanceServer::flush);
+}
+
+void InstanceServer::onNewConnection() {
+  while (QLocalSocket *client = server_->nextPendingConnection()) {
+    connect(client, &QLocalSocket::disconnected, client, &QLocalSocket::deleteLater);
+    auto buffer = std::make_shared<QByteArray>();
+    connect(client, &QLocalSocket::readyRead, this, [this, client, buffer]() {
+      buffer->append(client->readAll());
+      QList<InstanceCommand> commands;
+      const bool ok = takeInstanceCommands(*buffer, commands);
+      for (const InstanceCommand &command : std::as_const(commands)) submit(command);
+      if (!ok) {
+        qWarning() << "InstanceServer: dropping client after a protocol error";
+        client->abort();
+        client->deleteLater();
+      }
+    });
+  }
+}
+
+void InstanceServer::flush() {
+  flushQueued_ = false;
+  const QList<InstanceCommand> commands = std::exchange(pending_, {});
+  if (commands.isEmpty()) return;
+  PHRAIMS_TRACE_SCOPE("InstanceServer::flush");
+
+  // Frame requests all go to the window that was active when the batch
+  // started, merged so that window lays out once.
+  SplitWindow *frameTarget = bestWindow();
+  QStringList frameUrls;
+  QString frameLayout;
+  QString frameProfile;
+  double frameScale = 0.0;
+  bool frameReload = false;
+  bool haveFrameBatch = false;
+  SplitWindow *toRaise = nullptr;
+
+  for (const InstanceCommand &command : commands) {
+    if (command.isActivateOnly()) {
+      if (!toRaise) toRaise = frameTarget;
+      continue;
+    }
+    if (command.newWindow || !frameTarget) {
+      SplitWindow *w = createAndShowWindow();
+      // queued behind the window's own initial reset to a single empty frame
+      QPointer<SplitWindow> guard(w);
+      QMetaObject::invokeMethod(w, [guard, command]() {
+        if (guard) applyToWindow(guard, command.urls, command.layout, command.profile, command.scaleAll, command.reloadAll);
+      }, Qt::QueuedConnection);
+      toRaise = w;
+      continue;
+    }
+    frameUrls << command.urls;
+    if (!command.layout.isEmpty()) frameLayout = command.layout;
+    if (!command.profile.isEmpty()) frameProfile = command.profile;
+    if (command.scaleAll > 0) frameScale = command.scaleAll;
+    frameReload = frameReload || command.reloadAll;
+    haveFrameBatch = true;
+    toRaise = frameTarget;
+  }
+
+  if (haveFrameBatch) applyToWindow(frameTarget, frameUrls, frameLayout, frameProfile, frameScale, frameReload);
+  qDebug() << "InstanceServer::flush: applied" << commands.size() << "command(s)";
+  if (toRaise) raiseWindow(toRaise);
+}
+
+SplitWindow *InstanceServer::bestWindow() {
+  SplitWindow *best = nullptr;
+  // prefer an already-active window, otherwise first available
+  for (SplitWindow *w : g_windows) {
+    if (!w) continue;
+    if (w->isActiveWindow()) return w;
+    if (!best) best = w;
+  }
+  return best;
+}
+
+void InstanceServer::applyToWindow(SplitWindow *window, const QStringList &urls, const QString &layout,
+                                   const QString &profile, double scaleAll, bool reloadAll) {
+  FrameBatch batch(window);
+  window->openFrames(urls, layout, profile);
+  if (scaleAll > 0) window->setAllFramesScale(scaleAll);
+  if (reloadAll) window->reloadAllFrames();
+}
+
+void InstanceServer::raiseWindow(SplitWindow *window) {
+  if (!window->isVisible()) window->show();
+  if (window->isMinimized()) window->showNormal();
+  window->raise();
+  window->activateWindow();
+}
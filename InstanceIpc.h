@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QLocalServer;
+class SplitWindow;
+
+/**
+ * @brief One request from a secondary process to the running (primary) instance.
+ *
+ * Built from the command line of a second launch, e.g.
+ * `Phraims --layout=grid https://a.example https://b.example`, and sent over
+ * the single-instance QLocalServer. The primary also runs its own command
+ * line through the same path once the session is restored.
+ */
+struct InstanceCommand {
+  QString command = QStringLiteral("activate"); ///< `activate` (raise a window) or `open`
+  QStringList urls;                             ///< Addresses to open, already resolved against the sender's working directory
+  bool newWindow = true;                        ///< Open in a new window (true) or as frames of the active window
+  QString layout;                               ///< `grid`, `scrollgrid`, `vertical`, `horizontal`, or empty to keep the layout
+  QString profile;                              ///< Profile name, or empty for the window's current profile
+  double scaleAll = 0.0;                        ///< Scale every frame of the target window to this factor; 0 leaves scales alone
+  bool reloadAll = false;                       ///< Reload every frame of the target window
+
+  /**
+   * @brief Returns whether the command only asks for a window to be raised.
+   * @return true for `activate`
+   */
+  bool isActivateOnly() const { return command == QLatin1String("activate"); }
+
+  /**
+   * @brief Serializes the command as one protocol frame.
+   * @return `PHR1` magic, big-endian quint32 payload length, compact UTF-8 JSON payload
+   */
+  QByteArray encode() const;
+
+  /**
+   * @brief Parses Phraims command-line arguments.
+   * @param args Arguments without the program name
+   * @return An `open` command when URLs or options are given; otherwise `activate`
+   *
+   * Recognized options: `--new-frame` (add to the active window instead of
+   * opening a new one), `--layout=<grid|scrollgrid|vertical|horizontal>`,
+   * `--profile=<name>`, `--scale-all=<factor>` and `--reload-all`. The last
+   * two apply to the window the URLs open in, or to the active window when
+   * there are no URLs. Other options are ignored so Qt's own switches pass
+   * through. Positional arguments are URLs or local file paths.
+   */
+  static InstanceCommand fromArguments(const QStringList &args);
+};
+
+/**
+ * @brief Removes every complete frame from the front of @p buffer.
+ * @param buffer Bytes received so far; consumed frames are removed, a trailing partial frame is kept
+ * @param commands Receives the decoded commands in order
+ * @return false on a malformed or oversized frame (the connection should be dropped)
+ *
+ * A buffer starting with the legacy `ACT` payload decodes as an `activate`
+ * command so older builds can still raise the running instance.
+ */
+bool takeInstanceCommands(QByteArray &buffer, QList<InstanceCommand> &commands);
+
+/**
+ * @brief Returns the QLocalServer name shared by all Phraims processes.
+ * @return `LookAtWhatAiCanDo_Phraims_server`
+ */
+QString instanceServerName();
+
+/**
+ * @brief Client side: delivers @p command to an already running instance.
+ * @param command The request to forward
+ * @return true if a primary instance accepted it (the caller should exit)
+ *
+ * Returns false immediately when no server exists (missing or stale
+ * socket), so a cold start is not delayed. Retries only while a server
+ * exists but is busy. Safe to call before QApplication is constructed.
+ */
+bool sendToRunningInstance(const InstanceCommand &command);
+
+/**
+ * @brief Primary side of the single-instance protocol.
+ *
+ * Listens on instanceServerName(), decodes frames and queues the commands.
+ * Queued commands are applied together after a short batching window:
+ * commands for new windows each get one window, and `--new-frame` URLs for
+ * the same target window are merged so each window does a single
+ * SplitWindow::openFrames() call (one layout pass, not one per URL).
+ * Bulk scale and reload options run in the same SplitWindow batch.
+ */
+class InstanceServer : public QObject {
+  Q_OBJECT
+public:
+  /**
+   * @brief Returns the shared server, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static InstanceServer &instance();
+
+  /**
+   * @brief Starts listening, replacing any stale socket.
+   * @return true if the server is listening
+   *
+   * Call right after QApplication is constructed so a second launch during
+   * session restore finds the server; commands received before the event
+   * loop starts are applied once it runs.
+   */
+  bool listen();
+
+  /**
+   * @brief Queues a command for the next batch.
+   * @param command The request to apply
+   */
+  void submit(const InstanceCommand &command);
+
+private slots:
+  /** @brief Accepts a pending client connection and starts reading its frames. */
+  void onNewConnection();
+
+  /** @brief Applies all queued commands. */
+  void flush();
+
+private:
+  explicit InstanceServer(QObject *parent = nullptr);
+
+  /** @brief Returns the active window, or the first open one. */
+  static SplitWindow *bestWindow();
+
+  /**
+   * @brief Opens URLs and applies bulk frame options to a window in one batch.
+   * @param window Target window
+   * @param urls Addresses for SplitWindow::openFrames()
+   * @param layout Layout key, or empty
+   * @param profile Profile name, or empty
+   * @param scaleAll Scale for every frame, or 0 to leave scales alone
+   * @param reloadAll Reload every frame afterwards
+   */
+  static void applyToWindow(SplitWindow *window, const QStringList &urls, const QString &layout,
+                            const QString &profile, double scaleAll, bool reloadAll);
+
+  /** @brief Shows, raises and activates @p window. */
+  static void raiseWindow(SplitWindow *window);
+
+  QLocalServer *server_ = nullptr;   ///< Single-instance server
+  QList<InstanceCommand> pending_;   ///< Commands waiting for the next flush
+  bool flushQueued_ = false;         ///< A batching timer is already running
+};
@@ -0,0 +1,172 @@
+#include "LocalScheme.h"
+#include "AppSettings.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QLocale>
+#include <QMimeDatabase>
+#include <QMultiMap>
+#include <QUrl>
+#include <QWebEngineProfile>
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineUrlScheme>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+  constexpr char SCHEME_NAME[] = "phraims-local";
+  constexpr char INDEX_FILE[] = "index.html";
+
+  /** @brief Returns the MIME type for @p path, with a UTF-8 charset for text types. */
+  QByteArray contentTypeFor(const QString &path) {
+    static const QMimeDatabase db;
+    const QMimeType mime = db.mimeTypeForFile(path, QMimeDatabase::MatchExtension);
+    QByteArray type = mime.name().toUtf8();
+    // dashboards are expected to be UTF-8; without a charset Chromium guesses
+    if (mime.inherits(QStringLiteral("text/plain")) || mime.name() == QLatin1String("application/json"))
+      type += "; charset=utf-8";
+    return type;
+  }
+
+  /** @brief Formats a timestamp as an HTTP date (RFC 9110 IMF-fixdate). */
+  QByteArray httpDate(const QDateTime &time) {
+    return QLocale::c().toString(time.toUTC(), QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1();
+  }
+}
+
+MappedFileDevice::MappedFileDevice(const QString &path, QObject *parent) : QIODevice(parent), file_(path) {}
+
+MappedFileDevice::~MappedFileDevice() {
+  close();
+}
+
+bool MappedFileDevice::open(OpenMode mode) {
+  if (mode & (QIODevice::WriteOnly | QIODevice::Append)) return false;
+  if (!file_.open(QIODevice::ReadOnly)) return false;
+  size_ = file_.size();
+  data_ = size_ > 0 ? file_.map(0, size_) : nullptr;
+  if (size_ > 0 && !data_) {
+    qWarning() << "MappedFileDevice: cannot map" << file_.fileName() << file_.errorString();
+    file_.close();
+    size_ = 0;
+    return false;
+  }
+  // no QIODevice buffer: reads copy from the mapping exactly once
+  return QIODevice::open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void MappedFileDevice::close() {
+  if (!isOpen() && !file_.isOpen()) return;
+  if (isOpen()) QIODevice::close();
+  if (data_) file_.unmap(const_cast<uchar *>(data_));
+  data_ = nullptr;
+  size_ = 0;
+  file_.close();
+}
+
+qint64 MappedFileDevice::readData(char *data, qint64 maxSize) {
+  const qint64 offset = pos();
+  if (offset >= size_) return -1; // end of file
+  const qint64 n = std::min(maxSize, size_ - offset);
+  std::memcpy(data, data_ + offset, size_t(n));
+  return n;
+}
+
+qint64 MappedFileDevice::writeData(const char *, qint64) {
+  return -1;
+}
+
+LocalSchemeHandler &LocalSchemeHandler::instance() {
+  static LocalSchemeHandler *inst = new LocalSchemeHandler(qApp);
+  return *inst;
+}
+
+QByteArray LocalSchemeHandler::schemeName() {
+  return QByteArray(SCHEME_NAME);
+}
+
+void LocalSchemeHandler::registerScheme() {
+  QWebEngineUrlScheme scheme(schemeName());
+  scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+  // Secure: a secure context for fetch() and friends. Local: remote pages
+  // cannot reach these files. CORS/Fetch: pages of one root read its data.
+  scheme.setFlags(QWebEngineUrlScheme::SecureScheme | QWebEngineUrlScheme::LocalScheme
+                  | QWebEngineUrlScheme::CorsEnabled | QWebEngineUrlScheme::FetchApiAllowed);
+  QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+LocalSchemeHandler::LocalSchemeHandler(QObject *parent) : QWebEngineUrlSchemeHandler(parent) {
+  AppSettings s;
+  s->beginGroup(QStringLiteral("localScheme/roots"));
+  for (const QString &name : s->childKeys()) {
+    const QString dir = s->value(name).toString().trimmed();
+    const QString canonical = QFileInfo(dir).canonicalFilePath();
+    if (canonical.isEmpty() || !QFileInfo(canonical).isDir()) {
+      qWarning() << "LocalSchemeHandler: ignoring root" << name << "- not a directory:" << dir;
+      continue;
+    }
+    roots_.insert(name.toLower(), canonical);
+  }
+  s->endGroup();
+  qDebug() << "LocalSchemeHandler: roots=" << roots_;
+}
+
+void LocalSchemeHandler::attach(QWebEngineProfile *profile) {
+  if (!profile) return;
+  profile->installUrlSchemeHandler(schemeName(), this);
+}
+
+QString LocalSchemeHandler::resolve(const QUrl &url, bool *denied) const {
+  *denied = false;
+  const QString root = roots_.value(url.host().toLower());
+  if (root.isEmpty()) return QString();
+  const QString relative = QDir::cleanPath(QLatin1Char('/') + url.path(QUrl::FullyDecoded));
+  QFileInfo info(root + relative);
+  if (info.isDir()) info.setFile(QDir(info.filePath()).filePath(QLatin1String(INDEX_FILE)));
+  // canonical paths resolve `..` and symlinks before the containment check
+  const QString canonical = info.canonicalFilePath();
+  if (canonical.isEmpty() || !QFileInfo(canonical).isFile()) return QString();
+  if (!canonical.startsWith(root + QLatin1Char('/'))) {
+    *denied = true;
+    return QString();
+  }
+  return canonical;
+}
+
+void LocalSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job) {
+  const QByteArray method = job->requestMethod();
+  if (method != "GET" && method != "HEAD") {
+    job->fail(QWebEngineUrlRequestJob::RequestDenied);
+    return;
+  }
+  bool denied = false;
+  const QString path = resolve(job->requestUrl(), &denied);
+  if (path.isEmpty()) {
+    if (denied) qWarning() << "LocalSchemeHandler: refused path outside its root:" << job->requestUrl();
+    job->fail(denied ? QWebEngineUrlRequestJob::RequestDenied : QWebEngineUrlRequestJob::UrlNotFound);
+    return;
+  }
+
+  auto *device = new MappedFileDevice(path);
+  if (!device->open(QIODevice::ReadOnly)) {
+    delete device;
+    job->fail(QWebEngineUrlRequestJob::RequestFailed);
+    return;
+  }
+  // the device must outlive the job's reads
+  connect(job, &QObject::destroyed, device, &QObject::deleteLater);
+
+  const QFileInfo info(path);
+  const QDateTime modified = info.lastModified();
+  QMultiMap<QByteArray, QByteArray> headers;
+  headers.insert("ETag", '"' + QByteArray::number(info.size(), 16) + '-'
+                             + QByteArray::number(modified.toMSecsSinceEpoch(), 16) + '"');
+  headers.insert("Last-Modified", httpDate(modified));
+  // reports change on disk; revalidate instead of trusting a cached copy
+  headers.insert("Cache-Control", "no-cache");
+  headers.insert("Accept-Ranges", "bytes");
+  job->setAdditionalResponseHeaders(headers);
+  job->reply(contentTypeFor(path), device);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QIODevice>
+#include <QString>
+#include <QWebEngineUrlSchemeHandler>
+
+class QUrl;
+class QWebEngineProfile;
+
+/**
+ * @brief Read-only, random-access QIODevice over a memory-mapped file.
+ *
+ * open() maps the whole file and readData() copies straight out of the
+ * mapping, so serving a large file never reads it into a QByteArray. The
+ * device is unbuffered; QtWebEngine's loader is the only reader and seeks it
+ * to answer Range requests. Empty files are served without a mapping.
+ */
+class MappedFileDevice : public QIODevice {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Creates a device for a file; call open() to map it.
+   * @param path Absolute path of the file to serve
+   * @param parent Owning object
+   */
+  explicit MappedFileDevice(const QString &path, QObject *parent = nullptr);
+  ~MappedFileDevice() override;
+
+  /**
+   * @brief Opens and maps the file.
+   * @param mode Must be read-only; Unbuffered is added
+   * @return false when the file cannot be opened or mapped
+   */
+  bool open(OpenMode mode) override;
+
+  /** @brief Unmaps and closes the file. */
+  void close() override;
+
+  /** @brief Returns false; the mapping supports seek(). */
+  bool isSequential() const override { return false; }
+
+  /** @brief Returns the size of the file in bytes. */
+  qint64 size() const override { return size_; }
+
+protected:
+  qint64 readData(char *data, qint64 maxSize) override;
+  qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+  QFile file_;                  ///< Mapped file
+  const uchar *data_ = nullptr; ///< QFile::map() result, null for empty files
+  qint64 size_ = 0;             ///< Mapped length
+};
+
+/**
+ * @brief Serves whitelisted local directories as `phraims-local://<root>/<path>`.
+ *
+ * Each root is a name -> directory entry under `localScheme/roots` (read at
+ * startup). A URL's host picks the root and its path the file below it;
+ * directories serve their `index.html`, and paths that resolve (through
+ * `..` or symlinks) outside the root are refused. Every page of one root
+ * shares an origin, so a dashboard can fetch() its JSON/CSV data without the
+ * `file://` origin restrictions.
+ *
+ * Files are answered with a MappedFileDevice, so multi-hundred-MB datasets
+ * are paged in by the OS instead of copied into the browser process. Range
+ * requests are handled by QtWebEngine seeking the device; responses carry
+ * `ETag`, `Last-Modified` and `Cache-Control: no-cache` validators.
+ *
+ * The scheme is registered as local: remote pages cannot load its URLs,
+ * only addresses typed or restored into a frame (or pages of the scheme
+ * itself).
+ */
+class LocalSchemeHandler : public QWebEngineUrlSchemeHandler {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared handler, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static LocalSchemeHandler &instance();
+
+  /**
+   * @brief Registers the `phraims-local` scheme with QtWebEngine.
+   *
+   * Must run before the QApplication is constructed.
+   */
+  static void registerScheme();
+
+  /** @brief Returns the scheme name, `phraims-local`. */
+  static QByteArray schemeName();
+
+  /**
+   * @brief Installs the handler on a profile.
+   * @param profile Profile from getProfileByName() or createIncognitoProfile()
+   */
+  void attach(QWebEngineProfile *profile);
+
+  /** @brief Returns the configured roots (lower-case name -> canonical directory). */
+  const QHash<QString, QString> &roots() const { return roots_; }
+
+  /** @brief Answers one request from the mapped file it names. */
+  void requestStarted(QWebEngineUrlRequestJob *job) override;
+
+private:
+  explicit LocalSchemeHandler(QObject *parent = nullptr);
+
+  /**
+   * @brief Maps a request URL to a file inside its root.
+   * @param url Requested `phraims-local` URL
+   * @param denied Set to true when the path escapes the root
+   * @return Canonical file path, or an empty string when there is none
+   */
+  QString resolve(const QUrl &url, bool *denied) const;
+
+  QHash<QString, QString> roots_; ///< localScheme/roots, by lower-case name
+};
@@ -0,0 +1,208 @@
+#include "MemoryBudget.h"
+#include "AppSettings.h"
+#include "FrameHibernation.h"
+#include "FrameMetrics.h"
+#include "FramePool.h"
+#include "RestoreScheduler.h"
+#include "SplitFrameWidget.h"
+#include "SplitWindow.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QWebEnginePage>
+#include <algorithm>
+#include <vector>
+
+#if defined(Q_OS_MACOS)
+#include <dispatch/dispatch.h>
+#elif defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+  constexpr int BUDGET_TICK_MS = 10000;          // how often renderer memory is summed
+  constexpr int MAX_RENDERER_LIMIT = 256;
+  constexpr int DEFAULT_LOW_AVAILABLE_PERCENT = 10;
+
+  struct Candidate {
+    SplitFrameWidget *frame = nullptr;
+    qint64 pid = 0;
+    bool focused = false;  // the window's last focused frame; evicted last
+    qint64 idleMs = 0;
+  };
+
+#if defined(Q_OS_MACOS)
+  void onMemoryPressureEvent(void *context) {
+    auto *budget = static_cast<MemoryBudget *>(context);
+    QMetaObject::invokeMethod(budget, [budget]() { budget->relievePressure(); }, Qt::QueuedConnection);
+  }
+#endif
+}
+
+MemoryBudget &MemoryBudget::instance() {
+  static MemoryBudget *inst = new MemoryBudget(qApp);
+  return *inst;
+}
+
+MemoryBudget::MemoryBudget(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  budgetBytes_ = qint64(std::max(0, s->value("memory/budgetMB", 0).toInt())) * 1024 * 1024;
+  maxLiveRenderers_ = std::clamp(s->value("memory/maxLiveRenderers", 0).toInt(), 0, MAX_RENDERER_LIMIT);
+  evictOnPressure_ = s->value("memory/evictOnPressure", true).toBool();
+  lowAvailablePercent_ = std::clamp(s->value("memory/lowAvailablePercent", DEFAULT_LOW_AVAILABLE_PERCENT).toInt(), 0, 50);
+  qDebug() << "MemoryBudget: budgetMB=" << budgetBytes_ / (1024 * 1024) << "maxLiveRenderers=" << maxLiveRenderers_
+           << "evictOnPressure=" << evictOnPressure_ << "lowAvailablePercent=" << lowAvailablePercent_;
+
+  timer_.setInterval(BUDGET_TICK_MS);
+  connect(&timer_, &QTimer::timeout, this, &MemoryBudget::tick);
+}
+
+void MemoryBudget::start() {
+  if (timer_.isActive()) return;
+  if (budgetBytes_ == 0 && maxLiveRenderers_ == 0 && !evictOnPressure_) return;
+  if (evictOnPressure_) watchPressureEvents();
+  timer_.start();
+}
+
+void MemoryBudget::watchPressureEvents() {
+#if defined(Q_OS_MACOS)
+  if (pressureSource_) return;
+  dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                    DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                    dispatch_get_main_queue());
+  if (!source) return;
+  dispatch_set_context(source, this);
+  dispatch_source_set_event_handler_f(source, onMemoryPressureEvent);
+  dispatch_resume(source);
+  pressureSource_ = source;
+#elif defined(Q_OS_WIN)
+  if (pressureHandle_) return;
+  pressureHandle_ = CreateMemoryResourceNotification(LowMemoryResourceNotification);
+  if (!pressureHandle_) qWarning() << "MemoryBudget: CreateMemoryResourceNotification failed:" << GetLastError();
+#endif
+}
+
+bool MemoryBudget::isUnderPressure() const {
+#if defined(Q_OS_WIN)
+  BOOL low = FALSE;
+  return pressureHandle_ && QueryMemoryResourceNotification(pressureHandle_, &low) && low;
+#elif defined(Q_OS_LINUX)
+  if (lowAvailablePercent_ <= 0) return false;
+  QFile meminfo(QStringLiteral("/proc/meminfo"));
+  if (!meminfo.open(QIODevice::ReadOnly)) return false;
+  qint64 totalKb = -1;
+  qint64 availableKb = -1;
+  // "MemTotal:  16314156 kB" ... "MemAvailable:  8123456 kB"
+  while (!meminfo.atEnd() && (totalKb < 0 || availableKb < 0)) {
+    const QByteArray line = meminfo.readLine();
+    const QList<QByteArray> parts = line.simplified().split(' ');
+    if (parts.size() < 2) continue;
+    if (parts[0] == "MemTotal:") totalKb = parts[1].toLongLong();
+    else if (parts[0] == "MemAvailable:") availableKb = parts[1].toLongLong();
+  }
+  return totalKb > 0 && availableKb >= 0 && availableKb * 100 < totalKb * lowAvailablePercent_;
+#else
+  // macOS pushes pressure events through the dispatch source instead
+  return false;
+#endif
+}
+
+void MemoryBudget::tick() {
+  if (evictOnPressure_ && isUnderPressure()) {
+    relievePressure();
+    return;
+  }
+  if (budgetBytes_ > 0 || maxLiveRenderers_ > 0) enforce();
+}
+
+int MemoryBudget::enforce() {
+  return evict(0);
+}
+
+int MemoryBudget::relievePressure() {
+  if (!evictOnPressure_) return 0;
+  qWarning() << "MemoryBudget: system memory pressure; evicting background frames";
+  // half of the eligible frames per signal; repeated signals go further
+  return evict(-1);
+}
+
+bool MemoryBudget::isEvictable(SplitFrameWidget *frame) {
+  QWebEnginePage *page = frame ? frame->page() : nullptr;
+  if (!page || page->lifecycleState() == QWebEnginePage::LifecycleState::Discarded) return false;
+  if (frame->isContentVisible()) return false;
+  if (FrameHibernationManager::instance().isKeepAlive(frame)) return false;
+  if (FramePool::instance().contains(frame)) return false;
+  if (RestoreScheduler::instance().isPending(frame)) return false;
+  // Qt keeps pages with audible media or attached DevTools Active; honor that.
+  return page->recommendedState() != QWebEnginePage::LifecycleState::Active;
+}
+
+int MemoryBudget::evict(int pressureCount) {
+  // Renderer accounting over every live page, evictable or not.
+  QHash<qint64, int> liveFramesByPid;
+  std::vector<Candidate> candidates;
+  for (SplitWindow *w : g_windows) {
+    if (!w) continue;
+    for (SplitFrameWidget *frame : w->frameWidgets()) {
+      QWebEnginePage *page = frame ? frame->page() : nullptr;
+      if (!page || page->lifecycleState() == QWebEnginePage::LifecycleState::Discarded) continue;
+      const qint64 pid = page->renderProcessPid();
+      if (pid > 0) ++liveFramesByPid[pid];
+      if (isEvictable(frame)) {
+        candidates.push_back(Candidate{frame, pid, frame == w->lastFocusedFrame(), frame->msecsSinceInteraction()});
+      }
+    }
+  }
+
+  QHash<qint64, qint64> residentByPid;
+  qint64 totalBytes = 0;
+  if (budgetBytes_ > 0) {
+    for (auto it = liveFramesByPid.constBegin(); it != liveFramesByPid.constEnd(); ++it) {
+      qint64 resident = -1;
+      qint64 cpuNs = -1;
+      if (!FrameMetricsSampler::readProcessStats(it.key(), &resident, &cpuNs) || resident < 0) continue;
+      residentByPid.insert(it.key(), resident);
+      totalBytes += resident;
+    }
+  }
+  int renderers = int(liveFramesByPid.size());
+  auto overBudget = [&]() {
+    return (budgetBytes_ > 0 && totalBytes > budgetBytes_) || (maxLiveRenderers_ > 0 && renderers > maxLiveRenderers_);
+  };
+
+  if (pressureCount < 0) pressureCount = std::max(1, int(candidates.size()) / 2);
+  if (pressureCount == 0 && !overBudget()) return 0;
+
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+    if (a.focused != b.focused) return !a.focused;
+    return a.idleMs > b.idleMs;
+  });
+
+  const qint64 startBytes = totalBytes;
+  const int startRenderers = renderers;
+  int evicted = 0;
+  for (const Candidate &c : candidates) {
+    if (evicted >= pressureCount && !overBudget()) break;
+    if (!FrameHibernationManager::instance().discardHiddenFrame(c.frame)) continue;
+    ++evicted;
+    // a renderer (and its memory) only goes away with its last live page
+    if (c.pid > 0 && --liveFramesByPid[c.pid] == 0) {
+      totalBytes -= residentByPid.value(c.pid);
+      --renderers;
+    }
+    qDebug() << "MemoryBudget: discarded frame" << c.frame << "idleMs=" << c.idleMs;
+  }
+
+  if (evicted > 0 || overBudget()) {
+    qDebug() << "MemoryBudget: evicted" << evicted << "of" << candidates.size() << "candidate frame(s);"
+             << "renderers" << startRenderers << "->" << renderers
+             << "residentMB" << startBytes / (1024 * 1024) << "->" << totalBytes / (1024 * 1024)
+             << (overBudget() ? "(still over budget: remaining frames are visible or exempt)" : "");
+  }
+  return evicted;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+class SplitFrameWidget;
+
+/**
+ * @brief Process-wide cap on web content cost, enforced by discarding frames.
+ *
+ * FrameHibernationManager throttles frames one at a time by visibility and
+ * idle time; this adds a hard limit across every window in g_windows. Each
+ * tick the budget reads the resident memory of every live renderer process
+ * (FrameMetricsSampler::readProcessStats) and counts the renderers. When the
+ * total is above `memory/budgetMB`, or more than `memory/maxLiveRenderers`
+ * renderers are alive, hidden frames are moved to
+ * QWebEnginePage::LifecycleState::Discarded in least-recently-interacted
+ * order (SplitFrameWidget::msecsSinceInteraction()), with each window's last
+ * focused frame going last. Eviction stops as soon as the estimate is back
+ * under the limits.
+ *
+ * System memory pressure (macOS dispatch memory-pressure source, Windows
+ * low-memory resource notification, Linux MemAvailable below
+ * `memory/lowAvailablePercent`) evicts half of the eligible frames even when
+ * no budget is configured.
+ *
+ * Visible frames, keep-alive frames, pages Qt wants Active (audible media,
+ * DevTools), pool spares and frames waiting for session restore are never
+ * evicted. Discarded frames reload when shown, via FrameHibernationManager.
+ */
+class MemoryBudget : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared budget, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static MemoryBudget &instance();
+
+  /**
+   * @brief Starts periodic enforcement and the platform memory-pressure watcher.
+   *
+   * Called once from main() after the session restore is committed. A no-op
+   * when no budget is set and pressure eviction is disabled.
+   */
+  void start();
+
+  /**
+   * @brief Evicts hidden frames until the budget is met.
+   * @return Number of frames discarded
+   */
+  int enforce();
+
+  /**
+   * @brief Responds to a system memory-pressure signal.
+   * @return Number of frames discarded
+   */
+  int relievePressure();
+
+private:
+  explicit MemoryBudget(QObject *parent = nullptr);
+
+  /** @brief Periodic pass: polls pressure where the platform has no push signal, then enforces. */
+  void tick();
+
+  /** @brief Returns whether the system currently reports low memory (polling platforms). */
+  bool isUnderPressure() const;
+
+  /** @brief Installs the macOS memory-pressure dispatch source. */
+  void watchPressureEvents();
+
+  /**
+   * @brief Discards eligible frames, least recently used first.
+   * @param pressureCount Frames to evict regardless of the budget (0 = only while over budget)
+   * @return Number of frames discarded
+   */
+  int evict(int pressureCount);
+
+  /** @brief Returns whether a frame may be discarded right now. */
+  static bool isEvictable(SplitFrameWidget *frame);
+
+  QTimer timer_;                    ///< Drives periodic enforcement
+  qint64 budgetBytes_ = 0;          ///< memory/budgetMB in bytes; 0 = no memory cap
+  int maxLiveRenderers_ = 0;        ///< memory/maxLiveRenderers; 0 = no renderer cap
+  bool evictOnPressure_ = true;     ///< memory/evictOnPressure
+  int lowAvailablePercent_ = 10;    ///< memory/lowAvailablePercent (Linux)
+  void *pressureSource_ = nullptr;  ///< macOS dispatch_source_t, null elsewhere
+  void *pressureHandle_ = nullptr;  ///< Windows memory resource notification HANDLE, null elsewhere
+};
@@ -10,6 +10,9 @@
 #include <QUrlQuery>
 #include <QWebEngineView>
 #include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWebEngineScript>
+#include <QWebEngineScriptCollection>
 
 /**
  * @brief Custom QWebEngineView with enhanced context menu and window creation behavior.
@@ -50,6 +53,19 @@ signals:
    */
   void openLinkInNewFrameRequested(const QUrl &linkUrl);
 
+  /**
+   * @brief Emitted when the context menu opens over a link.
+   * @param linkUrl The link under the cursor
+   *
+   * Lets the owner start loading the link speculatively so "Open Link in
+   * New Frame" can adopt an already loaded page. Followed by either
+   * openLinkInNewFrameRequested() or linkSpeculationCancelled().
+   */
+  void linkSpeculationRequested(const QUrl &linkUrl);
+
+  /** @brief Emitted when a link context menu closes without "Open Link in New Frame". */
+  void linkSpeculationCancelled();
+
 protected:
   /**
    * @brief Shows a custom context menu with navigation, edit, translation, and inspect actions.
@@ -124,155 +140,16 @@ protected:
     QPointF docPos = QPointF(widgetPos.x(), widgetPos.y());
     qDebug() << "MyWebEngineView::contextMenuEvent: devicePixelRatio=" << dpr << " docPos=" << docPos;
 
-    // JavaScript: find a caret/range at (x,y) and expand to contiguous
-    // word characters (letters/digits/underscore). If found, select it.
-    // Return the selected text (or empty string).
-    QString js = QString::fromUtf8(R"JS(
-(function(x,y){
-  try{
-    // Prefer caretRangeFromPoint; fall back to caretPositionFromPoint for
-    // broader engine compatibility.
-    var r = null;
-    if (document.caretRangeFromPoint) {
-      r = document.caretRangeFromPoint(x,y);
-    } else if (document.caretPositionFromPoint) {
-      var p = document.caretPositionFromPoint(x,y);
-      if (p) {
-        r = document.createRange();
-        r.setStart(p.offsetNode, p.offset);
-        r.setEnd(p.offsetNode, p.offset);
-      }
-    }
-    if(!r) {
-      // As a last resort, try elementFromPoint and locate a nearby text node
-      var el = document.elementFromPoint(x,y);
-      if(!el) return ['',''];
-      // Prefer selecting a sensible ancestor element that contains text
-      // (e.g., <a>, <div>, <span>). Walk up from the element at the point
-      // and pick the first ancestor with non-empty text content and a
-      // bounding box that's not effectively the whole page. This avoids
-      // selecting the entire document while still selecting meaningful
-      // element text when right-clicking inside elements.
-      var pick = null;
-      var n = el;
-      while(n && n !== document.body){
-        try{
-          var t = (n.textContent || '').trim();
-          if(t.length > 0){
-            var br = n.getBoundingClientRect();
-            if(br.width > 0 && br.height > 0 && br.width < window.innerWidth * 0.9 && br.height < window.innerHeight * 0.9){
-              pick = n;
-              break;
-            }
-          }
-        }catch(e){ /* ignore */ }
-        n = n.parentElement;
-      }
-      if (pick) {
-        r = document.createRange();
-        r.selectNodeContents(pick);
-      } else {
-        var walker = document.createTreeWalker(el, NodeFilter.SHOW_TEXT, null, false);
-        var node = null;
-        while(walker.nextNode()){
-          node = walker.currentNode;
-          var rng = document.createRange();
-          rng.selectNodeContents(node);
-          var b = rng.getBoundingClientRect();
-          if(x >= b.left && x <= b.right && y >= b.top && y <= b.bottom){
-            r = document.createRange();
-            r.setStart(node, 0);
-            r.setEnd(node, 0);
-            break;
-          }
-        }
-        if(!r) return ['',''];
-      }
-    }
+    // The selection helper lives in the page's isolated ApplicationWorld
+    // (installContextMenuHelper() adds it to every document at creation), so
+    // a right-click only sends this short call. It selects a contiguous run
+    // of characters under the mouse and returns [selectionString, hrefString].
+    const QString pickCall = QStringLiteral("window.__phraimsContextMenu ? window.__phraimsContextMenu.pick(%1, %2) : null;")
+                               .arg(QString::number(docPos.x()), QString::number(docPos.y()));
 
-    var node = r.startContainer;
-    var offset = r.startOffset;
-
-    // If the caret landed inside a TEXT_NODE whose parent element contains
-    // only text (no element children), prefer selecting the full parent
-    // element's contents. This makes right-clicking inside inline spans
-    // (like the YouTube title span) select the whole span text instead of
-    // only a single word.
-    if (node.nodeType === Node.TEXT_NODE) {
-      var pElem = node.parentElement;
-      if (pElem && pElem.childElementCount === 0) {
-        try {
-          var rangeElem = document.createRange();
-          rangeElem.selectNodeContents(pElem);
-          var selElem = window.getSelection();
-          selElem.removeAllRanges();
-          selElem.addRange(rangeElem);
-          var hrefElem = (pElem.closest ? pElem.closest('a') : (function(n){ while(n){ if(n.tagName && n.tagName.toLowerCase()=='a') return n; n=n.parentElement;} return null; })(pElem));
-          var hrefVal = hrefElem && hrefElem.href ? hrefElem.href : '';
-          return [selElem.toString(), hrefVal];
-        } catch(e) { /* fall through to regular logic */ }
-      }
-    }
-    if(node.nodeType !== Node.TEXT_NODE){
-      // If the startContainer is an element that contains text, prefer
-      // selecting that element's full text (avoids partial selection).
-      if (node.nodeType === Node.ELEMENT_NODE){
-        var cand = node;
-        try{
-          var t2 = (cand.textContent || '').trim();
-          var br2 = cand.getBoundingClientRect();
-          if (t2.length > 0 && br2.width > 0 && br2.width < window.innerWidth * 0.9 && br2.height < window.innerHeight * 0.9){
-            var rangeElem = document.createRange();
-            rangeElem.selectNodeContents(cand);
-            var selElem = window.getSelection();
-            selElem.removeAllRanges();
-            selElem.addRange(rangeElem);
-            var hrefElem = (cand.closest ? cand.closest('a') : null);
-            var hrefVal = hrefElem && hrefElem.href ? hrefElem.href : '';
-            return [selElem.toString(), hrefVal];
-          }
-        }catch(e){ /* ignore and fall back */ }
-      }
-      // walk up to find a text node child
-      var found = null;
-      var walker2 = document.createTreeWalker(node, NodeFilter.SHOW_TEXT, null, false);
-      if(walker2.nextNode()) found = walker2.currentNode;
-      if(!found) return ['',''];
-      node = found;
-      offset = 0;
-    }
-
-    var text = node.textContent || '';
-    var start = Math.min(Math.max(0, offset), text.length);
-    var end = start;
-    // Unicode-aware regex: letters and numbers (includes CJK). 'u' flag
-    // enables \p{} property escapes supported in modern Chromium.
-    var re = /[\p{L}\p{N}_]/u;
-    while(start > 0 && re.test(text.charAt(start-1))) start--;
-    while(end < text.length && re.test(text.charAt(end))) end++;
-    var range2 = document.createRange();
-    range2.setStart(node, start);
-    range2.setEnd(node, end);
-    var sel = window.getSelection();
-    sel.removeAllRanges();
-    sel.addRange(range2);
-    // Also detect an enclosing link at the point so the host can enable
-    // or hide the "Copy Link Address" action.
-    var elAt = document.elementFromPoint(x,y);
-    var a = null;
-    if (elAt) {
-      a = elAt.closest ? elAt.closest('a') : (function(n){ while(n){ if(n.tagName && n.tagName.toLowerCase()=='a') return n; n=n.parentElement;} return null; })(elAt);
-    }
-    var href = (a && a.href) ? a.href : '';
-    return [sel.toString(), href];
-  }catch(e){ return ['','']; }
-})(%1, %2);
-)JS").arg(QString::number(docPos.x()), QString::number(docPos.y()));
-
-    // Run the JS and then show the menu so the selection is visible when the
+    // Show the menu once the selection is made so it is visible when the
     // user sees the context menu.
-    qDebug() << "MyWebEngineView::contextMenuEvent: executing JS to expand selection (truncated)";
-    page->runJavaScript(js, [this, page, menu, globalPos, widgetPos, inspect, translate, copyLink, openLinkInNewFrame](const QVariant &result){
+    auto showMenu = [this, page, menu, globalPos, widgetPos, inspect, translate, copyLink, openLinkInNewFrame](const QVariant &result){
       // Expecting an array: [selectionString, hrefString]
       QString selText;
       QString foundHref;
@@ -280,49 +157,27 @@ protected:
         auto list = result.toList();
         if (list.size() >= 1) selText = list.value(0).toString();
         if (list.size() >= 2) foundHref = list.value(1).toString();
-      } else {
-        // older fallback: single string
-        selText = result.toString();
       }
       qDebug() << "MyWebEngineView::contextMenuEvent: JS result selection='" << selText << "' href='" << foundHref << "'";
 
       // Hide the Copy Link and Open Link in New Frame actions if no href was found at the click point.
-      if (foundHref.isEmpty()) {
-        copyLink->setVisible(false);
-        openLinkInNewFrame->setVisible(false);
-      } else {
-        copyLink->setVisible(true);
-        openLinkInNewFrame->setVisible(true);
-      }
+      copyLink->setVisible(!foundHref.isEmpty());
+      openLinkInNewFrame->setVisible(!foundHref.isEmpty());
+      // start loading the link while the user is still reading the menu
+      // (FramePool ignores this unless framePool/speculativeLoad is on)
+      if (!foundHref.isEmpty()) emit linkSpeculationRequested(QUrl(foundHref));
 
       // To avoid the underlying page receiving mouse events while the
       // context menu is open (which can cause accidental navigation or
-      // refresh on some pages), create a temporary overlay that absorbs
-      // pointer events. Remove it after the menu is dismissed.
-      QString overlayCreate = QString::fromUtf8(R"JS((function(){
-        try{
-          if(window.__copilot_ctx_overlay) return '';
-          var d = document.createElement('div');
-          d.id = '__copilot_ctx_overlay';
-          d.style.position = 'fixed';
-          d.style.top = '0'; d.style.left = '0';
-          d.style.width = '100%'; d.style.height = '100%';
-          d.style.zIndex = 2147483647;
-          d.style.background = 'transparent';
-          d.style.pointerEvents = 'auto';
-          document.body.appendChild(d);
-        }catch(e){}
-        return '';
-      })();)JS");
-      QString overlayRemove = QString::fromUtf8(R"JS((function(){
-        try{ var d = document.getElementById('__copilot_ctx_overlay'); if(d && d.parentNode) d.parentNode.removeChild(d); }catch(e){}
-      })();)JS");
-
-      page->runJavaScript(overlayCreate, [this, page, menu, globalPos, widgetPos, inspect, translate, copyLink, openLinkInNewFrame, selText, foundHref, overlayRemove](const QVariant &){
-        qDebug() << "MyWebEngineView::contextMenuEvent: overlay injected";
+      // refresh on some pages), put up the helper's overlay that absorbs
+      // pointer events. It is removed after the menu is dismissed.
+      page->runJavaScript(QStringLiteral("window.__phraimsContextMenu && window.__phraimsContextMenu.overlay(true);"),
+                          QWebEngineScript::ApplicationWorld,
+                          [this, page, menu, globalPos, widgetPos, inspect, translate, copyLink, openLinkInNewFrame, selText, foundHref](const QVariant &){
         QAction *selected = menu->exec(globalPos);
         // remove overlay after menu dismissed
-        page->runJavaScript(overlayRemove, [this](const QVariant &){ qDebug() << "MyWebEngineView::contextMenuEvent: overlay removed"; });
+        page->runJavaScript(QStringLiteral("window.__phraimsContextMenu && window.__phraimsContextMenu.overlay(false);"),
+                            QWebEngineScript::ApplicationWorld);
         if (selected == inspect) {
           qDebug() << "MyWebEngineView::contextMenuEvent: inspect selected";
           emit devToolsRequested(this->page(), widgetPos);
@@ -352,8 +207,21 @@ protected:
         } else {
           qDebug() << "MyWebEngineView::contextMenuEvent: other action selected";
         }
+        if (selected != openLinkInNewFrame && !foundHref.isEmpty()) emit linkSpeculationCancelled();
         menu->deleteLater();
       });
+    };
+
+    qDebug() << "MyWebEngineView::contextMenuEvent: picking selection via helper";
+    page->runJavaScript(pickCall, QWebEngineScript::ApplicationWorld, [page, pickCall, showMenu](const QVariant &result) {
+      if (result.metaType() == QMetaType::fromType<QVariantList>()) {
+        showMenu(result);
+        return;
+      }
+      // The document predates the installed script (or the page replaced
+      // our global); define the helper in it once and retry.
+      qDebug() << "MyWebEngineView::contextMenuEvent: helper missing in document, injecting it";
+      page->runJavaScript(contextMenuHelperSource() + pickCall, QWebEngineScript::ApplicationWorld, showMenu);
     });
 
     // accept so the default menu doesn't show
@@ -384,7 +252,218 @@ protected:
     return this;
   }
 
+  /**
+   * @brief Installs the context-menu selection helper into a profile's scripts.
+   * @param profile Profile whose pages get the helper
+   *
+   * The helper runs at DocumentCreation in the isolated ApplicationWorld
+   * (the page's own scripts can't see or break it) and defines
+   * `__phraimsContextMenu.pick(x, y)` and `.overlay(on)`. Installed once per
+   * profile; call when a page is created for the profile.
+   */
+  static void installContextMenuHelper(QWebEngineProfile *profile) {
+    if (!profile) return;
+    QWebEngineScriptCollection *scripts = profile->scripts();
+    if (!scripts->find(QStringLiteral("phraims-context-menu")).isEmpty()) return;
+    QWebEngineScript script;
+    script.setName(QStringLiteral("phraims-context-menu"));
+    script.setSourceCode(contextMenuHelperSource());
+    script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+    script.setWorldId(QWebEngineScript::ApplicationWorld);
+    script.setRunsOnSubFrames(false);
+    scripts->insert(script);
+    qDebug() << "MyWebEngineView::installContextMenuHelper: installed on profile" << profile->storageName();
+  }
+
 private:
+  /**
+   * @brief Returns the JavaScript that defines `window.__phraimsContextMenu`.
+   * @return Idempotent helper source (does nothing if the helper already exists)
+   */
+  static QString contextMenuHelperSource() {
+    return QString::fromUtf8(R"JS(
+(function(){
+  if (window.__phraimsContextMenu) return;
+  // Upper bound on nodes the fallback text-node search visits, so
+  // right-click latency stays flat on very large documents.
+  var MAX_WALK_NODES = 400;
+  var WALK_BUDGET_EXHAUSTED = {};
+
+  function hrefAt(n){
+    var a = (n && n.closest) ? n.closest('a') : null;
+    return (a && a.href) ? a.href : '';
+  }
+
+  function contains(b, x, y){
+    return x >= b.left && x <= b.right && y >= b.top && y <= b.bottom;
+  }
+
+  // Boxes this large are page containers, not something the user pointed at.
+  function isPageSized(b){
+    return b.width >= window.innerWidth * 0.9 || b.height >= window.innerHeight * 0.9;
+  }
+
+  function selectContents(n){
+    var range = document.createRange();
+    range.selectNodeContents(n);
+    var sel = window.getSelection();
+    sel.removeAllRanges();
+    sel.addRange(range);
+    return [sel.toString(), hrefAt(n)];
+  }
+
+  // Finds the text node under (x,y) inside root. Subtrees whose box misses
+  // the point are skipped without visiting their children, and the search
+  // gives up after MAX_WALK_NODES nodes.
+  function textNodeAt(root, x, y){
+    var visited = 0;
+    var walker = document.createTreeWalker(root, NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+      acceptNode: function(n){
+        if (++visited > MAX_WALK_NODES) throw WALK_BUDGET_EXHAUSTED;
+        if (n.nodeType === Node.TEXT_NODE) return NodeFilter.FILTER_ACCEPT;
+        var b = n.getBoundingClientRect();
+        // display:contents and similar boxes have no size; look inside them
+        if (b.width === 0 && b.height === 0) return NodeFilter.FILTER_SKIP;
+        return contains(b, x, y) ? NodeFilter.FILTER_SKIP : NodeFilter.FILTER_REJECT;
+      }
+    });
+    try {
+      while (walker.nextNode()) {
+        var rng = document.createRange();
+        rng.selectNodeContents(walker.currentNode);
+        if (contains(rng.getBoundingClientRect(), x, y)) return walker.currentNode;
+      }
+    } catch(e) {
+      if (e !== WALK_BUDGET_EXHAUSTED) throw e;
+    }
+    return null;
+  }
+
+  function caretRangeAt(x, y){
+    // Prefer caretRangeFromPoint; fall back to caretPositionFromPoint for
+    // broader engine compatibility.
+    if (document.caretRangeFromPoint) return document.caretRangeFromPoint(x, y);
+    if (document.caretPositionFromPoint) {
+      var p = document.caretPositionFromPoint(x, y);
+      if (p) {
+        var r = document.createRange();
+        r.setStart(p.offsetNode, p.offset);
+        r.setEnd(p.offsetNode, p.offset);
+        return r;
+      }
+    }
+    return null;
+  }
+
+  // Selects the text under (x,y) and returns [selectedText, enclosingLinkHref].
+  function pick(x, y){
+    try{
+      var r = caretRangeAt(x, y);
+      if(!r) {
+        // As a last resort, try elementFromPoint and locate a nearby text node
+        var el = document.elementFromPoint(x,y);
+        if(!el) return ['',''];
+        // Prefer selecting a sensible ancestor element that contains text
+        // (e.g., <a>, <div>, <span>): the first ancestor that is not
+        // effectively the whole page. Boxes are checked before text so large
+        // containers never have their (expensive) textContent read, and the
+        // walk stops at the first page-sized ancestor.
+        var candidate = null;
+        for (var n = el; n && n !== document.body; n = n.parentElement) {
+          var br = n.getBoundingClientRect();
+          if (isPageSized(br)) break;
+          if (br.width > 0 && br.height > 0 && (n.textContent || '').trim().length > 0) {
+            candidate = n;
+            break;
+          }
+        }
+        if (candidate) return selectContents(candidate);
+        var hit = textNodeAt(el, x, y);
+        if (!hit) return ['',''];
+        r = document.createRange();
+        r.setStart(hit, 0);
+        r.setEnd(hit, 0);
+      }
+
+      var node = r.startContainer;
+      var offset = r.startOffset;
+
+      // If the caret landed inside a TEXT_NODE whose parent element contains
+      // only text (no element children), prefer selecting the full parent
+      // element's contents. This makes right-clicking inside inline spans
+      // (like the YouTube title span) select the whole span text instead of
+      // only a single word.
+      if (node.nodeType === Node.TEXT_NODE) {
+        var pElem = node.parentElement;
+        if (pElem && pElem.childElementCount === 0) {
+          try { return selectContents(pElem); } catch(e) { /* fall through to regular logic */ }
+        }
+      }
+      if(node.nodeType !== Node.TEXT_NODE){
+        // If the startContainer is an element that contains text, prefer
+        // selecting that element's full text (avoids partial selection).
+        if (node.nodeType === Node.ELEMENT_NODE){
+          try{
+            var br2 = node.getBoundingClientRect();
+            if (br2.width > 0 && !isPageSized(br2) && (node.textContent || '').trim().length > 0){
+              return selectContents(node);
+            }
+          }catch(e){ /* ignore and fall back */ }
+        }
+        // walk down to the first text node child
+        var walker2 = document.createTreeWalker(node, NodeFilter.SHOW_TEXT, null, false);
+        if(!walker2.nextNode()) return ['',''];
+        node = walker2.currentNode;
+        offset = 0;
+      }
+
+      var text = node.textContent || '';
+      var start = Math.min(Math.max(0, offset), text.length);
+      var end = start;
+      // Unicode-aware regex: letters and numbers (includes CJK). 'u' flag
+      // enables \p{} property escapes supported in modern Chromium.
+      var re = /[\p{L}\p{N}_]/u;
+      while(start > 0 && re.test(text.charAt(start-1))) start--;
+      while(end < text.length && re.test(text.charAt(end))) end++;
+      var range2 = document.createRange();
+      range2.setStart(node, start);
+      range2.setEnd(node, end);
+      var sel = window.getSelection();
+      sel.removeAllRanges();
+      sel.addRange(range2);
+      // Also detect an enclosing link at the point so the host can enable
+      // or hide the "Copy Link Address" action.
+      return [sel.toString(), hrefAt(document.elementFromPoint(x,y))];
+    }catch(e){ return ['','']; }
+  }
+
+  // While the menu is open, a transparent overlay absorbs pointer events so
+  // the page can't navigate or refresh from stray clicks.
+  function overlay(on){
+    try{
+      var d = document.getElementById('__phraims_ctx_overlay');
+      if (!on) {
+        if (d && d.parentNode) d.parentNode.removeChild(d);
+        return;
+      }
+      if (d || !document.body) return;
+      d = document.createElement('div');
+      d.id = '__phraims_ctx_overlay';
+      d.style.position = 'fixed';
+      d.style.top = '0'; d.style.left = '0';
+      d.style.width = '100%'; d.style.height = '100%';
+      d.style.zIndex = 2147483647;
+      d.style.background = 'transparent';
+      d.style.pointerEvents = 'auto';
+      document.body.appendChild(d);
+    }catch(e){}
+  }
+
+  window.__phraimsContextMenu = { pick: pick, overlay: overlay };
+})();
+)JS");
+  }
+
   /**
    * @brief Handles the translate action from the context menu.
    *
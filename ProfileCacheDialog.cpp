@@ -0,0 +1,100 @@
+#include "ProfileCacheDialog.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLocale>
+#include <QPointer>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QWebEngineProfile>
+
+namespace {
+  constexpr int MAX_CACHE_SIZE_MB = 2047;      // QWebEngineProfile takes an int byte count
+  constexpr int CLEAR_REMEASURE_DELAY_MS = 1000; // clearHttpCache() finishes asynchronously
+}
+
+ProfileCacheDialog::ProfileCacheDialog(const QString &profileName, QWidget *parent)
+    : QDialog(parent), profileName_(profileName) {
+  setWindowTitle(tr("Cache Settings - %1").arg(profileName));
+  resize(460, 0);
+  auto *lay = new QVBoxLayout(this);
+
+  auto *form = new QFormLayout();
+  maxSizeSpin_ = new QSpinBox(this);
+  maxSizeSpin_->setRange(0, MAX_CACHE_SIZE_MB);
+  maxSizeSpin_->setSuffix(tr(" MB"));
+  maxSizeSpin_->setSpecialValueText(tr("Automatic"));
+  form->addRow(tr("Maximum cache size:"), maxSizeSpin_);
+  memoryOnlyCheck_ = new QCheckBox(tr("Keep the cache in memory only (nothing written to disk)"), this);
+  form->addRow(QString(), memoryOnlyCheck_);
+  warmCheck_ = new QCheckBox(tr("Warm the cache on restore (load hidden frames in the background)"), this);
+  form->addRow(QString(), warmCheck_);
+  usageLabel_ = new QLabel(this);
+  auto *clearButton = new QPushButton(tr("Clear Cache"), this);
+  auto *usageRow = new QHBoxLayout();
+  usageRow->addWidget(usageLabel_, 1);
+  usageRow->addWidget(clearButton);
+  form->addRow(tr("Current usage:"), usageRow);
+  lay->addLayout(form);
+
+  auto *buttons = new QDialogButtonBox(QDialogButtonBox::Save | QDialogButtonBox::Cancel, this);
+  connect(buttons, &QDialogButtonBox::accepted, this, &ProfileCacheDialog::onSave);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  connect(clearButton, &QPushButton::clicked, this, &ProfileCacheDialog::onClearCache);
+  lay->addWidget(buttons);
+
+  const ProfileCachePolicy policy = profileCachePolicy(profileName_);
+  maxSizeSpin_->setValue(policy.maxSizeMB);
+  memoryOnlyCheck_->setChecked(policy.memoryOnly);
+  warmCheck_->setChecked(policy.warmOnRestore);
+  refreshUsage();
+}
+
+void ProfileCacheDialog::refreshUsage() {
+  QWebEngineProfile *profile = getProfileByName(profileName_);
+  if (profile->httpCacheType() == QWebEngineProfile::MemoryHttpCache) {
+    usageLabel_->setText(tr("In memory (not measured)"));
+    return;
+  }
+  usageLabel_->setText(tr("Measuring..."));
+  const QString path = profile->cachePath();
+  QPointer<ProfileCacheDialog> guard(this);
+  QThreadPool::globalInstance()->start([path, guard]() {
+    qint64 bytes = 0;
+    int files = 0;
+    QDirIterator it(path, QDir::Files | QDir::Hidden | QDir::NoSymLinks, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      bytes += it.nextFileInfo().size();
+      ++files;
+    }
+    // guard is only dereferenced back on the GUI thread
+    QMetaObject::invokeMethod(qApp, [guard, bytes, files]() {
+      if (!guard) return;
+      guard->usageLabel_->setText(tr("%1 in %n file(s)", nullptr, files).arg(QLocale().formattedDataSize(bytes)));
+    }, Qt::QueuedConnection);
+  });
+}
+
+void ProfileCacheDialog::onClearCache() {
+  getProfileByName(profileName_)->clearHttpCache();
+  usageLabel_->setText(tr("Clearing..."));
+  QTimer::singleShot(CLEAR_REMEASURE_DELAY_MS, this, &ProfileCacheDialog::refreshUsage);
+}
+
+void ProfileCacheDialog::onSave() {
+  ProfileCachePolicy policy;
+  policy.maxSizeMB = maxSizeSpin_->value();
+  policy.memoryOnly = memoryOnlyCheck_->isChecked();
+  policy.warmOnRestore = warmCheck_->isChecked();
+  setProfileCachePolicy(profileName_, policy);
+  accept();
+}
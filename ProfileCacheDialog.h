@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QDialog>
+#include <QString>
+
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+
+/**
+ * @brief Per-profile HTTP cache settings (Profiles -> Cache Settings).
+ *
+ * Edits the ProfileCachePolicy of one profile: cache size cap, memory-only
+ * cache, and warming hidden frames during session restore. Saving applies
+ * the cache type and size to the loaded profile right away. The dialog also
+ * shows how much disk the profile's cache uses (measured off the GUI thread)
+ * and can clear it.
+ */
+class ProfileCacheDialog : public QDialog {
+  Q_OBJECT
+public:
+  /**
+   * @brief Constructs the dialog for one profile.
+   * @param profileName Profile whose policy is edited
+   * @param parent Optional parent widget
+   */
+  explicit ProfileCacheDialog(const QString &profileName, QWidget *parent = nullptr);
+
+private slots:
+  /** @brief Stores the edited policy and closes the dialog. */
+  void onSave();
+
+  /** @brief Clears the profile's HTTP cache and measures it again. */
+  void onClearCache();
+
+private:
+  /** @brief Starts measuring the cache directory in the background. */
+  void refreshUsage();
+
+  QString profileName_;                  ///< Profile being edited
+  QSpinBox *maxSizeSpin_ = nullptr;      ///< httpCacheMaxMB (0 = automatic)
+  QCheckBox *memoryOnlyCheck_ = nullptr; ///< httpCacheMemoryOnly
+  QCheckBox *warmCheck_ = nullptr;       ///< warmCacheOnRestore
+  QLabel *usageLabel_ = nullptr;         ///< Current cache usage
+};
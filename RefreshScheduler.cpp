@@ -0,0 +1,146 @@
+#include "RefreshScheduler.h"
+#include "AppSettings.h"
+#include "FramePool.h"
+#include "RestoreScheduler.h"
+#include "SplitFrameWidget.h"
+#include <QApplication>
+#include <QDebug>
+#include <QRandomGenerator>
+#include <algorithm>
+
+namespace {
+  constexpr int REFRESH_TICK_MS = 1000;                // due-time resolution
+  constexpr int DEFAULT_MAX_CONCURRENT_RELOADS = 2;    // reloads running at once
+  constexpr int DEFAULT_JITTER_PERCENT = 10;           // +/- randomization of each period
+  constexpr int MAX_JITTER_PERCENT = 50;
+  constexpr int REFRESH_LOAD_TIMEOUT_MS = 30000;       // release a slot if a reload never finishes
+  constexpr qint64 INTERACTION_GRACE_MS = 30000;       // don't reload under a user who just touched the frame
+}
+
+RefreshScheduler &RefreshScheduler::instance() {
+  static RefreshScheduler *inst = new RefreshScheduler(qApp);
+  return *inst;
+}
+
+RefreshScheduler::RefreshScheduler(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  maxConcurrentReloads_ = std::max(1, s->value("refresh/maxConcurrentReloads", DEFAULT_MAX_CONCURRENT_RELOADS).toInt());
+  jitterPercent_ = std::clamp(s->value("refresh/jitterPercent", DEFAULT_JITTER_PERCENT).toInt(), 0, MAX_JITTER_PERCENT);
+  qDebug() << "RefreshScheduler: maxConcurrentReloads=" << maxConcurrentReloads_ << "jitterPercent=" << jitterPercent_;
+  clock_.start();
+  timer_.setInterval(REFRESH_TICK_MS);
+  connect(&timer_, &QTimer::timeout, this, &RefreshScheduler::tick);
+}
+
+void RefreshScheduler::setInterval(SplitFrameWidget *frame, int seconds) {
+  if (!frame) return;
+  if (seconds <= 0) {
+    forget(frame);
+    return;
+  }
+  const int intervalMs = seconds * 1000;
+  auto it = entries_.find(frame);
+  if (it != entries_.end() && it->intervalMs == intervalMs) return;
+
+  if (it == entries_.end()) {
+    it = entries_.insert(frame, Entry());
+    it->frame = frame;
+    connect(frame, &SplitFrameWidget::pageLoadFinished, this, &RefreshScheduler::onFrameLoadFinished, Qt::UniqueConnection);
+    // destroyed() fires from ~QObject, so only the pointer value is used here
+    connect(frame, &QObject::destroyed, this, [this](QObject *obj) {
+      drop(static_cast<SplitFrameWidget *>(obj));
+    });
+  }
+  it->intervalMs = intervalMs;
+  // Start at a random phase so frames sharing an interval don't line up.
+  it->dueAtMs = clock_.elapsed() + QRandomGenerator::global()->bounded(intervalMs) + 1;
+  qDebug() << "RefreshScheduler::setInterval:" << frame << "every" << seconds << "s, first reload in"
+           << (it->dueAtMs - clock_.elapsed()) << "ms";
+  if (!timer_.isActive()) timer_.start();
+}
+
+int RefreshScheduler::intervalFor(SplitFrameWidget *frame) const {
+  const auto it = entries_.constFind(frame);
+  return it == entries_.constEnd() ? 0 : it->intervalMs / 1000;
+}
+
+void RefreshScheduler::tick() {
+  const qint64 now = clock_.elapsed();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    Entry &entry = it.value();
+    if (!entry.frame || entry.queued || inFlight_.contains(it.key())) continue;
+    if (entry.dueAtMs > now) continue;
+    entry.queued = true;
+    queue_.push_back(it.key());
+  }
+
+  // Fill free slots in FIFO order; ineligible frames keep their place so
+  // they reload as soon as they are visible and idle again.
+  for (auto q = queue_.begin(); q != queue_.end() && (int)inFlight_.size() < maxConcurrentReloads_;) {
+    SplitFrameWidget *frame = *q;
+    auto it = entries_.find(frame);
+    if (it == entries_.end() || !it->frame) {
+      q = queue_.erase(q);
+      continue;
+    }
+    if (!isEligible(frame)) {
+      ++q;
+      continue;
+    }
+    q = queue_.erase(q);
+    it->queued = false;
+    inFlight_.insert(frame);
+    qDebug() << "RefreshScheduler: reloading" << frame->address() << "inFlight=" << inFlight_.size()
+             << "queued=" << queue_.size();
+    frame->reload();
+
+    QPointer<SplitFrameWidget> guard(frame);
+    QTimer::singleShot(REFRESH_LOAD_TIMEOUT_MS, this, [this, guard]() {
+      if (guard && inFlight_.contains(guard)) {
+        qDebug() << "RefreshScheduler: reload timed out, releasing slot for" << guard->address();
+        finishReload(guard);
+      }
+    });
+  }
+}
+
+bool RefreshScheduler::isEligible(SplitFrameWidget *frame) const {
+  if (!frame->isContentVisible()) return false;
+  if (frame->msecsSinceInteraction() < INTERACTION_GRACE_MS) return false;
+  if (frame->address().trimmed().isEmpty()) return false;
+  if (RestoreScheduler::instance().isPending(frame) || FramePool::instance().contains(frame)) return false;
+  return true;
+}
+
+qint64 RefreshScheduler::jittered(int intervalMs) const {
+  const int spread = intervalMs / 100 * jitterPercent_;
+  if (spread <= 0) return intervalMs;
+  return intervalMs - spread + QRandomGenerator::global()->bounded(2 * spread + 1);
+}
+
+void RefreshScheduler::onFrameLoadFinished(SplitFrameWidget *frame, bool ok) {
+  Q_UNUSED(ok);
+  finishReload(frame);
+}
+
+void RefreshScheduler::finishReload(SplitFrameWidget *frame) {
+  if (!inFlight_.remove(frame)) return;
+  auto it = entries_.find(frame);
+  if (it != entries_.end()) it->dueAtMs = clock_.elapsed() + jittered(it->intervalMs);
+  // a slot opened up; don't make the next due frame wait for the tick
+  QTimer::singleShot(0, this, &RefreshScheduler::tick);
+}
+
+void RefreshScheduler::forget(SplitFrameWidget *frame) {
+  if (!entries_.contains(frame)) return;
+  disconnect(frame, &SplitFrameWidget::pageLoadFinished, this, &RefreshScheduler::onFrameLoadFinished);
+  disconnect(frame, &QObject::destroyed, this, nullptr);
+  drop(frame);
+}
+
+void RefreshScheduler::drop(SplitFrameWidget *frame) {
+  if (entries_.remove(frame) == 0) return;
+  queue_.erase(std::remove(queue_.begin(), queue_.end(), frame), queue_.end());
+  inFlight_.remove(frame);
+  if (entries_.isEmpty()) timer_.stop();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <deque>
+
+class SplitFrameWidget;
+
+/**
+ * @brief Central scheduler for per-frame auto-refresh (dashboard frames).
+ *
+ * Each frame may have a refresh interval (FrameState::refreshSeconds, set from
+ * View -> Auto Refresh). Rather than one timer per frame, which makes every
+ * dashboard reload at the same moment, this scheduler owns a single tick
+ * timer and:
+ *
+ * - Starts each frame at a random phase within its interval and adds
+ *   `refresh/jitterPercent` of random jitter to every later period, so frames
+ *   with equal intervals drift apart instead of reloading together.
+ * - Lets at most `refresh/maxConcurrentReloads` SplitFrameWidget::reload()
+ *   calls run at once; due frames wait in FIFO order for a slot. A slot is
+ *   released on pageLoadFinished or after a fixed timeout.
+ * - Skips frames that are not visible (hidden or minimized windows, collapsed
+ *   panes), that the user interacted with recently, that have no address,
+ *   or that are still waiting for their session-restore load. A skipped
+ *   frame stays due and reloads once it becomes eligible.
+ *
+ * The tick timer only runs while at least one frame has an interval.
+ */
+class RefreshScheduler : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared scheduler, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static RefreshScheduler &instance();
+
+  /**
+   * @brief Sets or clears a frame's auto-refresh interval.
+   * @param frame The frame to refresh
+   * @param seconds Interval in seconds; 0 (or less) stops auto-refresh for the frame
+   *
+   * Setting the same interval again keeps the frame's current schedule.
+   */
+  void setInterval(SplitFrameWidget *frame, int seconds);
+
+  /**
+   * @brief Returns a frame's configured interval.
+   * @param frame The frame to look up
+   * @return Interval in seconds, or 0 if the frame is not auto-refreshed
+   */
+  int intervalFor(SplitFrameWidget *frame) const;
+
+private slots:
+  /** @brief Queues due frames and starts reloads while slots are free. */
+  void tick();
+
+  /** @brief Slot for SplitFrameWidget::pageLoadFinished; frees the frame's slot. */
+  void onFrameLoadFinished(SplitFrameWidget *frame, bool ok);
+
+private:
+  /** @brief Scheduling state for one auto-refreshed frame. */
+  struct Entry {
+    QPointer<SplitFrameWidget> frame; ///< Frame to reload (cleared on destruction)
+    int intervalMs = 0;               ///< Configured period
+    qint64 dueAtMs = 0;               ///< Clock time of the next reload
+    bool queued = false;              ///< Waiting in queue_ for a slot
+  };
+
+  explicit RefreshScheduler(QObject *parent = nullptr);
+
+  /** @brief Returns whether a due frame may be reloaded right now. */
+  bool isEligible(SplitFrameWidget *frame) const;
+
+  /** @brief Returns @p intervalMs randomized by +/- the configured jitter. */
+  qint64 jittered(int intervalMs) const;
+
+  /** @brief Releases a frame's reload slot and schedules its next period. */
+  void finishReload(SplitFrameWidget *frame);
+
+  /** @brief Stops auto-refreshing a live frame and disconnects from it. */
+  void forget(SplitFrameWidget *frame);
+
+  /** @brief Removes all bookkeeping for a frame; safe to call while it is being destroyed. */
+  void drop(SplitFrameWidget *frame);
+
+  QHash<SplitFrameWidget *, Entry> entries_; ///< Auto-refreshed frames
+  std::deque<SplitFrameWidget *> queue_;     ///< Due frames waiting for a slot, FIFO
+  QSet<SplitFrameWidget *> inFlight_;        ///< Frames currently reloading
+  QElapsedTimer clock_;                      ///< Monotonic time base for dueAtMs
+  QTimer timer_;                             ///< Shared tick; runs only while entries_ is non-empty
+  int maxConcurrentReloads_ = 2;             ///< `refresh/maxConcurrentReloads`
+  int jitterPercent_ = 10;                   ///< `refresh/jitterPercent`
+};
@@ -0,0 +1,249 @@
+#include "RestoreScheduler.h"
+#include "AppSettings.h"
+#include "EngineConfig.h"
+#include "FrameHibernation.h"
+#include "SessionStore.h"
+#include "SplitFrameWidget.h"
+#include "Trace.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+#include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWindow>
+#include <algorithm>
+
+namespace {
+  constexpr int DEFAULT_MAX_CONCURRENT_LOADS = 3; // pages loading at once during restore
+  constexpr int RESTORE_LOAD_TIMEOUT_MS = 15000;  // release a slot if a page never reports loadFinished
+}
+
+RestoreScheduler &RestoreScheduler::instance() {
+  static RestoreScheduler *inst = new RestoreScheduler(qApp);
+  return *inst;
+}
+
+RestoreScheduler::RestoreScheduler(QObject *parent) : QObject(parent) {}
+
+void RestoreScheduler::beginRestore(const QElapsedTimer &startupClock) {
+  AppSettings s;
+  maxConcurrentLoads_ = std::max(1, s->value("restore/maxConcurrentLoads", DEFAULT_MAX_CONCURRENT_LOADS).toInt());
+  deferHiddenFrames_ = s->value("restore/deferHiddenFrames", true).toBool();
+  lastActiveWindowId_ = SessionStore::instance().lastActiveWindowId();
+  startupClock_ = startupClock;
+  collecting_ = true;
+  qDebug() << "RestoreScheduler::beginRestore: maxConcurrentLoads=" << maxConcurrentLoads_
+           << "deferHiddenFrames=" << deferHiddenFrames_ << "lastActiveWindowId=" << lastActiveWindowId_;
+}
+
+void RestoreScheduler::commitRestore() {
+  if (!collecting_) return;
+  collecting_ = false;
+  active_ = true;
+  traceInstant("commitRestore");
+  qDebug() << "RestoreScheduler::commitRestore: queued" << totalQueued_ << "frame(s) after"
+           << startupClock_.elapsed() << "ms";
+  schedulePump();
+}
+
+void RestoreScheduler::enqueue(SplitFrameWidget *frame, const QString &address, const QString &windowId, bool focused) {
+  if (!frame) return;
+  if (address.trimmed().isEmpty()) {
+    // nothing to fetch; show the instruction page right away
+    frame->setAddress(address);
+    return;
+  }
+
+  frame->setAddressText(address);
+  // paint the last-known content until the load slot comes up
+  frame->showSnapshot(address);
+  Entry entry;
+  entry.frame = frame;
+  entry.address = address;
+  entry.windowId = windowId;
+  entry.focused = focused;
+  pending_.push_back(entry);
+  ++totalQueued_;
+
+  frame->installEventFilter(this);
+  connect(frame, &SplitFrameWidget::pageLoadFinished, this, &RestoreScheduler::onFrameLoadFinished, Qt::UniqueConnection);
+  connect(frame, &SplitFrameWidget::addressEdited, this, &RestoreScheduler::onFrameAddressEdited, Qt::UniqueConnection);
+  // destroyed() fires from ~QObject, so only the pointer value is used here
+  connect(frame, &QObject::destroyed, this, [this](QObject *obj) {
+    warming_.remove(static_cast<SplitFrameWidget *>(obj));
+    if (inFlight_.remove(static_cast<SplitFrameWidget *>(obj))) schedulePump();
+  });
+}
+
+bool RestoreScheduler::isPending(SplitFrameWidget *frame) const {
+  if (!frame) return false;
+  return std::any_of(pending_.begin(), pending_.end(), [frame](const Entry &e) { return e.frame == frame; });
+}
+
+bool RestoreScheduler::eventFilter(QObject *watched, QEvent *event) {
+  if (!pending_.empty()) {
+    switch (event->type()) {
+      case QEvent::Show:
+      case QEvent::Resize:
+        if (qobject_cast<SplitFrameWidget *>(watched)) schedulePump();
+        break;
+      case QEvent::Expose:
+        if (auto *handle = qobject_cast<QWindow *>(watched)) {
+          if (handle->isExposed()) schedulePump();
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return QObject::eventFilter(watched, event);
+}
+
+void RestoreScheduler::schedulePump() {
+  if (pumpQueued_ || collecting_) return;
+  pumpQueued_ = true;
+  QTimer::singleShot(0, this, [this]() {
+    pumpQueued_ = false;
+    pump();
+  });
+}
+
+void RestoreScheduler::pump() {
+  pending_.erase(std::remove_if(pending_.begin(), pending_.end(), [](const Entry &e) { return !e.frame; }), pending_.end());
+
+  while ((int)inFlight_.size() < maxConcurrentLoads_ && !pending_.empty()) {
+    int bestRank = -1;
+    size_t bestPos = 0;
+    for (size_t i = 0; i < pending_.size(); ++i) {
+      watchWindowHandle(pending_[i].frame);
+      const int rank = rankFor(pending_[i]);
+      if (rank < 0) continue;
+      // strict comparison keeps enqueue (logical frame) order among equal ranks
+      if (bestRank < 0 || rank < bestRank) {
+        bestRank = rank;
+        bestPos = i;
+      }
+    }
+    if (bestRank < 0) {
+      // everything left is hidden; warm what the profile allows, then wait for Show/Expose
+      if (inFlight_.isEmpty()) startWarmLoad();
+      break;
+    }
+
+    const Entry entry = pending_[bestPos];
+    pending_.erase(pending_.begin() + bestPos);
+    SplitFrameWidget *frame = entry.frame;
+    inFlight_.insert(frame);
+    frame->removeEventFilter(this);
+    qDebug() << "RestoreScheduler: loading" << entry.address << "rank=" << bestRank
+             << "inFlight=" << inFlight_.size() << "pending=" << pending_.size();
+    frame->applyAddress(entry.address);
+
+    QPointer<SplitFrameWidget> guard(frame);
+    QTimer::singleShot(RESTORE_LOAD_TIMEOUT_MS, this, [this, guard]() {
+      if (guard && inFlight_.contains(guard)) {
+        qDebug() << "RestoreScheduler: load timed out, releasing slot for" << guard->address();
+        finishLoad(guard, false);
+      }
+    });
+  }
+  maybeFinish();
+}
+
+int RestoreScheduler::rankFor(const Entry &entry) const {
+  // parked ScrollGrid cells would only queue the load until unparked
+  if (entry.frame->isContentParked()) return -1;
+  const bool visible = entry.frame->isContentVisible();
+  if (!visible && deferHiddenFrames_) return -1;
+  const bool lastActive = !lastActiveWindowId_.isEmpty() && entry.windowId == lastActiveWindowId_;
+  int rank = (lastActive ? 0 : 2) + (entry.focused ? 0 : 1);
+  if (!visible) rank += 4;
+  return rank;
+}
+
+void RestoreScheduler::finishLoad(SplitFrameWidget *frame, bool ok) {
+  if (!inFlight_.remove(frame)) return;
+  disconnect(frame, &SplitFrameWidget::pageLoadFinished, this, &RestoreScheduler::onFrameLoadFinished);
+  if (warming_.remove(frame)) {
+    // the cache is warm now; drop the renderer unless the frame was shown meanwhile
+    const bool discarded = FrameHibernationManager::instance().discardHiddenFrame(frame);
+    qDebug() << "RestoreScheduler: warmed" << frame->address() << "ok=" << ok << "discarded=" << discarded;
+    schedulePump();
+    return;
+  }
+  if (ok && firstInteractiveMs_ < 0) {
+    firstInteractiveMs_ = startupClock_.elapsed();
+    traceInstant("firstInteractiveFrame", frame->address());
+    qDebug() << "RestoreScheduler: time to first interactive frame:" << firstInteractiveMs_ << "ms"
+             << "url=" << frame->address();
+  }
+  schedulePump();
+}
+
+void RestoreScheduler::onFrameLoadFinished(SplitFrameWidget *frame, bool ok) {
+  finishLoad(frame, ok);
+}
+
+void RestoreScheduler::onFrameAddressEdited(SplitFrameWidget *frame, const QString &text) {
+  Q_UNUSED(text);
+  // The user navigated before we got to this frame; their load wins.
+  const auto it = std::find_if(pending_.begin(), pending_.end(), [frame](const Entry &e) { return e.frame == frame; });
+  if (it == pending_.end()) return;
+  qDebug() << "RestoreScheduler: dropping pending load superseded by user for" << it->address;
+  pending_.erase(it);
+  maybeFinish();
+}
+
+void RestoreScheduler::watchWindowHandle(SplitFrameWidget *frame) {
+  QWidget *top = frame ? frame->window() : nullptr;
+  QWindow *handle = top ? top->windowHandle() : nullptr;
+  if (!handle || watchedWindows_.contains(handle)) return;
+  watchedWindows_.insert(handle);
+  handle->installEventFilter(this);
+  connect(handle, &QObject::destroyed, this, [this](QObject *obj) {
+    watchedWindows_.remove(static_cast<QWindow *>(obj));
+  });
+}
+
+bool RestoreScheduler::startWarmLoad() {
+  const auto it = std::find_if(pending_.begin(), pending_.end(), [](const Entry &e) {
+    if (e.frame->isContentParked() || e.frame->isContentVisible()) return false;
+    QWebEnginePage *page = e.frame->page();
+    if (!page || page->profile()->isOffTheRecord()) return false;
+    const QString profileName = profileNameFor(page->profile());
+    return !profileName.isEmpty() && profileCachePolicy(profileName).warmOnRestore;
+  });
+  if (it == pending_.end()) return false;
+
+  const Entry entry = *it;
+  pending_.erase(it);
+  SplitFrameWidget *frame = entry.frame;
+  inFlight_.insert(frame);
+  warming_.insert(frame);
+  frame->removeEventFilter(this);
+  qDebug() << "RestoreScheduler: warming" << entry.address << "pending=" << pending_.size();
+  frame->applyAddress(entry.address);
+
+  QPointer<SplitFrameWidget> guard(frame);
+  QTimer::singleShot(RESTORE_LOAD_TIMEOUT_MS, this, [this, guard]() {
+    if (guard && inFlight_.contains(guard)) {
+      qDebug() << "RestoreScheduler: warming timed out for" << guard->address();
+      finishLoad(guard, false);
+    }
+  });
+  return true;
+}
+
+void RestoreScheduler::maybeFinish() {
+  if (!active_ || !pending_.empty() || !inFlight_.isEmpty()) return;
+  active_ = false;
+  qDebug() << "RestoreScheduler: session restore finished:" << totalQueued_ << "frame(s) in"
+           << startupClock_.elapsed() << "ms; first interactive frame at" << firstInteractiveMs_ << "ms";
+  traceInstant("sessionRestoreFinished");
+  // cold start is over; write now so the trace is usable without quitting
+  writeTraceFile();
+  markEngineStartupSucceeded();
+}
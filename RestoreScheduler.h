@@ -0,0 +1,177 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <vector>
+
+class QWindow;
+class SplitFrameWidget;
+
+/**
+ * @brief Staggers page loads while the previous session is being restored.
+ *
+ * Without scheduling, every restored frame calls setAddress() from its
+ * window's constructor, so dozens of pages compete for network and renderer
+ * processes and the first window stays unusable for seconds. While a restore
+ * is in progress SplitWindow hands each frame's address to enqueue() instead;
+ * the scheduler shows the address right away and loads pages in priority order:
+ *
+ * 1. The focused frame of the last active window (SessionStore::lastActiveWindowId())
+ * 2. Other visible frames of that window
+ * 3. Focused, then visible frames of the remaining windows
+ * 4. Hidden frames, only when `restore/deferHiddenFrames` is false; otherwise
+ *    they stay pending until they are shown, resized open, or exposed
+ *
+ * At most `restore/maxConcurrentLoads` pages load at once. A slot is released
+ * when the frame reports pageLoadFinished or after a fixed timeout.
+ *
+ * Once nothing visible is left to load, hidden frames of profiles with
+ * `warmCacheOnRestore` (see ProfileCachePolicy) are loaded one at a time and
+ * discarded again when they finish, so their first real show is served from
+ * the profile's warm HTTP cache.
+ *
+ * The time from process start to the first finished page load is logged as
+ * "time to first interactive frame" so restore changes can be measured.
+ */
+class RestoreScheduler : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared scheduler, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static RestoreScheduler &instance();
+
+  /**
+   * @brief Starts collecting frames for a session restore.
+   * @param startupClock Timer started at the top of main(); used for the startup metrics
+   *
+   * Reads the `restore/*` settings and the session's last active window id. Windows created
+   * until commitRestore() is called route their initial loads through enqueue().
+   */
+  void beginRestore(const QElapsedTimer &startupClock);
+
+  /**
+   * @brief Stops collecting and starts loading the queued frames.
+   *
+   * Loading begins from the event loop so windows have been shown (and
+   * ideally exposed) before visibility is evaluated.
+   */
+  void commitRestore();
+
+  /**
+   * @brief Returns whether windows should defer their initial frame loads.
+   * @return true between beginRestore() and commitRestore()
+   */
+  bool isRestoring() const { return collecting_; }
+
+  /**
+   * @brief Returns whether restored pages are still being loaded.
+   * @return true from commitRestore() until every queued frame has loaded or been dropped
+   */
+  bool isLoading() const { return active_; }
+
+  /**
+   * @brief Queues a restored frame's address for a prioritized load.
+   * @param frame The frame to load
+   * @param address The persisted address; empty addresses are applied immediately
+   * @param windowId The owning window's persistent ID (to match the last active window)
+   * @param focused Whether this was the window's focused frame when the session was saved
+   *
+   * The address bar shows @p address immediately. The pending load is dropped
+   * if the frame is destroyed or the user edits the address first.
+   */
+  void enqueue(SplitFrameWidget *frame, const QString &address, const QString &windowId, bool focused);
+
+  /**
+   * @brief Returns whether a frame still has a restore load pending.
+   * @param frame The frame to check
+   * @return true if the frame is queued and has not been loaded yet
+   */
+  bool isPending(SplitFrameWidget *frame) const;
+
+  /**
+   * @brief Re-checks pending frames after a visibility change the event filter can't see.
+   *
+   * Called when a ScrollGrid cell is unparked (its web view is shown while
+   * the frame itself keeps its size).
+   */
+  void frameVisibilityChanged() { schedulePump(); }
+
+  /**
+   * @brief Returns the measured time to the first finished page load.
+   * @return Milliseconds since process start, or -1 if no restored frame has loaded yet
+   */
+  qint64 firstInteractiveMs() const { return firstInteractiveMs_; }
+
+protected:
+  /**
+   * @brief Schedules a pump when a pending frame is shown/resized or its window is exposed.
+   * @param watched The frame widget or QWindow being watched
+   * @param event The event being filtered
+   * @return Always false so events propagate normally
+   */
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+  /** @brief A frame waiting for its restore load. */
+  struct Entry {
+    QPointer<SplitFrameWidget> frame; ///< Frame to load (cleared on destruction)
+    QString address;                  ///< Address to apply
+    QString windowId;                 ///< Owning window's persistent ID
+    bool focused = false;             ///< Was the focused frame of its window
+  };
+
+  explicit RestoreScheduler(QObject *parent = nullptr);
+
+  /** @brief Queues a single pump on the event loop, coalescing repeated requests. */
+  void schedulePump();
+
+  /** @brief Starts loads for the best pending entries until all slots are busy. */
+  void pump();
+
+  /**
+   * @brief Ranks a pending entry; lower loads first.
+   * @return Rank, or -1 if the entry must keep waiting (hidden frame)
+   */
+  int rankFor(const Entry &entry) const;
+
+  /** @brief Releases a frame's load slot and pumps the queue. */
+  void finishLoad(SplitFrameWidget *frame, bool ok);
+
+  /** @brief Slot for SplitFrameWidget::pageLoadFinished. */
+  void onFrameLoadFinished(SplitFrameWidget *frame, bool ok);
+
+  /** @brief Drops a pending entry when the user edits the address first. */
+  void onFrameAddressEdited(SplitFrameWidget *frame, const QString &text);
+
+  /** @brief Installs an Expose watcher on the frame's top-level QWindow once. */
+  void watchWindowHandle(SplitFrameWidget *frame);
+
+  /**
+   * @brief Loads one hidden frame of a warmCacheOnRestore profile while the queue is idle.
+   * @return true if a warming load was started
+   */
+  bool startWarmLoad();
+
+  /** @brief Logs the summary once nothing is pending or loading. */
+  void maybeFinish();
+
+  std::vector<Entry> pending_;             ///< Frames waiting for a load slot, in enqueue order
+  QSet<SplitFrameWidget *> inFlight_;      ///< Frames currently loading
+  QSet<SplitFrameWidget *> warming_;       ///< In-flight frames loaded only to warm the cache
+  QSet<QWindow *> watchedWindows_;         ///< Top-level windows with an Expose watcher installed
+  QString lastActiveWindowId_;             ///< Window that was active when the session was saved
+  QElapsedTimer startupClock_;             ///< Started at the top of main()
+  int maxConcurrentLoads_ = 3;             ///< Mirrors restore/maxConcurrentLoads
+  bool deferHiddenFrames_ = true;          ///< Mirrors restore/deferHiddenFrames
+  bool collecting_ = false;                ///< Between beginRestore() and commitRestore()
+  bool pumpQueued_ = false;                ///< A pump is already queued on the event loop
+  bool active_ = false;                    ///< A committed restore has not finished yet
+  int totalQueued_ = 0;                    ///< Frames queued during this restore
+  qint64 firstInteractiveMs_ = -1;         ///< Time to first finished load (process clock)
+};
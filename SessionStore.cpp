@@ -0,0 +1,325 @@
+#include "SessionStore.h"
+#include "AppSettings.h"
+#include "Trace.h"
+#include <QApplication>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <utility>
+
+namespace {
+  constexpr int SESSION_FORMAT_VERSION = 1;
+  constexpr int SESSION_COMPACT_RECORDS = 200;        // journal length that triggers a new snapshot
+  constexpr quint32 SESSION_MAX_RECORD_BYTES = 16 * 1024 * 1024;
+
+  QCborMap encodeWindow(const SessionWindowState &w) {
+    QCborArray frames;
+    for (const SessionFrameState &f : w.frames) {
+      QCborMap fm;
+      fm[QStringLiteral("a")] = f.address;
+      if (f.scale != 1.0) fm[QStringLiteral("s")] = f.scale;
+      if (f.refreshSeconds > 0) fm[QStringLiteral("r")] = f.refreshSeconds;
+      if (f.keepAlive) fm[QStringLiteral("k")] = true;
+      frames.append(fm);
+    }
+    QCborMap splitters;
+    for (auto it = w.splitterSizes.constBegin(); it != w.splitterSizes.constEnd(); ++it) {
+      QCborArray perSplitter;
+      for (const QList<int> &sizes : it.value()) {
+        QCborArray sa;
+        for (int v : sizes) sa.append(v);
+        perSplitter.append(sa);
+      }
+      splitters[it.key()] = perSplitter;
+    }
+    QCborMap m;
+    m[QStringLiteral("id")] = w.id;
+    m[QStringLiteral("profile")] = w.profileName;
+    m[QStringLiteral("layout")] = w.layoutMode;
+    if (!w.backgroundPolicy.isEmpty()) m[QStringLiteral("policy")] = w.backgroundPolicy;
+    m[QStringLiteral("geometry")] = w.geometry;
+    m[QStringLiteral("state")] = w.windowState;
+    m[QStringLiteral("focus")] = w.focusedFrameIndex;
+    m[QStringLiteral("frames")] = frames;
+    if (!splitters.isEmpty()) m[QStringLiteral("splitters")] = splitters;
+    return m;
+  }
+
+  SessionWindowState decodeWindow(const QCborMap &m) {
+    SessionWindowState w;
+    w.id = m.value(QStringLiteral("id")).toString();
+    w.profileName = m.value(QStringLiteral("profile")).toString();
+    w.layoutMode = int(m.value(QStringLiteral("layout")).toInteger());
+    w.backgroundPolicy = m.value(QStringLiteral("policy")).toString();
+    w.geometry = m.value(QStringLiteral("geometry")).toByteArray();
+    w.windowState = m.value(QStringLiteral("state")).toByteArray();
+    w.focusedFrameIndex = int(m.value(QStringLiteral("focus")).toInteger(-1));
+    const QCborArray frames = m.value(QStringLiteral("frames")).toArray();
+    w.frames.reserve(frames.size());
+    for (const QCborValue &v : frames) {
+      const QCborMap fm = v.toMap();
+      SessionFrameState f;
+      f.address = fm.value(QStringLiteral("a")).toString();
+      f.scale = fm.value(QStringLiteral("s")).toDouble(1.0);
+      f.refreshSeconds = int(fm.value(QStringLiteral("r")).toInteger());
+      f.keepAlive = fm.value(QStringLiteral("k")).toBool();
+      w.frames.append(f);
+    }
+    const QCborMap splitters = m.value(QStringLiteral("splitters")).toMap();
+    for (auto it = splitters.constBegin(); it != splitters.constEnd(); ++it) {
+      QList<QList<int>> perSplitter;
+      for (const QCborValue &sv : it.value().toArray()) {
+        QList<int> sizes;
+        for (const QCborValue &v : sv.toArray()) sizes << int(v.toInteger());
+        perSplitter << sizes;
+      }
+      w.splitterSizes.insert(it.key().toString(), perSplitter);
+    }
+    return w;
+  }
+
+  QByteArray encodeSnapshot(const QHash<QString, SessionWindowState> &windows, const QStringList &order,
+                            const QString &lastActive) {
+    QCborArray list;
+    for (const QString &id : order) {
+      const auto it = windows.constFind(id);
+      if (it != windows.constEnd()) list.append(encodeWindow(it.value()));
+    }
+    QCborMap root;
+    root[QStringLiteral("version")] = SESSION_FORMAT_VERSION;
+    root[QStringLiteral("lastActive")] = lastActive;
+    root[QStringLiteral("windows")] = list;
+    return root.toCborValue().toCbor();
+  }
+
+  // Journal framing: big-endian quint32 length, then one CBOR map.
+  QByteArray frameRecord(const QCborMap &record) {
+    const QByteArray body = record.toCborValue().toCbor();
+    QByteArray out(4, Qt::Uninitialized);
+    qToBigEndian<quint32>(quint32(body.size()), out.data());
+    out.append(body);
+    return out;
+  }
+}
+
+SessionStore &SessionStore::instance() {
+  static SessionStore *inst = new SessionStore(qApp);
+  return *inst;
+}
+
+SessionStore::SessionStore(QObject *parent) : QObject(parent) {
+  writer_.setMaxThreadCount(1);
+}
+
+QString SessionStore::snapshotPath() {
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/session.cbor");
+}
+
+QString SessionStore::journalPath() {
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/session.journal");
+}
+
+void SessionStore::load() {
+  if (loaded_) return;
+  loaded_ = true;
+  PHRAIMS_TRACE_SCOPE("SessionStore::load");
+
+  QFile snapshot(snapshotPath());
+  const bool haveSnapshot = snapshot.exists();
+  if (haveSnapshot && snapshot.open(QIODevice::ReadOnly)) {
+    QCborParserError error;
+    const QCborValue root = QCborValue::fromCbor(snapshot.readAll(), &error);
+    if (error.error != QCborError::NoError || !root.isMap()) {
+      qWarning() << "SessionStore::load: unreadable snapshot" << snapshotPath() << error.errorString();
+    } else {
+      const QCborMap map = root.toMap();
+      lastActiveWindowId_ = map.value(QStringLiteral("lastActive")).toString();
+      for (const QCborValue &v : map.value(QStringLiteral("windows")).toArray()) {
+        SessionWindowState w = decodeWindow(v.toMap());
+        if (w.id.isEmpty() || windows_.contains(w.id)) continue;
+        order_ << w.id;
+        windows_.insert(w.id, std::move(w));
+      }
+    }
+  }
+
+  // Replay changes made after the snapshot; stop at the first torn record.
+  QFile journal(journalPath());
+  int replayed = 0;
+  if (journal.open(QIODevice::ReadOnly)) {
+    const QByteArray data = journal.readAll();
+    qsizetype pos = 0;
+    while (pos + 4 <= data.size()) {
+      const quint32 length = qFromBigEndian<quint32>(data.constData() + pos);
+      if (length > SESSION_MAX_RECORD_BYTES || pos + 4 + qsizetype(length) > data.size()) break;
+      QCborParserError error;
+      const QCborValue record = QCborValue::fromCbor(data.mid(pos + 4, length), &error);
+      if (error.error != QCborError::NoError || !record.isMap()) break;
+      pos += 4 + length;
+      const QCborMap m = record.toMap();
+      const QString op = m.value(QStringLiteral("op")).toString();
+      if (op == QLatin1String("put")) {
+        SessionWindowState w = decodeWindow(m.value(QStringLiteral("w")).toMap());
+        if (w.id.isEmpty()) continue;
+        if (!windows_.contains(w.id)) order_ << w.id;
+        windows_.insert(w.id, std::move(w));
+      } else if (op == QLatin1String("del")) {
+        const QString id = m.value(QStringLiteral("id")).toString();
+        windows_.remove(id);
+        order_.removeAll(id);
+      } else if (op == QLatin1String("active")) {
+        lastActiveWindowId_ = m.value(QStringLiteral("id")).toString();
+      }
+      ++replayed;
+    }
+    if (pos < data.size()) {
+      qWarning() << "SessionStore::load: ignoring" << (data.size() - pos) << "byte(s) of torn journal tail";
+    }
+  }
+
+  if (!haveSnapshot && replayed == 0) {
+    importFromSettings();
+    scheduleSnapshot();
+  } else if (replayed > 0) {
+    // fold the replayed records into a fresh snapshot
+    scheduleSnapshot();
+  }
+  qDebug() << "SessionStore::load:" << order_.size() << "window(s), replayed" << replayed
+           << "journal record(s); lastActive=" << lastActiveWindowId_;
+}
+
+void SessionStore::importFromSettings() {
+  PHRAIMS_TRACE_SCOPE("SessionStore::importFromSettings");
+  AppSettings s;
+  lastActiveWindowId_ = s->value("lastActiveWindowId").toString();
+  s->beginGroup(QStringLiteral("windows"));
+  const QStringList ids = s->childGroups();
+  for (const QString &id : ids) {
+    s->beginGroup(id);
+    SessionWindowState w;
+    w.id = id;
+    w.profileName = s->value("profileName").toString();
+    w.layoutMode = s->value("layoutMode", 0).toInt();
+    w.backgroundPolicy = s->value("backgroundPolicy").toString();
+    w.geometry = s->value("windowGeometry").toByteArray();
+    w.windowState = s->value("windowState").toByteArray();
+    w.focusedFrameIndex = s->value("focusedFrameIndex", -1).toInt();
+    const QStringList addresses = s->value("addresses").toStringList();
+    const QVariantList scales = s->value("frameScales").toList();
+    const QVariantList intervals = s->value("frameRefreshIntervals").toList();
+    const QVariantList keepAlive = s->value("frameKeepAlive").toList();
+    for (int i = 0; i < addresses.size(); ++i) {
+      SessionFrameState f;
+      f.address = addresses.at(i);
+      if (i < scales.size()) f.scale = scales.at(i).toDouble();
+      if (f.scale <= 0) f.scale = 1.0;
+      if (i < intervals.size()) f.refreshSeconds = intervals.at(i).toInt();
+      if (i < keepAlive.size()) f.keepAlive = keepAlive.at(i).toBool();
+      w.frames << f;
+    }
+    s->beginGroup(QStringLiteral("splitterSizes"));
+    for (const QString &layout : s->childGroups()) {
+      s->beginGroup(layout);
+      QList<QList<int>> perSplitter;
+      for (int i = 0; s->contains(QString::number(i)); ++i) {
+        QList<int> sizes;
+        for (const QVariant &v : s->value(QString::number(i)).toList()) sizes << v.toInt();
+        perSplitter << sizes;
+      }
+      w.splitterSizes.insert(layout, perSplitter);
+      s->endGroup();
+    }
+    s->endGroup();
+    s->endGroup();
+    order_ << id;
+    windows_.insert(id, w);
+  }
+  s->endGroup();
+  qDebug() << "SessionStore::importFromSettings: imported" << ids.size() << "window(s) from" << s->fileName();
+}
+
+const SessionWindowState *SessionStore::window(const QString &id) const {
+  const auto it = windows_.constFind(id);
+  return it == windows_.constEnd() ? nullptr : &it.value();
+}
+
+void SessionStore::saveWindow(const SessionWindowState &state) {
+  if (state.id.isEmpty()) return;
+  if (!windows_.contains(state.id)) order_ << state.id;
+  windows_.insert(state.id, state);
+  QCborMap record;
+  record[QStringLiteral("op")] = QStringLiteral("put");
+  record[QStringLiteral("w")] = encodeWindow(state);
+  appendRecord(frameRecord(record));
+}
+
+void SessionStore::removeWindow(const QString &id) {
+  if (windows_.remove(id) == 0) return;
+  order_.removeAll(id);
+  QCborMap record;
+  record[QStringLiteral("op")] = QStringLiteral("del");
+  record[QStringLiteral("id")] = id;
+  appendRecord(frameRecord(record));
+}
+
+void SessionStore::setLastActiveWindowId(const QString &id) {
+  if (id == lastActiveWindowId_) return;
+  lastActiveWindowId_ = id;
+  QCborMap record;
+  record[QStringLiteral("op")] = QStringLiteral("active");
+  record[QStringLiteral("id")] = id;
+  appendRecord(frameRecord(record));
+}
+
+void SessionStore::appendRecord(const QByteArray &record) {
+  writer_.start([record]() {
+    QFile file(journalPath());
+    QDir().mkpath(QFileInfo(file).absolutePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+      qWarning() << "SessionStore: cannot append to journal:" << file.errorString();
+      return;
+    }
+    file.write(record);
+  });
+  if (++journalRecords_ >= SESSION_COMPACT_RECORDS) scheduleSnapshot();
+}
+
+void SessionStore::scheduleSnapshot() {
+  journalRecords_ = 0;
+  // implicitly shared copies; the writer encodes them off the GUI thread
+  writer_.start([windows = windows_, order = order_, lastActive = lastActiveWindowId_]() {
+    PHRAIMS_TRACE_SCOPE("SessionStore: write snapshot");
+    const QByteArray data = encodeSnapshot(windows, order, lastActive);
+    QDir().mkpath(QFileInfo(snapshotPath()).absolutePath());
+    QSaveFile file(snapshotPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+      qWarning() << "SessionStore: cannot write snapshot:" << file.errorString();
+      return;
+    }
+    file.write(data);
+    if (!file.commit()) {
+      // keep the journal; it still holds everything since the last good snapshot
+      qWarning() << "SessionStore: snapshot commit failed:" << file.errorString();
+      return;
+    }
+    // everything journaled so far is in the snapshot now
+    QFile journal(journalPath());
+    if (journal.exists() && !journal.resize(0)) {
+      qWarning() << "SessionStore: cannot truncate journal:" << journal.errorString();
+    }
+    qDebug() << "SessionStore: wrote snapshot of" << order.size() << "window(s)," << data.size() << "bytes";
+  });
+}
+
+void SessionStore::flush() {
+  if (!loaded_) return;
+  scheduleSnapshot();
+  writer_.waitForDone();
+}
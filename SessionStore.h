@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+/** @brief Persisted state of one frame (mirrors SplitWindow::FrameState). */
+struct SessionFrameState {
+  QString address;         ///< Last loaded address
+  double scale = 1.0;      ///< UI/content scale multiplier
+  int refreshSeconds = 0;  ///< Auto-refresh interval (0 = off)
+  bool keepAlive = false;  ///< Exempt from background throttling
+};
+
+/** @brief Persisted state of one restorable window. */
+struct SessionWindowState {
+  QString id;                       ///< Window UUID (SplitWindow::windowId_)
+  QString profileName;              ///< Profile the window uses
+  int layoutMode = 0;               ///< SplitWindow::LayoutMode value
+  QString backgroundPolicy;         ///< FrameHibernationManager policy key; empty follows the default
+  QByteArray geometry;              ///< QWidget::saveGeometry()
+  QByteArray windowState;           ///< QMainWindow::saveState()
+  int focusedFrameIndex = -1;       ///< Frame to focus (and load first) on restore
+  QList<SessionFrameState> frames;  ///< Frames in logical order
+  QHash<QString, QList<QList<int>>> splitterSizes; ///< Layout key -> sizes per splitter index
+};
+
+/**
+ * @brief Session persistence: one compact snapshot plus an append-only journal.
+ *
+ * Replaces the per-window `windows/<id>` groups in settings.ini. The whole
+ * session lives in memory and is read once at startup (load()): the CBOR
+ * snapshot `session.cbor` is decoded in a single pass and the records in
+ * `session.journal` are replayed on top of it. A torn last journal record
+ * (crash mid-append) is ignored.
+ *
+ * Every change (saveWindow(), removeWindow(), setLastActiveWindowId())
+ * updates memory immediately and appends one journal record on a
+ * single-threaded writer pool, so the GUI thread never touches the disk.
+ * After SESSION_COMPACT_RECORDS records, and in flush(), the writer
+ * serializes a new snapshot, swaps it in atomically with QSaveFile and
+ * truncates the journal. Because the pool runs tasks in order, journal
+ * records queued after a snapshot land in the fresh journal.
+ *
+ * On first run the existing `windows/<id>` groups (and `lastActiveWindowId`)
+ * are imported from AppSettings once; the old keys are left in place so an
+ * older build can still restore them.
+ */
+class SessionStore : public QObject {
+  Q_OBJECT
+  /// phraims-bench (bench/BenchMain.cpp) reloads the store from disk to time load().
+  friend class SessionStoreBench;
+public:
+  /**
+   * @brief Returns the shared store, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static SessionStore &instance();
+
+  /**
+   * @brief Reads the snapshot and replays the journal; call once before restoring windows.
+   *
+   * Later calls are no-ops. Falls back to importing settings.ini when no
+   * session file exists yet.
+   */
+  void load();
+
+  /**
+   * @brief Returns the ids of the stored windows in the order they were first saved.
+   * @return Window ids to restore
+   */
+  QStringList windowIds() const { return order_; }
+
+  /**
+   * @brief Looks up a stored window.
+   * @param id Window id
+   * @return Pointer to the state, or nullptr if the window is not stored (valid until the next change)
+   */
+  const SessionWindowState *window(const QString &id) const;
+
+  /**
+   * @brief Stores (replaces) a window's state and journals it.
+   * @param state Full state; `state.id` must be set
+   */
+  void saveWindow(const SessionWindowState &state);
+
+  /**
+   * @brief Forgets a window so it is not restored.
+   * @param id Window id
+   */
+  void removeWindow(const QString &id);
+
+  /**
+   * @brief Returns the window that was active most recently.
+   * @return Window id, or empty if none was recorded
+   */
+  QString lastActiveWindowId() const { return lastActiveWindowId_; }
+
+  /**
+   * @brief Records the most recently active window (journaled only when it changes).
+   * @param id Window id
+   */
+  void setLastActiveWindowId(const QString &id);
+
+  /**
+   * @brief Writes a snapshot and blocks until all pending writes are on disk.
+   *
+   * Called on quit after every window saved its state.
+   */
+  void flush();
+
+  /** @brief Path of the snapshot file (`<AppDataLocation>/session.cbor`). */
+  static QString snapshotPath();
+
+  /** @brief Path of the journal file (`<AppDataLocation>/session.journal`). */
+  static QString journalPath();
+
+private:
+  explicit SessionStore(QObject *parent = nullptr);
+
+  /** @brief Imports the legacy `windows/<id>` settings groups (first run only). */
+  void importFromSettings();
+
+  /** @brief Queues one encoded journal record and compacts when the journal is long. */
+  void appendRecord(const QByteArray &record);
+
+  /** @brief Queues a snapshot of the current state (which also truncates the journal). */
+  void scheduleSnapshot();
+
+  QHash<QString, SessionWindowState> windows_; ///< Stored windows by id
+  QStringList order_;                          ///< Window ids in restore order
+  QString lastActiveWindowId_;                 ///< Most recently active window
+  QThreadPool writer_;                         ///< Single thread: journal appends and snapshots, in order
+  int journalRecords_ = 0;                     ///< Records appended since the last snapshot
+  bool loaded_ = false;                        ///< load() already ran
+};
@@ -0,0 +1,93 @@
+#include "SnapshotCache.h"
+#include "AppSettings.h"
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QSaveFile>
+#include <QUrl>
+#include <QWebEngineProfile>
+#include <algorithm>
+
+namespace {
+  constexpr int DEFAULT_MEMORY_CACHE_MB = 32;
+  constexpr int DEFAULT_MAX_WIDTH = 480;      // snapshots are placeholders, not screenshots
+  constexpr int MIN_MAX_WIDTH = 160;
+  constexpr int MAX_MAX_WIDTH = 1920;
+  constexpr int DEFAULT_MAX_DISK_FILES = 300;
+  constexpr int JPEG_QUALITY = 70;
+}
+
+SnapshotCache &SnapshotCache::instance() {
+  static SnapshotCache *inst = new SnapshotCache(qApp);
+  return *inst;
+}
+
+SnapshotCache::SnapshotCache(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  enabled_ = s->value("snapshots/enabled", true).toBool();
+  maxWidth_ = std::clamp(s->value("snapshots/maxWidth", DEFAULT_MAX_WIDTH).toInt(), MIN_MAX_WIDTH, MAX_MAX_WIDTH);
+  maxDiskFiles_ = std::max(0, s->value("snapshots/maxDiskFiles", DEFAULT_MAX_DISK_FILES).toInt());
+  const int memoryMB = std::max(1, s->value("snapshots/memoryCacheMB", DEFAULT_MEMORY_CACHE_MB).toInt());
+  memory_.setMaxCost(memoryMB * 1024);
+  writer_.setMaxThreadCount(1);
+  qDebug() << "SnapshotCache: enabled=" << enabled_ << "maxWidth=" << maxWidth_
+           << "memoryCacheMB=" << memoryMB << "maxDiskFiles=" << maxDiskFiles_;
+}
+
+QString SnapshotCache::directoryFor(QWebEngineProfile *profile) {
+  if (!profile || profile->isOffTheRecord() || profile->persistentStoragePath().isEmpty()) return QString();
+  return profile->persistentStoragePath() + QStringLiteral("/snapshots");
+}
+
+QString SnapshotCache::keyFor(QWebEngineProfile *profile, const QUrl &url) {
+  const QByteArray page = url.adjusted(QUrl::RemoveFragment).toString().toUtf8();
+  const QString name = QString::fromLatin1(QCryptographicHash::hash(page, QCryptographicHash::Sha1).toHex());
+  // off-the-record profiles have no directory; the pointer keeps them apart
+  QString scope = directoryFor(profile);
+  if (scope.isEmpty()) scope = QString::number(quintptr(profile), 16);
+  return scope + QLatin1Char('/') + name;
+}
+
+void SnapshotCache::insert(const QString &key, const QPixmap &shot) {
+  const int costKb = std::max(1, int(qint64(shot.width()) * shot.height() * shot.depth() / 8 / 1024));
+  memory_.insert(key, new QPixmap(shot), costKb);
+}
+
+void SnapshotCache::store(QWebEngineProfile *profile, const QUrl &url, const QPixmap &shot) {
+  if (!enabled_ || !profile || !url.isValid() || shot.isNull()) return;
+  const QPixmap scaled = shot.width() > maxWidth_ ? shot.scaledToWidth(maxWidth_, Qt::SmoothTransformation) : shot;
+  const QString key = keyFor(profile, url);
+  insert(key, scaled);
+
+  const QString dir = directoryFor(profile);
+  if (dir.isEmpty() || maxDiskFiles_ == 0) return;
+  // QPixmap is GUI-thread only; QImage can be encoded on the writer
+  writer_.start([dir, path = key + QStringLiteral(".jpg"), image = scaled.toImage(), maxFiles = maxDiskFiles_]() {
+    QDir().mkpath(dir);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "JPEG", JPEG_QUALITY) || !file.commit()) {
+      qWarning() << "SnapshotCache: cannot write" << path << file.errorString();
+      return;
+    }
+    const QFileInfoList files = QDir(dir).entryInfoList({QStringLiteral("*.jpg")}, QDir::Files, QDir::Time);
+    for (int i = maxFiles; i < files.size(); ++i) QFile::remove(files[i].absoluteFilePath());
+  });
+}
+
+QPixmap SnapshotCache::lookup(QWebEngineProfile *profile, const QUrl &url) {
+  if (!enabled_ || !profile || !url.isValid()) return QPixmap();
+  const QString key = keyFor(profile, url);
+  if (const QPixmap *cached = memory_.object(key)) return *cached;
+  if (directoryFor(profile).isEmpty()) return QPixmap();
+  QPixmap shot;
+  if (!shot.load(key + QStringLiteral(".jpg"), "JPEG")) return QPixmap();
+  insert(key, shot);
+  return shot;
+}
+
+void SnapshotCache::flush() {
+  writer_.waitForDone();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QCache>
+#include <QObject>
+#include <QPixmap>
+#include <QString>
+#include <QThreadPool>
+
+class QUrl;
+class QWebEngineProfile;
+
+/**
+ * @brief Last-known page images painted while a frame has no live content.
+ *
+ * SplitFrameWidget::captureSnapshot() grabs its web view when the page is
+ * about to be frozen or discarded (FrameHibernationManager), when a
+ * ScrollGrid cell is parked, a moment after each successful load, and when
+ * the window closes. The image is downscaled to `snapshots/maxWidth` and kept
+ * in an in-memory LRU cache of `snapshots/memoryCacheMB`. Snapshots of
+ * persistent profiles are also written as JPEG files to
+ * `<profile storage>/snapshots/`, keeping at most `snapshots/maxDiskFiles`
+ * (oldest removed first), so the next session restore can paint them before
+ * any page has loaded. Off-the-record profiles stay in memory only.
+ *
+ * Snapshots are keyed by profile and URL (fragment dropped). Encoding and
+ * file I/O run on a single-threaded writer pool; lookup() falls back to a
+ * synchronous read of the (small) file on a memory miss.
+ */
+class SnapshotCache : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared cache, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static SnapshotCache &instance();
+
+  /** @brief Returns whether snapshots are captured and painted (`snapshots/enabled`). */
+  bool isEnabled() const { return enabled_; }
+
+  /**
+   * @brief Stores a snapshot of a page.
+   * @param profile Profile the page belongs to (selects the disk directory)
+   * @param url Page URL the snapshot shows
+   * @param shot Full-size grab of the web view; downscaled here
+   */
+  void store(QWebEngineProfile *profile, const QUrl &url, const QPixmap &shot);
+
+  /**
+   * @brief Returns the last snapshot of a page, from memory or disk.
+   * @param profile Profile the page belongs to
+   * @param url Page URL
+   * @return The snapshot, or a null pixmap when none is cached
+   */
+  QPixmap lookup(QWebEngineProfile *profile, const QUrl &url);
+
+  /** @brief Waits for queued disk writes; called from aboutToQuit. */
+  void flush();
+
+private:
+  explicit SnapshotCache(QObject *parent = nullptr);
+
+  /** @brief Returns the snapshot directory of a profile, or empty for off-the-record profiles. */
+  static QString directoryFor(QWebEngineProfile *profile);
+
+  /** @brief Returns the cache key (and file base name) for a page. */
+  static QString keyFor(QWebEngineProfile *profile, const QUrl &url);
+
+  /** @brief Inserts into the memory cache, costed in KiB. */
+  void insert(const QString &key, const QPixmap &shot);
+
+  QCache<QString, QPixmap> memory_;  ///< LRU cache; cost is the pixmap size in KiB
+  QThreadPool writer_;               ///< Single thread: JPEG encoding, file writes and pruning
+  bool enabled_ = true;              ///< snapshots/enabled
+  int maxWidth_ = 480;               ///< snapshots/maxWidth (pixels)
+  int maxDiskFiles_ = 300;           ///< snapshots/maxDiskFiles per profile
+};
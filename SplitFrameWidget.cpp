@@ -3,6 +3,9 @@
 #include "MyWebEnginePage.h"
 #include "EscapeFilter.h"
 #include "DomPatch.h"
+#include "FrameHibernation.h"
+#include "FrameMetrics.h"
+#include "SnapshotCache.h"
 #include <QApplication>
 #include <QDebug>
 #include <QEvent>
@@ -11,6 +14,8 @@
 #include <QLineEdit>
 #include <QMainWindow>
 #include <QPalette>
+#include <QPixmap>
+#include <QTimer>
 #include <QToolButton>
 #include <QUrl>
 #include <QVBoxLayout>
@@ -18,13 +23,17 @@
 #include <QWebEnginePage>
 #include <QWebEngineProfile>
 #include <QWebEngineSettings>
+#include <QWindow>
 #include <QtGlobal>
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <utility>
 
 namespace {
   constexpr int BASE_FRAME_MARGIN = 6;
   constexpr int BASE_FRAME_SPACING = 6;
+  constexpr int SNAPSHOT_AFTER_LOAD_MS = 1500;  // let the page settle before grabbing it
 }
 
 SplitFrameWidget::SplitFrameWidget(int index, QWidget *parent) : QFrame(parent) {
@@ -32,13 +41,8 @@ SplitFrameWidget::SplitFrameWidget(int index, QWidget *parent) : QFrame(parent)
   setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
   // subtle alternating background color based on index
-  QPalette pal = palette();
-  QColor base = palette().color(QPalette::Window);
-  int shift = (index % 2 == 0) ? 6 : -6;
-  QColor bg = base.lighter(100 + shift);
-  pal.setColor(QPalette::Window, bg);
   setAutoFillBackground(true);
-  setPalette(pal);
+  setVisualIndex(index);
 
   innerLayout_ = new QVBoxLayout(this);
   innerLayout_->setContentsMargins(BASE_FRAME_MARGIN, BASE_FRAME_MARGIN, BASE_FRAME_MARGIN, BASE_FRAME_MARGIN);
@@ -139,6 +143,30 @@ SplitFrameWidget::SplitFrameWidget(int index, QWidget *parent) : QFrame(parent)
   webview_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
   innerLayout_->addWidget(webview_, 1);
   registerInteractionTarget(webview_);
+
+  // stands in for the web view while the frame is parked (ScrollGrid off-screen cells)
+  parkedPlaceholder_ = new QLabel(this);
+  parkedPlaceholder_->setAlignment(Qt::AlignCenter);
+  parkedPlaceholder_->setWordWrap(true);
+  parkedPlaceholder_->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
+  parkedPlaceholder_->setScaledContents(true);
+  parkedPlaceholder_->setVisible(false);
+  innerLayout_->addWidget(parkedPlaceholder_, 1);
+
+  // last-known content painted over the web view while it (re)loads;
+  // eventFilter() keeps it sized to the view
+  snapshotOverlay_ = new QLabel(webview_);
+  snapshotOverlay_->setScaledContents(true);
+  snapshotOverlay_->setAttribute(Qt::WA_TransparentForMouseEvents);
+  snapshotOverlay_->setVisible(false);
+
+  // performance HUD strip; FrameMetricsSampler shows it and fills it in
+  perfHud_ = new QLabel(this);
+  perfHud_->setTextFormat(Qt::PlainText);
+  perfHud_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  perfHud_->setToolTip(tr("Renderer process, memory, CPU and load timings for this frame"));
+  perfHud_->setVisible(false);
+  innerLayout_->addWidget(perfHud_);
   registerInteractionTarget(this);
 
   // wire internal UI to emit signals and control webview
@@ -175,14 +203,21 @@ SplitFrameWidget::SplitFrameWidget(int index, QWidget *parent) : QFrame(parent)
     if (!address_->hasFocus()) address_->setCursorPosition(0);
     // update nav button states
     updateNavButtons();
-    // re-apply any DOM patches when the URL changes (helps single-page apps)
+    // re-sync DOM patches when the URL changes (same-document SPA navigations)
     if (webview_ && webview_->page()) applyDomPatchesToPage(webview_->page());
     emit addressEdited(this, s);
   });
-  connect(webview_, &MyWebEngineView::loadStarted, this, [this]() { refreshBtn_->setEnabled(true); });
+  connect(webview_, &MyWebEngineView::loadStarted, this, [this]() {
+    refreshBtn_->setEnabled(true);
+    loading_ = true;
+    emit pageLoadStarted(this);
+  });
   connect(webview_, &MyWebEngineView::loadFinished, this, [this](bool ok) {
-    Q_UNUSED(ok);
     updateNavButtons();
+    loading_ = false;
+    snapshotOverlay_->setVisible(false);
+    if (ok) QTimer::singleShot(SNAPSHOT_AFTER_LOAD_MS, this, [this]() { captureSnapshot(); });
+    emit pageLoadFinished(this, ok);
   });
   connect(webview_, &MyWebEngineView::devToolsRequested, this, [this](QWebEnginePage *page, const QPoint &pos) {
     emit devToolsRequested(this, page, pos);
@@ -193,6 +228,67 @@ SplitFrameWidget::SplitFrameWidget(int index, QWidget *parent) : QFrame(parent)
   connect(webview_, &MyWebEngineView::openLinkInNewFrameRequested, this, [this](const QUrl &url) {
     emit openLinkInNewFrameRequested(this, url);
   });
+  connect(webview_, &MyWebEngineView::linkSpeculationRequested, this, [this](const QUrl &url) {
+    emit linkSpeculationRequested(this, url);
+  });
+  connect(webview_, &MyWebEngineView::linkSpeculationCancelled, this, [this]() {
+    emit linkSpeculationCancelled(this);
+  });
+
+  lastInteraction_.start();
+  FrameHibernationManager::instance().registerFrame(this);
+  FrameMetricsSampler::instance().registerFrame(this);
+}
+
+void SplitFrameWidget::setPerfHudVisible(bool visible) {
+  if (perfHud_) perfHud_->setVisible(visible);
+}
+
+void SplitFrameWidget::setPerfHudText(const QString &text) {
+  if (perfHud_) perfHud_->setText(text);
+}
+
+bool SplitFrameWidget::resetForReuse() {
+  QWebEnginePage *p = page();
+  if (!p || fullScreenWindow_ || p->devToolsPage()) return false;
+  if (p->lifecycleState() != QWebEnginePage::LifecycleState::Active) return false;
+
+  setFrameId(0);
+  setContentParked(false);
+  snapshotOverlay_->setVisible(false);
+  setScaleFactor(1.0);
+  setAutoRefreshHint(0);
+  setAddress(QString()); // navigating away also ends any media playback
+  // the previous site must not be reachable through Back once the blank page is up
+  auto connection = std::make_shared<QMetaObject::Connection>();
+  *connection = connect(webview_, &MyWebEngineView::loadFinished, this, [this, connection](bool) {
+    disconnect(*connection);
+    if (webview_) webview_->history()->clear();
+    updateNavButtons();
+  });
+  lastInteraction_.restart();
+  return true;
+}
+
+void SplitFrameWidget::setAutoRefreshHint(int seconds) {
+  if (!refreshBtn_) return;
+  if (seconds <= 0) {
+    refreshBtn_->setToolTip(tr("Refresh"));
+  } else if (seconds % 60 == 0) {
+    refreshBtn_->setToolTip(tr("Refresh (auto-refreshes every %n minute(s))", nullptr, seconds / 60));
+  } else {
+    refreshBtn_->setToolTip(tr("Refresh (auto-refreshes every %n second(s))", nullptr, seconds));
+  }
+}
+
+void SplitFrameWidget::setVisualIndex(int index) {
+  // derive from the inherited window color so repeated calls don't compound
+  QPalette pal = palette();
+  QColor base = QApplication::palette().color(QPalette::Window);
+  int shift = (index % 2 == 0) ? 6 : -6;
+  QColor bg = base.lighter(100 + shift);
+  pal.setColor(QPalette::Window, bg);
+  setPalette(pal);
 }
 
 QWebEnginePage *SplitFrameWidget::page() const { return webview_ ? webview_->page() : nullptr; }
@@ -207,7 +303,17 @@ void SplitFrameWidget::setAddress(const QString &s) {
     applyAddress(s);
 }
 
+void SplitFrameWidget::setAddressText(const QString &s) {
+  address_->setText(s);
+  if (!address_->hasFocus()) address_->setCursorPosition(0);
+}
+
 void SplitFrameWidget::applyAddress(const QString &s) {
+  if (parked_) {
+    // loaded once the cell scrolls back into view
+    parkedAddress_ = s;
+    return;
+  }
   const QString trimmed = s.trimmed();
   if (trimmed.isEmpty()) {
     // show instruction HTML instead of loading
@@ -261,12 +367,17 @@ bool SplitFrameWidget::eventFilter(QObject *watched, QEvent *event) {
     case QEvent::FocusIn:
     case QEvent::KeyPress:
     case QEvent::Wheel:
+      lastInteraction_.restart();
       emit interactionOccurred(this);
       break;
     default:
       break;
   }
 
+  if (watched == webview_ && event->type() == QEvent::Resize) {
+    snapshotOverlay_->setGeometry(webview_->rect());
+  }
+
   if (watched == address_) {
     if (event->type() == QEvent::FocusOut) {
       // When the user finishes editing (or focus leaves), ensure the
@@ -361,6 +472,71 @@ void SplitFrameWidget::stopMediaPlayback() {
   qDebug() << "SplitFrameWidget::stopMediaPlayback: executed JS to pause all media elements";
 }
 
+bool SplitFrameWidget::isContentVisible() const {
+  if (!webview_ || !webview_->isVisible()) return false;
+  // QSplitter collapses panes by shrinking them rather than hiding them
+  if (webview_->width() <= 1 || webview_->height() <= 1) return false;
+  const QWidget *top = webview_->window();
+  if (top->isMinimized()) return false;
+  if (const QWindow *handle = top->windowHandle()) {
+    // not exposed = fully covered or off-screen on platforms that report occlusion
+    if (!handle->isExposed()) return false;
+  }
+  return true;
+}
+
+void SplitFrameWidget::captureSnapshot() {
+  QWebEnginePage *p = page();
+  if (!p || !SnapshotCache::instance().isEnabled() || loading_ || parked_ || fullScreenWindow_) return;
+  if (p->lifecycleState() != QWebEnginePage::LifecycleState::Active) return;
+  // grab() would include the overlay itself
+  if (!webview_->isVisible() || snapshotOverlay_->isVisible()) return;
+  if (webview_->width() <= 1 || webview_->height() <= 1) return;
+  const QUrl url = p->url();
+  if (url.isEmpty() || url.scheme() == QStringLiteral("data")) return;
+  SnapshotCache::instance().store(p->profile(), url, webview_->grab());
+}
+
+void SplitFrameWidget::showSnapshot(const QString &address) {
+  QWebEnginePage *p = page();
+  const QString trimmed = address.trimmed();
+  if (!p || trimmed.isEmpty()) return;
+  const QPixmap shot = SnapshotCache::instance().lookup(p->profile(), QUrl::fromUserInput(trimmed));
+  if (shot.isNull()) return;
+  snapshotOverlay_->setPixmap(shot);
+  snapshotOverlay_->setGeometry(webview_->rect());
+  snapshotOverlay_->raise();
+  snapshotOverlay_->setVisible(true);
+}
+
+qint64 SplitFrameWidget::msecsSinceInteraction() const { return lastInteraction_.elapsed(); }
+
+void SplitFrameWidget::setContentParked(bool parked) {
+  if (parked == parked_ || !webview_) return;
+  if (parked && fullScreenWindow_) return;
+  parked_ = parked;
+  if (parked) {
+    // grab while the view is still on screen
+    captureSnapshot();
+    snapshotOverlay_->setVisible(false);
+    const QString title = webview_->title();
+    const QString where = address().trimmed();
+    const QPixmap shot = page() ? SnapshotCache::instance().lookup(page()->profile(), QUrl::fromUserInput(where)) : QPixmap();
+    if (!shot.isNull()) {
+      parkedPlaceholder_->setPixmap(shot);
+    } else {
+      parkedPlaceholder_->setText(title.isEmpty() || title == where ? where : QStringLiteral("%1\n%2").arg(title, where));
+    }
+    parkedPlaceholder_->setToolTip(where);
+  }
+  webview_->setVisible(!parked);
+  parkedPlaceholder_->setVisible(parked);
+  if (!parked && parkedAddress_) {
+    const QString pending = *std::exchange(parkedAddress_, std::nullopt);
+    applyAddress(pending);
+  }
+}
+
 void SplitFrameWidget::setProfile(QWebEngineProfile *profile) {
   if (!webview_ || !profile) return;
 
@@ -380,11 +556,10 @@ void SplitFrameWidget::setProfile(QWebEngineProfile *profile) {
     emit openLinkInNewFrameRequested(this, url);
   });
 
-  // Ensure DOM patches are applied on every load for this page.
-  QObject::connect(page, &QWebEnginePage::loadFinished, page, [page](bool) {
-    // apply patches after each load
-    applyDomPatchesToPage(page);
-  });
+  // DOM patches run from the profile's document-creation script; make sure
+  // it is current before the first navigation.
+  prepareDomPatchesForPage(page);
+  MyWebEngineView::installContextMenuHelper(profile);
 
   // Ensure the page has fullscreen support enabled (should be true by default
   // but being explicit helps diagnose platform differences).
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QFrame>
 #include <QPointer>
 #include <QWebEngineFullScreenRequest>
+#include <optional>
 
 class QVBoxLayout;
 class QLineEdit;
@@ -47,6 +49,26 @@ public:
    */
   SplitFrameWidget(int index, QWidget *parent = nullptr);
 
+  /**
+   * @brief Updates the subtle alternating background for a new position.
+   * @param index The frame's visual index (even/odd selects the shade)
+   *
+   * Called when frames are reordered without being recreated.
+   */
+  void setVisualIndex(int index);
+
+  /**
+   * @brief Returns the stable ID assigned by the owning window's FrameRegistry.
+   * @return The ID, or 0 while the frame belongs to no window (e.g. pooled spares)
+   */
+  quint64 frameId() const { return frameId_; }
+
+  /**
+   * @brief Records the frame's registry ID; called by FrameRegistry::insert().
+   * @param id The new ID (0 clears it)
+   */
+  void setFrameId(quint64 id) { frameId_ = id; }
+
   /**
    * @brief Returns the QWebEnginePage for this frame.
    * @return Pointer to the web page, or nullptr if not initialized
@@ -64,6 +86,15 @@ public:
    * @param s The address or URL to display
    */
   void setAddress(const QString &s);
+
+  /**
+   * @brief Shows an address in the address bar without loading it.
+   * @param s The address or URL to display
+   *
+   * Used by RestoreScheduler so restored frames show their address while
+   * the page waits for a load slot.
+   */
+  void setAddressText(const QString &s);
   
   /**
    * @brief Loads the given address in the web view.
@@ -156,6 +187,88 @@ public:
    */
   void stopMediaPlayback();
 
+  /**
+   * @brief Returns whether the web content is currently visible to the user.
+   * @return false if the view is hidden, collapsed to zero size, or its window is minimized/not exposed
+   *
+   * Used by FrameHibernationManager to decide when a page may be frozen or discarded.
+   * Follows the web view rather than this frame so a frame shown fullscreen stays visible.
+   */
+  bool isContentVisible() const;
+
+  /**
+   * @brief Stores a downscaled grab of the web view in SnapshotCache.
+   *
+   * Skipped unless the view is visible with a loaded, Active page (hidden
+   * widgets do not grab reliably), so a good snapshot is never replaced by a
+   * blank one. Called before freezing or parking, after loads and on close.
+   */
+  void captureSnapshot();
+
+  /**
+   * @brief Paints the cached snapshot of an address over the web view until the next load finishes.
+   * @param address Address about to be loaded (session restore, waking a discarded page)
+   *
+   * A no-op when nothing is cached for the address. The overlay ignores the
+   * mouse, so the page underneath stays usable once it starts painting.
+   */
+  void showSnapshot(const QString &address);
+
+  /**
+   * @brief Replaces the web view with a lightweight placeholder (or brings it back).
+   * @param parked true to hide the web view and show the placeholder
+   *
+   * Used by the ScrollGrid layout for cells scrolled away from the viewport.
+   * A parked frame reports isContentVisible() false, and addresses applied
+   * while parked are loaded when it is unparked. The placeholder shows the
+   * page's cached snapshot, or its title and address. Ignored while fullscreen.
+   */
+  void setContentParked(bool parked);
+
+  /**
+   * @brief Returns whether the web view is replaced by the placeholder.
+   * @return true while parked via setContentParked()
+   */
+  bool isContentParked() const { return parked_; }
+
+  /**
+   * @brief Returns the time since the last user interaction with this frame.
+   * @return Milliseconds since interactionOccurred was last emitted (or since construction)
+   */
+  qint64 msecsSinceInteraction() const;
+
+  /**
+   * @brief Shows or hides the performance HUD strip below the web view.
+   * @param visible true to show the strip
+   *
+   * Driven by FrameMetricsSampler; frames never sample on their own.
+   */
+  void setPerfHudVisible(bool visible);
+
+  /**
+   * @brief Replaces the text of the performance HUD strip.
+   * @param text Formatted metrics line from FrameMetricsSampler
+   */
+  void setPerfHudText(const QString &text);
+
+  /**
+   * @brief Clears this frame so FramePool can hand it to another window.
+   * @return false if the frame can't be reused (fullscreen, DevTools attached, page not active)
+   *
+   * Shows the instruction page (keeping the page and its renderer process),
+   * clears the address, scale and back/forward history. The caller must
+   * disconnect its own signal connections first.
+   */
+  bool resetForReuse();
+
+  /**
+   * @brief Shows the auto-refresh interval in the refresh button's tooltip.
+   * @param seconds Interval in seconds; 0 restores the plain tooltip
+   *
+   * Display only; RefreshScheduler performs the reloads.
+   */
+  void setAutoRefreshHint(int seconds);
+
 private slots:
   /**
    * @brief Handles HTML5 fullscreen requests from the page.
@@ -220,6 +333,19 @@ signals:
    * @param linkUrl The URL to open in a new frame
    */
   void openLinkInNewFrameRequested(SplitFrameWidget *who, const QUrl &linkUrl);
+
+  /**
+   * @brief Relays MyWebEngineView::linkSpeculationRequested (context menu opened over a link).
+   * @param who Pointer to this frame widget
+   * @param linkUrl The link under the cursor
+   */
+  void linkSpeculationRequested(SplitFrameWidget *who, const QUrl &linkUrl);
+
+  /**
+   * @brief Relays MyWebEngineView::linkSpeculationCancelled.
+   * @param who Pointer to this frame widget
+   */
+  void linkSpeculationCancelled(SplitFrameWidget *who);
   
   /**
    * @brief Emitted when the frame's scale changes.
@@ -234,6 +360,19 @@ signals:
    */
   void interactionOccurred(SplitFrameWidget *who);
 
+  /**
+   * @brief Emitted when the web view starts loading a page.
+   * @param who Pointer to this frame widget
+   */
+  void pageLoadStarted(SplitFrameWidget *who);
+
+  /**
+   * @brief Emitted when the web view finishes loading a page.
+   * @param who Pointer to this frame widget
+   * @param ok Whether the load succeeded
+   */
+  void pageLoadFinished(SplitFrameWidget *who, bool ok);
+
 private:
   /**
    * @brief Installs an event filter on a child widget to detect interactions.
@@ -254,6 +393,13 @@ private:
   QToolButton *scaleDownBtn_ = nullptr; ///< Scale down button
   QToolButton *scaleUpBtn_ = nullptr;   ///< Scale up button
   QToolButton *scaleResetBtn_ = nullptr; ///< Reset scale button
+  QLabel *perfHud_ = nullptr;           ///< Performance HUD strip (hidden unless perfHud/enabled)
+  QLabel *parkedPlaceholder_ = nullptr; ///< Shown instead of the web view while parked
+  bool parked_ = false;                 ///< setContentParked() state
+  std::optional<QString> parkedAddress_; ///< Address applied while parked, loaded on unpark
+  QLabel *snapshotOverlay_ = nullptr;   ///< Cached snapshot painted over the web view until a load finishes
+  bool loading_ = false;                ///< Between loadStarted and loadFinished
+  quint64 frameId_ = 0;                 ///< FrameRegistry ID, 0 when in no window
 
   /** @brief Top-level window created for fullscreen mode */
   QPointer<QWidget> fullScreenWindow_;
@@ -270,6 +416,9 @@ private:
   /** @brief Previous window state to restore after exiting fullscreen */
   Qt::WindowStates previousTopWindowState_ = Qt::WindowNoState;
 
+  /** @brief Restarted whenever interactionOccurred is emitted */
+  QElapsedTimer lastInteraction_;
+
   /** @brief Current scale factor applied to web content */
   double scaleFactor_ = 1.0;
 
@@ -1,16 +1,25 @@
 #include "AppSettings.h"
+#include "ContentBlocker.h"
+#include "DevToolsHost.h"
 #include "DomPatch.h"
-#include "MyWebEnginePage.h"
+#include "EngineConfig.h"
+#include "FrameHibernation.h"
+#include "FrameMetrics.h"
+#include "FramePool.h"
+#include "ProfileCacheDialog.h"
+#include "RefreshScheduler.h"
+#include "RestoreScheduler.h"
+#include "SessionStore.h"
 #include "SplitFrameWidget.h"
-#include "SplitterDoubleClickFilter.h"
 #include "SplitWindow.h"
+#include "Trace.h"
 #include "UpdateChecker.h"
 #include "UpdateDialog.h"
 #include "Utils.h"
 #include "version.h"
+#include "WindowListModel.h"
 #include <algorithm>
 #include <cmath>
-#include <limits>
 #include <QAction>
 #include <QActionGroup>
 #include <QApplication>
@@ -20,7 +29,10 @@
 #include <QDesktopServices>
 #include <QDialog>
 #include <QDialogButtonBox>
+#include <QDateTime>
 #include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QFrame>
 #include <QGridLayout>
 #include <QGuiApplication>
@@ -28,11 +40,13 @@
 #include <QKeySequence>
 #include <QLabel>
 #include <QLineEdit>
+#include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPointer>
 #include <QScreen>
 #include <QScrollArea>
+#include <QScrollBar>
 #include <QSplitter>
 #include <QStandardPaths>
 #include <QTextBrowser>
@@ -43,7 +57,7 @@
 #include <QVBoxLayout>
 #include <QWebEnginePage>
 #include <QWebEngineProfile>
-#include <QWebEngineView>
+#include <utility>
 
 bool DEBUG_SHOW_WINDOW_ID = 0;
 
@@ -55,6 +69,22 @@ namespace {
   // About dialog dimensions
   constexpr int ABOUT_DIALOG_MIN_WIDTH = 400;     // minimum width for About dialog
   constexpr int ABOUT_DIALOG_MAX_HEIGHT = 300;    // maximum height for text browser in About dialog
+
+  // View -> Auto Refresh Frame choices (seconds; 0 = off)
+  constexpr int AUTO_REFRESH_CHOICES_SECONDS[] = {0, 30, 60, 300, 900, 3600};
+
+  constexpr int SESSION_SAVE_DELAY_MS = 2000;     // coalesces live changes into one session journal record
+
+  // Layout -> Scrollable Grid
+  constexpr int DEFAULT_SCROLL_GRID_COLUMNS = 4;
+  constexpr int MAX_SCROLL_GRID_COLUMNS = 12;
+  constexpr int DEFAULT_SCROLL_GRID_ROW_HEIGHT = 320; // pixels per row
+  constexpr int MIN_SCROLL_GRID_ROW_HEIGHT = 120;
+  constexpr int SCROLL_GRID_MARGIN_ROWS = 1;          // rows kept live above and below the viewport
+  constexpr int VIEWPORT_UPDATE_DELAY_MS = 100;       // coalesces scroll events into one park/unpark pass
+
+  // Layout -> Splitter Resizing (Snapshot mode)
+  constexpr int MAX_SPLITTER_RESIZE_INTERVAL_MS = 1000;
 }
 
 
@@ -100,10 +130,9 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
     qDebug() << "SplitWindow: using Incognito profile" << profile_
              << "offTheRecord=" << profile_->isOffTheRecord();
   } else if (!windowId_.isEmpty()) {
-    // Normal window with saved state: load profile from settings
-    AppSettings s;
-    GroupScope _gs(s, QStringLiteral("windows/%1").arg(windowId_));
-    currentProfileName_ = s->value("profileName", currentProfileName()).toString();
+    // Normal window with saved state: load profile from the session
+    const SessionWindowState *saved = SessionStore::instance().window(windowId_);
+    currentProfileName_ = (saved && !saved->profileName.isEmpty()) ? saved->profileName : currentProfileName();
     profile_ = getProfileByName(currentProfileName_);
     qDebug() << "SplitWindow: using profile" << currentProfileName_ << profile_
              << "storage=" << profile_->persistentStoragePath();
@@ -136,6 +165,61 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   reloadBypassAction->setShortcutContext(Qt::WindowShortcut);
   connect(reloadBypassAction, &QAction::triggered, this, &SplitWindow::reloadFocusedFrameBypassingCache);
 
+  QAction *reloadAllAction = viewMenu->addAction(tr("Reload All Frames"));
+  connect(reloadAllAction, &QAction::triggered, this, [this]() { reloadAllFrames(false); });
+
+  // Per-frame auto-refresh for dashboards; RefreshScheduler staggers the reloads
+  QMenu *autoRefreshMenu = viewMenu->addMenu(tr("Auto Refresh Frame"));
+  auto *autoRefreshGroup = new QActionGroup(autoRefreshMenu);
+  // custom intervals from settings.ini match no entry, so allow none checked
+  autoRefreshGroup->setExclusionPolicy(QActionGroup::ExclusionPolicy::ExclusiveOptional);
+  for (int seconds : AUTO_REFRESH_CHOICES_SECONDS) {
+    QString label;
+    if (seconds == 0) label = tr("Off");
+    else if (seconds < 60) label = tr("Every %n second(s)", nullptr, seconds);
+    else if (seconds < 3600) label = tr("Every %n minute(s)", nullptr, seconds / 60);
+    else label = tr("Every %n hour(s)", nullptr, seconds / 3600);
+    QAction *action = autoRefreshMenu->addAction(label);
+    action->setCheckable(true);
+    action->setData(seconds);
+    autoRefreshGroup->addAction(action);
+    connect(action, &QAction::triggered, this, [this, seconds]() { setFocusedFrameRefreshInterval(seconds); });
+  }
+  // What this window's pages do while it is minimized, hidden, or covered
+  QMenu *backgroundMenu = viewMenu->addMenu(tr("When in Background"));
+  auto *backgroundGroup = new QActionGroup(backgroundMenu);
+  const QList<QPair<QString, QString>> backgroundChoices = {
+    {QString(), tr("Use Default")},
+    {FrameHibernationManager::policyKey(FrameHibernationManager::BackgroundPolicy::Throttle), tr("Throttle Hidden Pages")},
+    {FrameHibernationManager::policyKey(FrameHibernationManager::BackgroundPolicy::Freeze), tr("Freeze Pages Immediately")},
+    {FrameHibernationManager::policyKey(FrameHibernationManager::BackgroundPolicy::KeepLive), tr("Keep Pages Running")},
+  };
+  for (const auto &choice : backgroundChoices) {
+    QAction *action = backgroundMenu->addAction(choice.second);
+    action->setCheckable(true);
+    action->setData(choice.first);
+    backgroundGroup->addAction(action);
+    const QString key = choice.first;
+    connect(action, &QAction::triggered, this, [this, key]() { setBackgroundPolicy(key); });
+  }
+  backgroundMenu->addSeparator();
+  QAction *keepAliveAction = backgroundMenu->addAction(tr("Keep This Frame Live"));
+  keepAliveAction->setCheckable(true);
+  keepAliveAction->setToolTip(tr("Never throttle or freeze the focused frame (audio, live feeds)"));
+  connect(keepAliveAction, &QAction::triggered, this, &SplitWindow::setFocusedFrameKeepAlive);
+  connect(backgroundMenu, &QMenu::aboutToShow, this, [this, backgroundGroup, keepAliveAction]() {
+    for (QAction *action : backgroundGroup->actions()) action->setChecked(action->data().toString() == backgroundPolicyKey_);
+    const int pos = frameIndexFor(focusedFrameOrFirst());
+    keepAliveAction->setChecked(pos >= 0 && pos < (int)frames_.size() && frames_[pos].keepAlive);
+  });
+
+  connect(autoRefreshMenu, &QMenu::aboutToShow, this, [this, autoRefreshGroup]() {
+    SplitFrameWidget *frame = focusedFrameOrFirst();
+    const int pos = frameIndexFor(frame);
+    const int current = (pos >= 0 && pos < (int)frames_.size()) ? frames_[pos].refreshSeconds : 0;
+    for (QAction *action : autoRefreshGroup->actions()) action->setChecked(action->data().toInt() == current);
+  });
+
   viewMenu->addSeparator();
   QAction *increaseScaleAction = viewMenu->addAction(tr("Increase Frame Scale"));
   connect(increaseScaleAction, &QAction::triggered, this, &SplitWindow::increaseFocusedFrameScale);
@@ -143,6 +227,12 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   connect(decreaseScaleAction, &QAction::triggered, this, &SplitWindow::decreaseFocusedFrameScale);
   QAction *resetScaleAction = viewMenu->addAction(tr("Reset Frame Scale"));
   connect(resetScaleAction, &QAction::triggered, this, &SplitWindow::resetFocusedFrameScale);
+  QMenu *scaleAllMenu = viewMenu->addMenu(tr("Scale All Frames"));
+  connect(scaleAllMenu->addAction(tr("Increase")), &QAction::triggered, this,
+          [this]() { adjustAllFramesScale(SplitFrameWidget::kScaleStep); });
+  connect(scaleAllMenu->addAction(tr("Decrease")), &QAction::triggered, this,
+          [this]() { adjustAllFramesScale(-SplitFrameWidget::kScaleStep); });
+  connect(scaleAllMenu->addAction(tr("Reset")), &QAction::triggered, this, [this]() { setAllFramesScale(1.0); });
 
   // Always-on-top toggle
   QAction *alwaysOnTopAction = viewMenu->addAction(tr("Always on Top"));
@@ -162,13 +252,25 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
     s->setValue("alwaysOnTop", checked);
   });
 
-  // Layout menu: Grid, Stack Vertically, Stack Horizontally
+  QAction *perfHudAction = viewMenu->addAction(tr("Performance HUD"));
+  perfHudAction->setCheckable(true);
+  perfHudAction->setChecked(FrameMetricsSampler::instance().isEnabled());
+  connect(perfHudAction, &QAction::toggled, this, [](bool checked) {
+    FrameMetricsSampler::instance().setEnabled(checked);
+  });
+  // keep every window's checkmark in sync with the shared sampler
+  connect(&FrameMetricsSampler::instance(), &FrameMetricsSampler::enabledChanged, perfHudAction, &QAction::setChecked);
+
+  // Layout menu: Grid, Scrollable Grid, Stack Vertically, Stack Horizontally
   auto *layoutMenu = menuBar()->addMenu(tr("Layout"));
   QActionGroup *layoutGroup = new QActionGroup(this);
   layoutGroup->setExclusive(true);
   QAction *gridAction = layoutMenu->addAction(tr("Grid"));
   gridAction->setCheckable(true);
   layoutGroup->addAction(gridAction);
+  QAction *scrollGridAction = layoutMenu->addAction(tr("Scrollable Grid"));
+  scrollGridAction->setCheckable(true);
+  layoutGroup->addAction(scrollGridAction);
   QAction *verticalAction = layoutMenu->addAction(tr("Stack Vertically"));
   verticalAction->setCheckable(true);
   layoutGroup->addAction(verticalAction);
@@ -181,18 +283,74 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   layoutMode_ = (LayoutMode)storedMode;
   switch (layoutMode_) {
     case Grid: gridAction->setChecked(true); break;
+    case ScrollGrid: scrollGridAction->setChecked(true); break;
     case Horizontal: horizontalAction->setChecked(true); break;
     case Vertical: default: verticalAction->setChecked(true); break;
   }
 
   connect(gridAction, &QAction::triggered, this, [this]() { setLayoutMode(Grid); });
+  connect(scrollGridAction, &QAction::triggered, this, [this]() { setLayoutMode(ScrollGrid); });
+  scrollGridColumns_ = std::clamp(settings->value("layout/scrollGridColumns", DEFAULT_SCROLL_GRID_COLUMNS).toInt(),
+                                  1, MAX_SCROLL_GRID_COLUMNS);
+  scrollGridRowHeight_ = std::max(MIN_SCROLL_GRID_ROW_HEIGHT,
+                                  settings->value("layout/scrollGridRowHeight", DEFAULT_SCROLL_GRID_ROW_HEIGHT).toInt());
   connect(verticalAction, &QAction::triggered, this, [this]() { setLayoutMode(Vertical); });
   connect(horizontalAction, &QAction::triggered, this, [this]() { setLayoutMode(Horizontal); });
 
+  // Layout -> Splitter Resizing: live (Qt opaque resize), outline only, or snapshot preview
+  splitterResizeMode_ = SplitterDoubleClickFilter::resizeModeFromKey(
+    settings->value("layout/splitterResizeMode", QStringLiteral("opaque")).toString());
+  splitterResizeIntervalMs_ = std::clamp(settings->value("layout/splitterResizeIntervalMs", 0).toInt(),
+                                         0, MAX_SPLITTER_RESIZE_INTERVAL_MS);
+  layoutMenu->addSeparator();
+  QMenu *resizeMenu = layoutMenu->addMenu(tr("Splitter Resizing"));
+  QActionGroup *resizeGroup = new QActionGroup(this);
+  resizeGroup->setExclusive(true);
+  const std::pair<SplitterResizeMode, QString> resizeChoices[] = {
+    {SplitterResizeMode::Opaque, tr("Live")},
+    {SplitterResizeMode::Outline, tr("Outline Only")},
+    {SplitterResizeMode::Snapshot, tr("Snapshot Preview")},
+  };
+  for (const auto &[mode, label] : resizeChoices) {
+    QAction *action = resizeMenu->addAction(label);
+    action->setCheckable(true);
+    action->setData(SplitterDoubleClickFilter::resizeModeKey(mode));
+    resizeGroup->addAction(action);
+    connect(action, &QAction::triggered, this, [mode = mode]() {
+      AppSettings s;
+      s->setValue("layout/splitterResizeMode", SplitterDoubleClickFilter::resizeModeKey(mode));
+      // one preference for all windows
+      for (SplitWindow *w : g_windows) w->setSplitterResizeMode(mode);
+    });
+  }
+  connect(resizeMenu, &QMenu::aboutToShow, this, [this, resizeGroup]() {
+    const QString current = SplitterDoubleClickFilter::resizeModeKey(splitterResizeMode_);
+    for (QAction *action : resizeGroup->actions()) action->setChecked(action->data().toString() == current);
+  });
+
   // Tools menu: DOM patches manager
   auto *toolsMenu = menuBar()->addMenu(tr("Tools"));
   QAction *domPatchesAction = toolsMenu->addAction(tr("DOM Patches"));
   connect(domPatchesAction, &QAction::triggered, this, &SplitWindow::showDomPatchesManager);
+  QAction *perfSummaryAction = toolsMenu->addAction(tr("Frame Performance..."));
+  connect(perfSummaryAction, &QAction::triggered, this, [this]() {
+    auto *dlg = new FramePerfSummaryDialog(this);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    dlg->show();
+  });
+  QAction *exportPerfAction = toolsMenu->addAction(tr("Export Performance Log..."));
+  exportPerfAction->setEnabled(FrameMetricsSampler::instance().isLogEnabled());
+  connect(exportPerfAction, &QAction::triggered, this, &SplitWindow::exportPerformanceLog);
+  QAction *reloadFiltersAction = toolsMenu->addAction(tr("Reload Content Filters"));
+  reloadFiltersAction->setEnabled(ContentBlocker::instance().isEnabled());
+  connect(reloadFiltersAction, &QAction::triggered, this, []() { ContentBlocker::instance().reload(); });
+  QAction *engineSettingsAction = toolsMenu->addAction(tr("Engine Settings..."));
+  engineSettingsAction->setMenuRole(QAction::NoRole);
+  connect(engineSettingsAction, &QAction::triggered, this, [this]() {
+    auto *dlg = new EngineSettingsDialog(this);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    dlg->show();
+  });
 
   // Profiles menu: manage browser profiles (not available in Incognito mode)
   if (!isIncognito_) {
@@ -205,6 +363,14 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
     
     QAction *deleteProfileAction = profilesMenu_->addAction(tr("Delete Profile..."));
     connect(deleteProfileAction, &QAction::triggered, this, &SplitWindow::deleteSelectedProfile);
+
+    QAction *cacheSettingsAction = profilesMenu_->addAction(tr("Cache Settings..."));
+    cacheSettingsAction->setMenuRole(QAction::NoRole);
+    connect(cacheSettingsAction, &QAction::triggered, this, [this]() {
+      auto *dlg = new ProfileCacheDialog(currentProfileName_, this);
+      dlg->setAttribute(Qt::WA_DeleteOnClose);
+      dlg->show();
+    });
     
     profilesMenu_->addSeparator();
     
@@ -235,6 +401,20 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   closeAct->setShortcut(QKeySequence::Close);
   connect(closeAct, &QAction::triggered, this, &SplitWindow::onCloseShortcut);
   windowMenu_->addSeparator();
+  // The window list below the separator mirrors the shared WindowListModel
+  // and is patched row by row as windows change.
+  WindowListModel &windowList = WindowListModel::instance();
+  connect(&windowList, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+    insertWindowMenuEntries(first, last);
+  });
+  connect(&windowList, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+    removeWindowMenuEntries(first, last);
+  });
+  connect(&windowList, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+    updateWindowMenuEntries(topLeft.row(), bottomRight.row());
+  });
+  connect(&windowList, &QAbstractItemModel::modelReset, this, &SplitWindow::updateWindowMenu);
+  updateWindowMenu();
 
   // Help menu: Check for Updates and About dialog
   auto *helpMenu = menuBar()->addMenu(tr("Help"));
@@ -255,7 +435,8 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   layout_->setContentsMargins(4, 4, 4, 4);
   layout_->setSpacing(6);
 
-  auto loadFrameState = [this](const QStringList &addresses, const QVariantList &scales) {
+  auto loadFrameState = [this](const QStringList &addresses, const QVariantList &scales, const QVariantList &intervals,
+                               const QVariantList &keepAlive) {
     frames_.clear();
     if (addresses.isEmpty()) {
       frames_.push_back(FrameState());
@@ -271,35 +452,57 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
     for (int i = 0; i < (int)frames_.size(); ++i) {
       double value = (i < scales.size()) ? scales[i].toDouble() : 1.0;
       frames_[i].scale = std::clamp(value, SplitFrameWidget::kMinScaleFactor, SplitFrameWidget::kMaxScaleFactor);
+      frames_[i].refreshSeconds = (i < intervals.size()) ? std::max(0, intervals[i].toInt()) : 0;
+      frames_[i].keepAlive = (i < keepAlive.size()) && keepAlive[i].toBool();
     }
   };
 
   // load persisted addresses (per-window if windowId_ present and not Incognito, otherwise global)
+  traceInstant("SplitWindow: menus built", windowId_);
   if (isIncognito_) {
     // Incognito windows always start with a single empty frame
-    loadFrameState(QStringList(), QVariantList());
+    loadFrameState(QStringList(), QVariantList(), QVariantList(), QVariantList());
   } else if (!windowId_.isEmpty()) {
-    AppSettings s;
-    {
-      GroupScope _gs(s, QStringLiteral("windows/%1").arg(windowId_));
-      const QStringList savedAddresses = s->value("addresses").toStringList();
-      const QVariantList savedScales = s->value("frameScales").toList();
-      loadFrameState(savedAddresses, savedScales);
-      layoutMode_ = (LayoutMode)s->value("layoutMode", (int)layoutMode_).toInt();
+    if (const SessionWindowState *saved = SessionStore::instance().window(windowId_)) {
+      QStringList savedAddresses;
+      QVariantList savedScales;
+      QVariantList savedIntervals;
+      QVariantList savedKeepAlive;
+      for (const SessionFrameState &f : saved->frames) {
+        savedAddresses << f.address;
+        savedScales << f.scale;
+        savedIntervals << f.refreshSeconds;
+        savedKeepAlive << f.keepAlive;
+      }
+      loadFrameState(savedAddresses, savedScales, savedIntervals, savedKeepAlive);
+      backgroundPolicyKey_ = saved->backgroundPolicy;
+      layoutMode_ = (LayoutMode)saved->layoutMode;
+      restoreFocusIndex_ = saved->focusedFrameIndex;
+    } else {
+      loadFrameState(QStringList(), QVariantList(), QVariantList(), QVariantList());
     }
+    // During session restore, hand initial page loads to the scheduler so
+    // the focused/visible frames load first instead of all at once.
+    deferFrameLoads_ = RestoreScheduler::instance().isRestoring();
   } else {
-    const QStringList savedAddresses = settings->value("addresses").toStringList();
-    const QVariantList savedScales = settings->value("frameScales").toList();
-    loadFrameState(savedAddresses, savedScales);
+    // root frame state is written behind; read through the pending values
+    const QStringList savedAddresses = AppSettings::deferredValue(QStringLiteral("addresses")).toStringList();
+    const QVariantList savedScales = AppSettings::deferredValue(QStringLiteral("frameScales")).toList();
+    const QVariantList savedIntervals = AppSettings::deferredValue(QStringLiteral("frameRefreshIntervals")).toList();
+    const QVariantList savedKeepAlive = AppSettings::deferredValue(QStringLiteral("frameKeepAlive")).toList();
+    loadFrameState(savedAddresses, savedScales, savedIntervals, savedKeepAlive);
   }
   // build initial UI
   rebuildSections((int)frames_.size());
+  deferFrameLoads_ = false;
   // restore splitter sizes only once at startup (subsequent layout
   // selections/rebuilds should reset splitters to defaults)
   // Incognito windows skip splitter size restoration
   if (!isIncognito_) {
     if (!windowId_.isEmpty()) {
-      restoreSplitterSizes(QStringLiteral("windows/%1/splitterSizes").arg(windowId_));
+      if (const SessionWindowState *saved = SessionStore::instance().window(windowId_)) {
+        restoreSplitterSizes(saved->splitterSizes.value(layoutModeKey(layoutMode_)));
+      }
     } else {
       restoreSplitterSizes();
     }
@@ -310,13 +513,9 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   // Incognito windows skip geometry restoration
   if (!isIncognito_) {
     if (!windowId_.isEmpty()) {
-      AppSettings s;
-      {
-        GroupScope _gs(s, QStringLiteral("windows/%1").arg(windowId_));
-        const QByteArray savedGeom = s->value("windowGeometry").toByteArray();
-        if (!savedGeom.isEmpty()) restoreGeometry(savedGeom);
-        const QByteArray savedState = s->value("windowState").toByteArray();
-        if (!savedState.isEmpty()) restoreState(savedState);
+      if (const SessionWindowState *saved = SessionStore::instance().window(windowId_)) {
+        if (!saved->geometry.isEmpty()) restoreGeometry(saved->geometry);
+        if (!saved->windowState.isEmpty()) restoreState(saved->windowState);
       }
     } else {
       const QByteArray savedGeom = settings->value("windowGeometry").toByteArray();
@@ -328,37 +527,65 @@ SplitWindow::SplitWindow(const QString &windowId, bool isIncognito, QWidget *par
   
   // Initialize the Profiles menu with the current profile list
   updateProfilesMenu();
+
+  // Have a spare frame ready for this profile once the app goes idle
+  FramePool::instance().prewarm(profile_);
+
+  auto &hibernation = FrameHibernationManager::instance();
+  hibernation.setWindowPolicy(this, FrameHibernationManager::policyFromKey(backgroundPolicyKey_, hibernation.defaultPolicy()));
 }
 
 void SplitWindow::savePersistentStateToSettings() {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::savePersistentStateToSettings");
   // Incognito windows should never persist state
   if (isIncognito_) {
     qDebug() << "savePersistentStateToSettings: skipping save for Incognito window";
     return;
   }
   
-  AppSettings s;
   QString id = windowId_;
   if (id.isEmpty()) id = QUuid::createUuid().toString();
   qDebug() << "savePersistentStateToSettings: saving window id=" << id << " addresses.count=" << frames_.size() << " layoutMode=" << (int)layoutMode_ << " profile=" << currentProfileName_;
-  {
-    GroupScope _gs(s, QStringLiteral("windows/%1").arg(id));
-    QStringList addressList;
-    QVariantList scaleList;
-    for (const auto &state : frames_) {
-      addressList << state.address;
-      scaleList << state.scale;
-    }
-    s->setValue("addresses", addressList);
-    s->setValue("frameScales", scaleList);
-    s->setValue("profileName", currentProfileName_);
-    s->setValue("layoutMode", (int)layoutMode_);
-    s->setValue("windowGeometry", saveGeometry());
-    s->setValue("windowState", saveState());
+  if (sessionSaveTimer_) sessionSaveTimer_->stop();
+  SessionStore::instance().saveWindow(sessionState(id));
+}
+
+SessionWindowState SplitWindow::sessionState(const QString &id) const {
+  SessionWindowState state;
+  if (const SessionWindowState *saved = SessionStore::instance().window(id)) {
+    // keep the sizes remembered for the other layouts
+    state.splitterSizes = saved->splitterSizes;
+  }
+  state.id = id;
+  state.profileName = currentProfileName_;
+  state.layoutMode = (int)layoutMode_;
+  state.backgroundPolicy = backgroundPolicyKey_;
+  state.geometry = saveGeometry();
+  state.windowState = saveState();
+  state.focusedFrameIndex = frameIndexFor(lastFocusedFrame_);
+  state.frames.reserve((int)frames_.size());
+  for (const auto &frame : frames_) {
+    SessionFrameState f;
+    f.address = frame.address;
+    f.scale = frame.scale;
+    f.refreshSeconds = frame.refreshSeconds;
+    f.keepAlive = frame.keepAlive;
+    state.frames << f;
+  }
+  if (!currentSplitters_.empty()) state.splitterSizes.insert(layoutModeKey(layoutMode_), currentSplitterSizes());
+  return state;
+}
+
+void SplitWindow::scheduleSessionSave() {
+  if (isIncognito_ || windowId_.isEmpty()) return;
+  if (!sessionSaveTimer_) {
+    sessionSaveTimer_ = new QTimer(this);
+    sessionSaveTimer_->setSingleShot(true);
+    sessionSaveTimer_->setInterval(SESSION_SAVE_DELAY_MS);
+    connect(sessionSaveTimer_, &QTimer::timeout, this, &SplitWindow::savePersistentStateToSettings);
   }
-  s->sync();
-  // persist splitter sizes under windows/<id>/splitterSizes/<index>
-  saveCurrentSplitterSizes(QStringLiteral("windows/%1/splitterSizes").arg(id));
+  // restart: a burst of navigations/resizes produces one journal record
+  sessionSaveTimer_->start();
 }
 
 void SplitWindow::resetToSingleEmptySection() {
@@ -375,9 +602,8 @@ void SplitWindow::resetToSingleEmptySection() {
 void SplitWindow::refreshWindowMenu() { updateWindowMenu(); }
 
 void SplitWindow::focusFirstAddress() {
-  if (!central_) return;
-  // Find the first SplitFrameWidget and its QLineEdit child
-  SplitFrameWidget *frame = central_->findChild<SplitFrameWidget *>();
+  // Find the first SplitFrameWidget (in logical order) and its QLineEdit child
+  SplitFrameWidget *frame = firstFrameWidget();
   if (!frame) return;
   QLineEdit *le = frame->findChild<QLineEdit *>();
   if (!le) return;
@@ -402,11 +628,82 @@ void SplitWindow::updateWindowTitle() {
 }
 
 void SplitWindow::setFirstFrameAddress(const QString &address) {
-  SplitFrameWidget *frame = central_ ? central_->findChild<SplitFrameWidget *>() : nullptr;
-  if (frame) frame->setAddress(address);
+  if (SplitFrameWidget *frame = firstFrameWidget()) frame->setAddress(address);
+}
+
+void SplitWindow::openFrames(const QStringList &urls, const QString &layoutKey, const QString &profileName) {
+  PHRAIMS_TRACE_SCOPE_DETAIL("SplitWindow::openFrames", windowId_);
+  qDebug() << "openFrames:" << urls.size() << "URL(s) layout=" << layoutKey << "profile=" << profileName;
+  FrameBatch batch(this);
+
+  bool profileChanged = false;
+  if (!profileName.isEmpty() && !isIncognito_ && profileName != currentProfileName_) {
+    if (listProfiles().contains(profileName)) {
+      adoptProfile(profileName);
+      profileChanged = true;
+    } else {
+      qWarning() << "openFrames: unknown profile" << profileName << "- keeping" << currentProfileName_;
+    }
+  }
+
+  bool layoutChanged = false;
+  if (!layoutKey.isEmpty()) {
+    bool ok = false;
+    const LayoutMode m = layoutModeFromKey(layoutKey, &ok);
+    if (!ok) {
+      qWarning() << "openFrames: unknown layout" << layoutKey;
+    } else if (m != layoutMode_) {
+      // same as setLayoutMode(), minus the relayout done below
+      AppSettings settings;
+      settings->remove(QStringLiteral("splitterSizes/%1").arg(layoutModeKey(m)));
+      layoutMode_ = m;
+      settings->setValue("layoutMode", (int)layoutMode_);
+      layoutChanged = true;
+    }
+  }
+
+  // A window that only shows the instruction page takes the first URL in
+  // its existing frame rather than keeping an empty frame next to the rest.
+  const bool reuseEmpty = !urls.isEmpty() && frames_.size() == 1 && frames_[0].address.trimmed().isEmpty()
+                          && frameRegistry_.size() == 1;
+  const int firstNew = (int)frames_.size();
+  for (int i = 0; i < urls.size(); ++i) {
+    if (i == 0 && reuseEmpty) {
+      frames_[0].address = urls[0];
+      continue;
+    }
+    FrameState state;
+    state.address = urls[i];
+    frames_.push_back(state);
+  }
+  if (!urls.isEmpty()) persistGlobalFrameState();
+
+  if (profileChanged) {
+    rebuildSections((int)frames_.size());
+    savePersistentStateToSettings();
+    return;
+  }
+  if (reuseEmpty) frameRegistry_.first()->setAddress(urls[0]);
+  for (int i = firstNew; i < (int)frames_.size(); ++i) {
+    SplitFrameWidget *frame = createFrameWidget(i);
+    frame->setAddress(frames_[i].address);
+    frameRegistry_.append(frame);
+  }
+  if ((int)frames_.size() == firstNew && !layoutChanged) return;
+
+  requestRelayout();
+  requestRenumber();
+  requestWindowListRefresh();
+}
+
+QString SplitWindow::frameAddress(SplitFrameWidget *frame) const {
+  const int idx = frameIndexFor(frame);
+  if (idx >= 0 && idx < (int)frames_.size()) return frames_[idx].address;
+  return frame ? frame->address() : QString();
 }
 
 void SplitWindow::rebuildSections(int n) {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::rebuildSections");
 
   // Ensure frames_ vector matches requested size, preserving existing values.
   if ((int)frames_.size() != n) {
@@ -414,163 +711,262 @@ void SplitWindow::rebuildSections(int n) {
   }
   // clamp n
   if (n < 1) n = 1;
+  if ((int)frames_.size() < n) frames_.resize(n);
 
-  // clear existing items
-  QLayoutItem *child;
-  while ((child = layout_->takeAt(0)) != nullptr) {
-    if (auto *w = child->widget()) {
-      w->hide();
-      w->deleteLater();
+  // Full rebuild: discard the existing frame widgets (and their pages). The
+  // old container is swapped out by layoutFrames() below.
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) {
+    frame->hide();
+    frame->deleteLater();
+  }
+  frameRegistry_.clear();
+
+  for (int i = 0; i < n; ++i) {
+    SplitFrameWidget *frame = createFrameWidget(i);
+    if (deferFrameLoads_) {
+      RestoreScheduler::instance().enqueue(frame, frames_[i].address, windowId_, i == restoreFocusIndex_);
+      if (i == restoreFocusIndex_) lastFocusedFrame_ = frame;
+    } else {
+      frame->setAddress(frames_[i].address);
     }
-    delete child;
+    frameRegistry_.append(frame);
   }
 
-  // old splitters are going away; clear tracking vector so we start fresh
+  layoutFrames(false);
+  renumberFrames();
+
+  if (!lastFocusedFrame_) lastFocusedFrame_ = firstFrameWidget();
+  // Update this window's title now that the number of frames may have changed
+  // and ensure the Window menus across the app reflect the new title.
+  updateWindowTitle();
+  rebuildAllWindowMenus();
+}
+
+SplitFrameWidget *SplitWindow::createFrameWidget(int index, SplitFrameWidget *spare) {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::createFrameWidget");
+  SplitFrameWidget *frame = spare;
+  if (frame) {
+    frame->setVisualIndex(index);
+  } else {
+    frame = new SplitFrameWidget(index);
+    frame->setProfile(profile_);
+  }
+  frame->setScaleFactor(frames_[index].scale);
+  frame->setAutoRefreshHint(frames_[index].refreshSeconds);
+  RefreshScheduler::instance().setInterval(frame, frames_[index].refreshSeconds);
+  FrameHibernationManager::instance().setKeepAlive(frame, frames_[index].keepAlive);
+  // Scrollable grid cells start parked so a large restore only builds the
+  // pages in view; updateScrollGridViewport() unparks them after layout.
+  if (layoutMode_ == ScrollGrid) frame->setContentParked(true);
+  connect(frame, &SplitFrameWidget::plusClicked, this, &SplitWindow::onPlusFromFrame);
+  connect(frame, &SplitFrameWidget::minusClicked, this, &SplitWindow::onMinusFromFrame);
+  connect(frame, &SplitFrameWidget::addressEdited, this, &SplitWindow::onAddressEdited);
+  connect(frame, &SplitFrameWidget::upClicked, this, &SplitWindow::onUpFromFrame);
+  connect(frame, &SplitFrameWidget::downClicked, this, &SplitWindow::onDownFromFrame);
+  connect(frame, &SplitFrameWidget::devToolsRequested, this, &SplitWindow::onFrameDevToolsRequested);
+  connect(frame, &SplitFrameWidget::translateRequested, this, &SplitWindow::onFrameTranslateRequested);
+  connect(frame, &SplitFrameWidget::openLinkInNewFrameRequested, this, &SplitWindow::onFrameOpenLinkInNewFrameRequested);
+  connect(frame, &SplitFrameWidget::linkSpeculationRequested, this, [this](SplitFrameWidget *, const QUrl &url) {
+    if (!isIncognito_) FramePool::instance().speculate(profile_, url);
+  });
+  connect(frame, &SplitFrameWidget::linkSpeculationCancelled, this, [](SplitFrameWidget *) {
+    FramePool::instance().cancelSpeculation();
+  });
+  connect(frame, &SplitFrameWidget::scaleChanged, this, &SplitWindow::onFrameScaleChanged);
+  connect(frame, &SplitFrameWidget::interactionOccurred, this, &SplitWindow::onFrameInteraction);
+  connect(frame, &QObject::destroyed, this, [this, frame]() {
+    if (lastFocusedFrame_ == frame) lastFocusedFrame_ = nullptr;
+    frameRegistry_.remove(frame);
+  });
+  return frame;
+}
+
+void SplitWindow::layoutFrames(bool preserveSizes) {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::layoutFrames");
+  const int n = frameRegistry_.size();
+
+  // Remember the current splitter sizes so an unchanged shape (e.g. a grid
+  // reorder) keeps the user's pane geometry.
+  std::vector<QList<int>> previousSizes;
+  previousSizes.reserve(currentSplitters_.size());
+  for (QSplitter *s : currentSplitters_) previousSizes.push_back(s ? s->sizes() : QList<int>());
   currentSplitters_.clear();
 
-  // create n sections according to the selected layout mode.
+  // Build the new splitter tree around the existing frame widgets. Adding a
+  // widget to a splitter reparents it, so pages keep running untouched.
   QWidget *container = nullptr;
+  scrollArea_ = nullptr;
   if (layoutMode_ == Vertical || layoutMode_ == Horizontal) {
     QSplitter *split = new QSplitter(layoutMode_ == Vertical ? Qt::Vertical : Qt::Horizontal);
-    // track this splitter for state persistence
     currentSplitters_.push_back(split);
-    for (int i = 0; i < n; ++i) {
-      auto *frame = new SplitFrameWidget(i);
-      // logicalIndex property used for mapping frame -> frames_ index
-      frame->setProperty("logicalIndex", i);
-      frame->setProfile(profile_);
-      frame->setScaleFactor(frames_[i].scale);
-      frame->setAddress(frames_[i].address);
-      connect(frame, &SplitFrameWidget::plusClicked, this, &SplitWindow::onPlusFromFrame);
-      connect(frame, &SplitFrameWidget::minusClicked, this, &SplitWindow::onMinusFromFrame);
-      connect(frame, &SplitFrameWidget::addressEdited, this, &SplitWindow::onAddressEdited);
-      connect(frame, &SplitFrameWidget::upClicked, this, &SplitWindow::onUpFromFrame);
-      connect(frame, &SplitFrameWidget::downClicked, this, &SplitWindow::onDownFromFrame);
-      connect(frame, &SplitFrameWidget::devToolsRequested, this, &SplitWindow::onFrameDevToolsRequested);
-      connect(frame, &SplitFrameWidget::translateRequested, this, &SplitWindow::onFrameTranslateRequested);
-      connect(frame, &SplitFrameWidget::openLinkInNewFrameRequested, this, &SplitWindow::onFrameOpenLinkInNewFrameRequested);
-      connect(frame, &SplitFrameWidget::scaleChanged, this, &SplitWindow::onFrameScaleChanged);
-      connect(frame, &SplitFrameWidget::interactionOccurred, this, &SplitWindow::onFrameInteraction);
-      connect(frame, &QObject::destroyed, this, [this, frame]() {
-        if (lastFocusedFrame_ == frame) lastFocusedFrame_ = nullptr;
-      });
-      updateFrameButtonStates(frame, n);
-      qDebug() << "";
+    for (SplitFrameWidget *frame : frameRegistry_.frames()) {
       split->addWidget(frame);
-    }
-    // distribute sizes evenly across the children so switching layouts
-    // starts with a balanced view
-    if (n > 0) {
-      QList<int> sizes;
-      for (int i = 0; i < n; ++i) sizes << 1;
-      split->setSizes(sizes);
-    }
-    // Install double-click handler for equal sizing after widgets/handles exist
-    {
-      SplitterDoubleClickFilter *filter = new SplitterDoubleClickFilter(split, this);
-      connect(filter, &SplitterDoubleClickFilter::splitterResized, this, &SplitWindow::onSplitterDoubleClickResized);
+      // reparenting hides a widget; make sure moved frames come back
+      frame->show();
     }
     container = split;
+  } else if (layoutMode_ == ScrollGrid) {
+    // Fixed column count and row height; rows beyond the window scroll.
+    // Off-screen cells are parked by updateScrollGridViewport().
+    QSplitter *outer = new QSplitter(Qt::Vertical);
+    currentSplitters_.push_back(outer);
+    const int cols = scrollGridColumns_;
+    const int rows = (n + cols - 1) / cols;
+    for (int r = 0; r < rows; ++r) {
+      QSplitter *rowSplit = new QSplitter(Qt::Horizontal);
+      currentSplitters_.push_back(rowSplit);
+      for (int idx = r * cols; idx < std::min(n, (r + 1) * cols); ++idx) {
+        rowSplit->addWidget(frameRegistry_.at(idx));
+        frameRegistry_.at(idx)->show();
+      }
+      outer->addWidget(rowSplit);
+    }
+    outer->setMinimumHeight(rows * scrollGridRowHeight_);
+    auto *area = new QScrollArea;
+    area->setWidgetResizable(true);
+    area->setFrameShape(QFrame::NoFrame);
+    area->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    area->setWidget(outer);
+    connect(area->verticalScrollBar(), &QScrollBar::valueChanged, this, &SplitWindow::scheduleViewportUpdate);
+    connect(area->verticalScrollBar(), &QScrollBar::rangeChanged, this, &SplitWindow::scheduleViewportUpdate);
+    connect(outer, &QSplitter::splitterMoved, this, &SplitWindow::scheduleViewportUpdate);
+    scrollArea_ = area;
+    container = area;
   } else { // Grid mode: nested splitters for resizable grid
     // Create a vertical splitter containing one horizontal splitter per row.
     QSplitter *outer = new QSplitter(Qt::Vertical);
     currentSplitters_.push_back(outer);
-    int rows = (int)std::ceil(std::sqrt((double)n));
-    int cols = (n + rows - 1) / rows;
+    const int rows = (int)std::ceil(std::sqrt((double)n));
+    const int cols = rows > 0 ? (n + rows - 1) / rows : 0;
     int idx = 0;
     for (int r = 0; r < rows; ++r) {
       // how many items in this row
-      int itemsInRow = std::min(cols, n - idx);
+      const int itemsInRow = std::min(cols, n - idx);
       if (itemsInRow <= 0) break;
       QSplitter *rowSplit = new QSplitter(Qt::Horizontal);
       currentSplitters_.push_back(rowSplit);
       for (int c = 0; c < itemsInRow; ++c) {
-        auto *frame = new SplitFrameWidget(idx);
-        // logicalIndex property used for mapping frame -> frames_ index
-        frame->setProperty("logicalIndex", idx);
-        frame->setProfile(profile_);
-        frame->setScaleFactor(frames_[idx].scale);
-        frame->setAddress(frames_[idx].address);
-        connect(frame, &SplitFrameWidget::plusClicked, this, &SplitWindow::onPlusFromFrame);
-        connect(frame, &SplitFrameWidget::minusClicked, this, &SplitWindow::onMinusFromFrame);
-        connect(frame, &SplitFrameWidget::addressEdited, this, &SplitWindow::onAddressEdited);
-        connect(frame, &SplitFrameWidget::upClicked, this, &SplitWindow::onUpFromFrame);
-        connect(frame, &SplitFrameWidget::downClicked, this, &SplitWindow::onDownFromFrame);
-        connect(frame, &SplitFrameWidget::devToolsRequested, this, &SplitWindow::onFrameDevToolsRequested);
-        connect(frame, &SplitFrameWidget::translateRequested, this, &SplitWindow::onFrameTranslateRequested);
-        connect(frame, &SplitFrameWidget::openLinkInNewFrameRequested, this, &SplitWindow::onFrameOpenLinkInNewFrameRequested);
-        connect(frame, &SplitFrameWidget::scaleChanged, this, &SplitWindow::onFrameScaleChanged);
-        connect(frame, &SplitFrameWidget::interactionOccurred, this, &SplitWindow::onFrameInteraction);
-        connect(frame, &QObject::destroyed, this, [this, frame]() {
-          if (lastFocusedFrame_ == frame) lastFocusedFrame_ = nullptr;
-        });
-        updateFrameButtonStates(frame, n);
-        qDebug() << "";
-        rowSplit->addWidget(frame);
+        rowSplit->addWidget(frameRegistry_.at(idx));
+        frameRegistry_.at(idx)->show();
         ++idx;
       }
-      // evenly distribute columns in this row
-      if (itemsInRow > 0) {
-        QList<int> colSizes;
-        for (int i = 0; i < itemsInRow; ++i) colSizes << 1;
-        rowSplit->setSizes(colSizes);
-        // Install rowFilter now that the rowSplit and its handles exist
-        {
-          SplitterDoubleClickFilter *rowFilter = new SplitterDoubleClickFilter(rowSplit, this);
-          connect(rowFilter, &SplitterDoubleClickFilter::splitterResized, this, &SplitWindow::onSplitterDoubleClickResized);
-        }
-      }
       outer->addWidget(rowSplit);
     }
-    // evenly distribute rows in the outer splitter
-    int actualRows = outer->count();
-    if (actualRows > 0) {
-      QList<int> rowSizes;
-      for (int i = 0; i < actualRows; ++i) rowSizes << 1;
-      outer->setSizes(rowSizes);
-    }
-    // Install outerFilter now that outer and its handles exist
-    {
-      SplitterDoubleClickFilter *outerFilter = new SplitterDoubleClickFilter(outer, this);
-      connect(outerFilter, &SplitterDoubleClickFilter::splitterResized, this, &SplitWindow::onSplitterDoubleClickResized);
-    }
     container = outer;
   }
 
-  if (container) {
+  bool sameShape = preserveSizes && previousSizes.size() == currentSplitters_.size();
+  for (size_t i = 0; sameShape && i < currentSplitters_.size(); ++i) {
+    if (previousSizes[i].size() != currentSplitters_[i]->count()) sameShape = false;
+  }
+  for (size_t i = 0; i < currentSplitters_.size(); ++i) {
+    QSplitter *split = currentSplitters_[i];
+    if (sameShape) {
+      split->setSizes(previousSizes[i]);
+    } else {
+      // distribute sizes evenly so a new shape starts with a balanced view
+      split->setSizes(QList<int>(split->count(), 1));
+    }
+    // Install double-click handler for equal sizing after widgets/handles
+    // exist; parent it to the splitter so it goes away with it.
+    SplitterDoubleClickFilter *filter = new SplitterDoubleClickFilter(split, split, splitterResizeMode_,
+                                                                      splitterResizeIntervalMs_);
+    connect(filter, &SplitterDoubleClickFilter::splitterResized, this, &SplitWindow::onSplitterDoubleClickResized);
+    // Snapshot-mode drags resize rows with setSizes(), which skips splitterMoved
+    if (layoutMode_ == ScrollGrid && i == 0)
+      connect(filter, &SplitterDoubleClickFilter::splitterResized, this, &SplitWindow::scheduleViewportUpdate);
+  }
+
+  // Swap the new container in place of the old one. The old splitters are
+  // empty by now, so deleting them does not touch any frame.
+  if (container_) {
+    QWidget *old = container_;
+    delete layout_->replaceWidget(old, container);
+    old->hide();
+    old->deleteLater();
+  } else {
     layout_->addWidget(container, 1);
+    // add a final stretch with zero so that widgets entirely control spacing
+    layout_->addStretch(0);
   }
-
-  // add a final stretch with zero so that widgets entirely control spacing
-  layout_->addStretch(0);
+  container_ = container;
   central_->update();
-  if (!lastFocusedFrame_) lastFocusedFrame_ = firstFrameWidget();
-  // Update this window's title now that the number of frames may have changed
-  // and ensure the Window menus across the app reflect the new title.
-  updateWindowTitle();
-  rebuildAllWindowMenus();
+  // park or unpark frames for the new layout once geometry has settled
+  scheduleViewportUpdate();
 }
 
-void SplitWindow::toggleDevToolsForFocusedFrame() {
-  // If the shared DevTools view is open, hide it. Otherwise attach it to
-  // the focused frame's page (or the first frame) and show it.
-  if (sharedDevToolsView_ && sharedDevToolsView_->isVisible()) {
-    sharedDevToolsView_->hide();
-    return;
+void SplitWindow::scheduleViewportUpdate() {
+  if (!viewportTimer_) {
+    viewportTimer_ = new QTimer(this);
+    viewportTimer_->setSingleShot(true);
+    viewportTimer_->setInterval(VIEWPORT_UPDATE_DELAY_MS);
+    connect(viewportTimer_, &QTimer::timeout, this, &SplitWindow::updateScrollGridViewport);
   }
+  viewportTimer_->start();
+}
 
-  SplitFrameWidget *target = focusedFrameOrFirst();
-  if (target) {
-    QWebEnginePage *p = target->page();
-    if (p) {
-      createAndAttachSharedDevToolsForPage(p);
-      if (sharedDevToolsView_) {
-        sharedDevToolsView_->show();
-        sharedDevToolsView_->raise();
-        sharedDevToolsView_->activateWindow();
-      }
+void SplitWindow::updateScrollGridViewport() {
+  QWidget *viewport = scrollArea_ ? scrollArea_->viewport() : nullptr;
+  const QRect live = viewport ? viewport->rect().adjusted(0, -SCROLL_GRID_MARGIN_ROWS * scrollGridRowHeight_,
+                                                          0, SCROLL_GRID_MARGIN_ROWS * scrollGridRowHeight_)
+                              : QRect();
+  int parked = 0;
+  bool unparkedAny = false;
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) {
+    const bool park = viewport && !live.intersects(QRect(frame->mapTo(viewport, QPoint(0, 0)), frame->size()));
+    if (park) ++parked;
+    if (park == frame->isContentParked()) continue;
+    frame->setContentParked(park);
+    if (park) {
+      // the placeholder keeps the cell; the page itself goes away
+      FrameHibernationManager::instance().discardHiddenFrame(frame);
+    } else {
+      FrameHibernationManager::instance().evaluateFrame(frame);
+      unparkedAny = true;
     }
   }
+  // frames still waiting for their restore slot can load now
+  if (unparkedAny) RestoreScheduler::instance().frameVisibilityChanged();
+  if (viewport) qDebug() << "updateScrollGridViewport:" << parked << "of" << frameRegistry_.size() << "frame(s) parked";
+}
+
+void SplitWindow::renumberFrames() {
+  if (frameRegistry_.size() != (int)frames_.size()) {
+    qWarning() << "renumberFrames: registry has" << frameRegistry_.size() << "frame(s) but frames_ has" << frames_.size();
+  }
+  const int total = frameRegistry_.size();
+  for (int i = 0; i < total; ++i) {
+    SplitFrameWidget *frame = frameRegistry_.at(i);
+    frame->setVisualIndex(i);
+    updateFrameButtonStates(frame, total);
+  }
+}
+
+void SplitWindow::swapFrames(int a, int b) {
+  if (a < 0 || b < 0 || a >= frameRegistry_.size() || b >= frameRegistry_.size() || a == b) return;
+  std::swap(frames_[a], frames_[b]);
+  frameRegistry_.swap(a, b);
+  persistGlobalFrameState();
+
+  if (isGridLayout()) {
+    // rows may change membership; reflow into fresh splitters, same shape
+    layoutFrames(true);
+  } else if (!currentSplitters_.empty() && currentSplitters_[0]) {
+    // QSplitter::insertWidget moves a widget that is already a child. Keep
+    // the slot sizes so only the content trades places.
+    QSplitter *split = currentSplitters_[0];
+    const QList<int> sizes = split->sizes();
+    for (int i = 0; i < frameRegistry_.size(); ++i) split->insertWidget(i, frameRegistry_.at(i));
+    split->setSizes(sizes);
+  }
+  renumberFrames();
+}
+
+void SplitWindow::toggleDevToolsForFocusedFrame() {
+  // The DevTools window is shared: hide it only when it already inspects
+  // this window's focused frame (or the first frame); otherwise point it there.
+  SplitFrameWidget *target = focusedFrameOrFirst();
+  DevToolsHost::instance().toggle(target ? target->page() : nullptr);
 }
 
 void SplitWindow::onNewFrameShortcut() {
@@ -584,38 +980,12 @@ void SplitWindow::onNewFrameShortcut() {
 
   const int pos = frameIndexFor(target);
   if (pos < 0) {
-    qDebug() << "onNewFrameShortcut: target has no logicalIndex property";
-    return;
-  }
-  
-  // Try surgical addition first (works for Vertical/Horizontal modes)
-  if (addSingleFrame(pos)) {
-    // Provide a visual cue by briefly flashing the divider handle
-    if (!currentSplitters_.empty()) {
-      for (QSplitter *splitter : currentSplitters_) {
-        if (!splitter) continue;
-        QPointer<QSplitter> splitterGuard(splitter);
-        QTimer::singleShot(0, this, [splitterGuard]() {
-          if (!splitterGuard) return;
-          const int origWidth = splitterGuard->handleWidth();
-          splitterGuard->setHandleWidth(origWidth + FLASH_HANDLE_WIDTH_INCREASE);
-          QTimer::singleShot(FLASH_DURATION_MS, [splitterGuard, origWidth]() {
-            if (splitterGuard) {
-              splitterGuard->setHandleWidth(origWidth);
-            }
-          });
-        });
-      }
-    }
-    qDebug() << "onNewFrameShortcut: added new frame after position" << pos << "(surgical)";
+    qDebug() << "onNewFrameShortcut: target is not registered in this window";
     return;
   }
   
-  // Fall back to rebuildSections for Grid mode
-  frames_.insert(frames_.begin() + pos + 1, FrameState());
-  persistGlobalFrameState();
-  rebuildSections((int)frames_.size());
-  
+  if (!addSingleFrame(pos)) return;
+
   // Provide a visual cue by briefly flashing the divider handle
   if (!currentSplitters_.empty()) {
     for (QSplitter *splitter : currentSplitters_) {
@@ -634,7 +1004,7 @@ void SplitWindow::onNewFrameShortcut() {
     }
   }
   
-  qDebug() << "onNewFrameShortcut: added new frame after position" << pos << "(rebuild)";
+  qDebug() << "onNewFrameShortcut: added new frame after position" << pos;
 }
 
 void SplitWindow::reloadFocusedFrame() {
@@ -650,56 +1020,26 @@ void SplitWindow::reloadFocusedFrameBypassingCache() {
 }
 
 void SplitWindow::onPlusFromFrame(SplitFrameWidget *who) {
-  // use logicalIndex property assigned during rebuildSections
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
-  
-  // Try surgical addition first (works for Vertical/Horizontal modes)
-  if (addSingleFrame(pos)) {
-    return;
-  }
-  
-  // Fall back to rebuildSections for Grid mode
-  frames_.insert(frames_.begin() + pos + 1, FrameState());
-  persistGlobalFrameState();
-  rebuildSections((int)frames_.size());
+  const int pos = frameIndexFor(who);
+  if (pos < 0) return;
   
-  // Focus the newly added frame's address bar
-  const int newFrameIndex = pos + 1;
-  QMetaObject::invokeMethod(this, [this, newFrameIndex]() {
-    if (!central_) return;
-    const QList<SplitFrameWidget *> frames = central_->findChildren<SplitFrameWidget *>();
-    for (SplitFrameWidget *frame : frames) {
-      if (frame->property("logicalIndex").toInt() == newFrameIndex) {
-        frame->focusAddress();
-        break;
-      }
-    }
-  }, Qt::QueuedConnection);
+  // Surgical addition keeps every existing frame alive in all layout modes
+  addSingleFrame(pos);
 }
 
 
 void SplitWindow::onUpFromFrame(SplitFrameWidget *who) {
   // move this frame up (towards index 0)
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
+  const int pos = frameIndexFor(who);
   if (pos <= 0) return; // already at top or not found
-  std::swap(frames_[pos], frames_[pos - 1]);
-  persistGlobalFrameState();
-  rebuildSections((int)frames_.size());
+  swapFrames(pos, pos - 1);
 }
 
 void SplitWindow::onDownFromFrame(SplitFrameWidget *who) {
   // move this frame down (towards larger indices)
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
+  const int pos = frameIndexFor(who);
   if (pos < 0 || pos >= (int)frames_.size() - 1) return; // at bottom or not found
-  std::swap(frames_[pos], frames_[pos + 1]);
-  persistGlobalFrameState();
-  rebuildSections((int)frames_.size());
+  swapFrames(pos, pos + 1);
 }
 
 void SplitWindow::setLayoutMode(SplitWindow::LayoutMode m) {
@@ -711,8 +1051,8 @@ void SplitWindow::setLayoutMode(SplitWindow::LayoutMode m) {
   if (m == layoutMode_) {
     const QString base = QStringLiteral("splitterSizes/%1").arg(layoutModeKey(layoutMode_));
     settings->remove(base);
-    // rebuild so splitters are reset to defaults
-    rebuildSections((int)frames_.size());
+    // re-lay out the existing frames so splitters are reset to defaults
+    layoutFrames(false);
     return;
   }
 
@@ -730,8 +1070,35 @@ void SplitWindow::setLayoutMode(SplitWindow::LayoutMode m) {
   // Apply the new layout mode and persist it.
   layoutMode_ = m;
   settings->setValue("layoutMode", (int)layoutMode_);
-  // Rebuild UI for the new layout (splitter sizes are only restored at startup)
-  rebuildSections((int)frames_.size());
+  // Move the existing frames into the new layout (splitter sizes are only
+  // restored at startup); pages are not reloaded.
+  layoutFrames(false);
+}
+
+void SplitWindow::setSplitterResizeMode(SplitterResizeMode mode) {
+  if (mode == splitterResizeMode_) return;
+  splitterResizeMode_ = mode;
+  qDebug() << "setSplitterResizeMode:" << SplitterDoubleClickFilter::resizeModeKey(mode);
+  // new splitters pick up the mode; frames are reparented, not reloaded
+  if (container_) layoutFrames(true);
+}
+
+void SplitWindow::exportPerformanceLog() {
+  const QString csvFilter = tr("CSV files (*.csv)");
+  const QString jsonFilter = tr("JSON files (*.json)");
+  const QString suggested = QDir(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation))
+                              .filePath(QStringLiteral("phraims-perf-%1.csv")
+                                          .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"))));
+  QString selectedFilter = csvFilter;
+  QString path = QFileDialog::getSaveFileName(this, tr("Export Performance Log"), suggested,
+                                              csvFilter + QStringLiteral(";;") + jsonFilter, &selectedFilter);
+  if (path.isEmpty()) return;
+  if (QFileInfo(path).suffix().isEmpty()) path += selectedFilter == jsonFilter ? QStringLiteral(".json") : QStringLiteral(".csv");
+
+  QString error;
+  if (!FrameMetricsSampler::instance().exportLog(path, &error)) {
+    QMessageBox::warning(this, tr("Export Failed"), tr("Could not write %1:\n%2").arg(QDir::toNativeSeparators(path), error));
+  }
 }
 
 void SplitWindow::setHeightToScreen() {
@@ -749,10 +1116,7 @@ void SplitWindow::setHeightToScreen() {
 void SplitWindow::onMinusFromFrame(SplitFrameWidget *who) {
   if (frames_.size() <= 1) return; // shouldn't remove last
 
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
-  if (pos < 0) return;
+  if (frameIndexFor(who) < 0) return;
 
   // confirm with the user before removing
   const QMessageBox::StandardButton reply = QMessageBox::question(
@@ -767,14 +1131,12 @@ void SplitWindow::onMinusFromFrame(SplitFrameWidget *who) {
 void SplitWindow::removeSingleFrame(SplitFrameWidget *frameToRemove) {
   if (!frameToRemove) return;
   
-  const QVariant v = frameToRemove->property("logicalIndex");
-  if (!v.isValid()) {
-    qWarning() << "removeSingleFrame: frame has no logicalIndex property";
+  const int removedIndex = frameIndexFor(frameToRemove);
+  if (removedIndex < 0) {
+    qWarning() << "removeSingleFrame: frame is not registered in this window";
     return;
   }
-  
-  const int removedIndex = v.toInt();
-  if (removedIndex < 0 || removedIndex >= (int)frames_.size()) {
+  if (removedIndex >= (int)frames_.size()) {
     qWarning() << "removeSingleFrame: invalid frame index" << removedIndex 
                << "for frames_.size()=" << frames_.size();
     return;
@@ -786,47 +1148,23 @@ void SplitWindow::removeSingleFrame(SplitFrameWidget *frameToRemove) {
   // Persist the updated frame state
   persistGlobalFrameState();
   
-  // Find all remaining frames and validate their logical indices
-  const QList<SplitFrameWidget *> allFrames = central_->findChildren<SplitFrameWidget *>();
-  QList<SplitFrameWidget *> remainingFrames;
-  for (SplitFrameWidget *frame : allFrames) {
-    if (frame != frameToRemove) {
-      const QVariant v = frame->property("logicalIndex");
-      if (v.isValid()) {
-        remainingFrames.append(frame);
-      } else {
-        qWarning() << "removeSingleFrame: found frame without valid logicalIndex, skipping";
-      }
-    }
-  }
-  
-  // Sort remaining frames by their current logical index
-  std::sort(remainingFrames.begin(), remainingFrames.end(), [](SplitFrameWidget *a, SplitFrameWidget *b) {
-    // At this point all frames are validated to have valid logicalIndex properties
-    const int idxA = a->property("logicalIndex").toInt();
-    const int idxB = b->property("logicalIndex").toInt();
-    return idxA < idxB;
-  });
+  // Drop the widget from the logical order before touching the layout
+  frameRegistry_.remove(frameToRemove);
   
-  // Update logical indices for frames after the removed one
-  for (SplitFrameWidget *frame : remainingFrames) {
-    const int oldIndex = frame->property("logicalIndex").toInt();
-    
-    // If this frame was after the removed one, decrement its index
-    if (oldIndex > removedIndex) {
-      frame->setProperty("logicalIndex", oldIndex - 1);
-    }
-  }
+  // Remove the frame widget from the UI. Hand it to the frame pool when it
+  // has room (the page and renderer are kept); otherwise delete it.
+  frameToRemove->hide();
+  disconnect(frameToRemove, nullptr, this, nullptr);
+  RefreshScheduler::instance().setInterval(frameToRemove, 0);
+  FrameHibernationManager::instance().setKeepAlive(frameToRemove, false);
+  if (!FramePool::instance().recycle(frameToRemove)) frameToRemove->deleteLater();
   
-  // Update button states for all remaining frames
-  const int totalFrames = (int)frames_.size();
-  for (SplitFrameWidget *frame : remainingFrames) {
-    updateFrameButtonStates(frame, totalFrames);
-  }
+  // Grid rows are derived from the frame count; reflow the remaining frames
+  // so the grid does not keep a hole. Vertical/Horizontal just lose a pane.
+  if (isGridLayout()) requestRelayout();
   
-  // Remove the frame widget from the UI
-  frameToRemove->hide();
-  frameToRemove->deleteLater();
+  // Renumber logical indices and update button states for remaining frames
+  requestRenumber();
   
   // Clear the last focused frame if it's being removed
   if (lastFocusedFrame_ == frameToRemove) {
@@ -834,93 +1172,62 @@ void SplitWindow::removeSingleFrame(SplitFrameWidget *frameToRemove) {
   }
   
   // Update window title and menus
-  updateWindowTitle();
-  rebuildAllWindowMenus();
+  requestWindowListRefresh();
 }
 
 void SplitWindow::updateFrameButtonStates(SplitFrameWidget *frame, int totalFrames) {
   if (!frame) return;
   
-  const QVariant v = frame->property("logicalIndex");
-  if (!v.isValid()) return;
+  const int idx = frameIndexFor(frame);
+  if (idx < 0) return;
   
-  const int idx = v.toInt();
   frame->setMinusEnabled(totalFrames > 1);
   frame->setUpEnabled(idx > 0);
   frame->setDownEnabled(idx < totalFrames - 1);
 }
 
-bool SplitWindow::addSingleFrame(int afterIndex) {
-  // Only support surgical addition for Vertical/Horizontal modes
-  // Grid mode requires rebuildSections due to nested splitter complexity
-  if (layoutMode_ == Grid) {
-    return false;
-  }
-  
-  // Verify we have a single splitter (Vertical/Horizontal mode)
+bool SplitWindow::addSingleFrame(int afterIndex, SplitFrameWidget *prepared) {
   if (currentSplitters_.empty() || !currentSplitters_[0]) {
     qWarning() << "addSingleFrame: no splitter available";
     return false;
   }
   
-  QSplitter *splitter = currentSplitters_[0];
-  const int insertPosition = afterIndex + 1;
+  const int insertPosition = std::clamp(afterIndex + 1, 0, frameRegistry_.size());
   
   // Insert frame data into the model
   frames_.insert(frames_.begin() + insertPosition, FrameState());
   persistGlobalFrameState();
   
-  // Create the new frame widget
-  auto *newFrame = new SplitFrameWidget(insertPosition);
-  newFrame->setProperty("logicalIndex", insertPosition);
-  newFrame->setProfile(profile_);
-  newFrame->setScaleFactor(frames_[insertPosition].scale);
-  newFrame->setAddress(frames_[insertPosition].address);
-  
-  // Connect all signals
-  connect(newFrame, &SplitFrameWidget::plusClicked, this, &SplitWindow::onPlusFromFrame);
-  connect(newFrame, &SplitFrameWidget::minusClicked, this, &SplitWindow::onMinusFromFrame);
-  connect(newFrame, &SplitFrameWidget::addressEdited, this, &SplitWindow::onAddressEdited);
-  connect(newFrame, &SplitFrameWidget::upClicked, this, &SplitWindow::onUpFromFrame);
-  connect(newFrame, &SplitFrameWidget::downClicked, this, &SplitWindow::onDownFromFrame);
-  connect(newFrame, &SplitFrameWidget::devToolsRequested, this, &SplitWindow::onFrameDevToolsRequested);
-  connect(newFrame, &SplitFrameWidget::translateRequested, this, &SplitWindow::onFrameTranslateRequested);
-  connect(newFrame, &SplitFrameWidget::openLinkInNewFrameRequested, this, &SplitWindow::onFrameOpenLinkInNewFrameRequested);
-  connect(newFrame, &SplitFrameWidget::scaleChanged, this, &SplitWindow::onFrameScaleChanged);
-  connect(newFrame, &SplitFrameWidget::interactionOccurred, this, &SplitWindow::onFrameInteraction);
-  connect(newFrame, &QObject::destroyed, this, [this, newFrame]() {
-    if (lastFocusedFrame_ == newFrame) lastFocusedFrame_ = nullptr;
-  });
-  
-  // Insert the widget into the splitter at the correct position
-  splitter->insertWidget(insertPosition, newFrame);
-  
-  // Update logical indices for all frames after the insertion point
-  const QList<SplitFrameWidget *> allFrames = central_->findChildren<SplitFrameWidget *>();
-  for (SplitFrameWidget *frame : allFrames) {
-    const QVariant v = frame->property("logicalIndex");
-    if (v.isValid()) {
-      const int idx = v.toInt();
-      if (idx > afterIndex && frame != newFrame) {
-        frame->setProperty("logicalIndex", idx + 1);
-      }
-    }
+  // Create the new frame widget with all signal connections. A pooled spare
+  // already has its page and renderer up and shows the instruction page; a
+  // prepared frame is already loading its link.
+  SplitFrameWidget *spare = prepared ? prepared : FramePool::instance().take(profile_);
+  SplitFrameWidget *newFrame = createFrameWidget(insertPosition, spare);
+  if (!spare || !frames_[insertPosition].address.isEmpty()) newFrame->setAddress(frames_[insertPosition].address);
+  frameRegistry_.insert(insertPosition, newFrame);
+  
+  if (isGridLayout()) {
+    // The grid shape depends on the frame count; reflow the existing
+    // widgets (reparented, not recreated) together with the new one.
+    requestRelayout();
+  } else {
+    // Insert the widget into the splitter at the correct position
+    currentSplitters_[0]->insertWidget(insertPosition, newFrame);
   }
   
-  // Update button states for all frames
-  const int totalFrames = (int)frames_.size();
-  for (SplitFrameWidget *frame : allFrames) {
-    updateFrameButtonStates(frame, totalFrames);
-  }
+  // Update logical indices and button states for all frames
+  requestRenumber();
   
   // Update window title and menus
-  updateWindowTitle();
-  rebuildAllWindowMenus();
+  requestWindowListRefresh();
   
   // Focus the newly added frame's address bar
-  QMetaObject::invokeMethod(this, [this, newFrame]() {
-    if (newFrame) {
-      newFrame->focusAddress();
+  QPointer<SplitFrameWidget> newFrameGuard(newFrame);
+  QPointer<QScrollArea> areaGuard(scrollArea_);
+  QMetaObject::invokeMethod(this, [newFrameGuard, areaGuard]() {
+    if (newFrameGuard) {
+      if (areaGuard) areaGuard->ensureWidgetVisible(newFrameGuard);
+      newFrameGuard->focusAddress();
     }
   }, Qt::QueuedConnection);
   
@@ -928,9 +1235,7 @@ bool SplitWindow::addSingleFrame(int afterIndex) {
 }
 
 void SplitWindow::onAddressEdited(SplitFrameWidget *who, const QString &text) {
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
+  const int pos = frameIndexFor(who);
   if (pos < 0) return;
   if (pos < (int)frames_.size()) {
     frames_[pos].address = text;
@@ -947,11 +1252,21 @@ void SplitWindow::onFrameScaleChanged(SplitFrameWidget *who, double scale) {
 }
 
 void SplitWindow::closeEvent(QCloseEvent *event) {
+  // Grab the pages while they still show their content; the next session
+  // restore paints these snapshots before the pages load.
+  if (!isIncognito_) {
+    for (SplitFrameWidget *frame : frameRegistry_.frames()) frame->captureSnapshot();
+  }
+
   // Stop all media playback immediately to prevent audio/video from continuing
   // after the window closes. This must be done first, before any state saving
   // or cleanup, to ensure media stops as soon as possible.
   stopAllFramesMediaPlayback();
 
+  // Land any coalesced frame-state writes before this window's state is
+  // saved or removed below.
+  AppSettings::flushDeferred();
+
   // Incognito windows should never persist state
   if (isIncognito_) {
     qDebug() << "SplitWindow::closeEvent: Incognito window - skipping all persistence";
@@ -971,45 +1286,20 @@ void SplitWindow::closeEvent(QCloseEvent *event) {
     // does not get restored.
     if (qApp && qApp->closingDown()) {
       // During shutdown: save (do not remove) so session is preserved.
-      AppSettings s;
-      {
-        GroupScope _gs(s, QStringLiteral("windows/%1").arg(windowId_));
-        QStringList addressList;
-        QVariantList scaleList;
-        for (const auto &state : frames_) {
-          addressList << state.address;
-          scaleList << state.scale;
-        }
-        s->setValue("addresses", addressList);
-        s->setValue("frameScales", scaleList);
-        s->setValue("layoutMode", (int)layoutMode_);
-        s->setValue("windowGeometry", saveGeometry());
-        s->setValue("windowState", saveState());
-      }
-      // Ensure these shutdown-time writes are flushed to the backend.
-      s->sync();
-      saveCurrentSplitterSizes(QStringLiteral("windows/%1/splitterSizes").arg(windowId_));
+      // main() flushes the session store once every window has saved.
+      savePersistentStateToSettings();
     } else {
-      // If other windows exist, remove this window's saved group now.
-      // If this is the last window, preserve the saved group so it
-      // reopens on next launch.
-      saveCurrentSplitterSizes(QStringLiteral("windows/%1/splitterSizes").arg(windowId_));
+      // If other windows exist, remove this window from the session now.
+      // If this is the last window, preserve it so it reopens on next launch.
       const size_t windowsCount = g_windows.size();
       qDebug() << "SplitWindow::closeEvent: g_windows.count (including this)=" << windowsCount;
       if (windowsCount > 1) {
-        AppSettings s;
-        s->beginGroup(QStringLiteral("windows"));
-        const QStringList before = s->childGroups();
-        if (before.contains(windowId_)) {
-          qDebug() << "SplitWindow::closeEvent: removing stored group for" << windowId_;
-          s->remove(windowId_);
-          s->sync();
-        } else {
-          qDebug() << "SplitWindow::closeEvent: no stored group for" << windowId_;
-        }
-        s->endGroup();
+        if (sessionSaveTimer_) sessionSaveTimer_->stop();
+        qDebug() << "SplitWindow::closeEvent: removing stored session window" << windowId_;
+        SessionStore::instance().removeWindow(windowId_);
       } else {
-        qDebug() << "SplitWindow::closeEvent: single window or quitting; preserving stored group for" << windowId_;
+        qDebug() << "SplitWindow::closeEvent: single window or quitting; preserving stored session window" << windowId_;
+        savePersistentStateToSettings();
       }
 
       // Schedule deletion; the destroyed() handler will prune g_windows
@@ -1022,12 +1312,18 @@ void SplitWindow::closeEvent(QCloseEvent *event) {
     AppSettings settings;
     QStringList addressList;
     QVariantList scaleList;
+    QVariantList intervalList;
+    QVariantList keepAliveList;
     for (const auto &state : frames_) {
       addressList << state.address;
       scaleList << state.scale;
+      intervalList << state.refreshSeconds;
+      keepAliveList << state.keepAlive;
     }
     settings->setValue("addresses", addressList);
     settings->setValue("frameScales", scaleList);
+    settings->setValue("frameRefreshIntervals", intervalList);
+    settings->setValue("frameKeepAlive", keepAliveList);
     // persist window geometry
     settings->setValue("windowGeometry", saveGeometry());
     // persist window state (toolbars/dock state and maximized/minimized state)
@@ -1044,134 +1340,160 @@ QString SplitWindow::layoutModeKey(SplitWindow::LayoutMode m) {
   switch (m) {
     case Vertical: return QStringLiteral("vertical");
     case Horizontal: return QStringLiteral("horizontal");
+    case ScrollGrid: return QStringLiteral("scrollgrid");
     case Grid: default: return QStringLiteral("grid");
   }
 }
 
+SplitWindow::LayoutMode SplitWindow::layoutModeFromKey(const QString &key, bool *ok) {
+  *ok = true;
+  if (key == QLatin1String("vertical")) return Vertical;
+  if (key == QLatin1String("horizontal")) return Horizontal;
+  if (key == QLatin1String("grid")) return Grid;
+  if (key == QLatin1String("scrollgrid")) return ScrollGrid;
+  *ok = false;
+  return Vertical;
+}
+
 void SplitWindow::persistGlobalFrameState() {
-  AppSettings settings;
+  if (batchDepth_ > 0) {
+    batchPersist_ = true;
+    return;
+  }
   QStringList addresses;
   QVariantList scales;
+  QVariantList intervals;
+  QVariantList keepAlive;
   addresses.reserve((int)frames_.size());
   scales.reserve((int)frames_.size());
+  intervals.reserve((int)frames_.size());
   for (const auto &state : frames_) {
     addresses << state.address;
     scales << state.scale;
+    intervals << state.refreshSeconds;
+    keepAlive << state.keepAlive;
+  }
+  // Called on every urlChanged/scale change; coalesce so busy single-page
+  // apps don't rewrite the settings file several times a second.
+  AppSettings::setValueDeferred(QStringLiteral("addresses"), addresses);
+  AppSettings::setValueDeferred(QStringLiteral("frameScales"), scales);
+  AppSettings::setValueDeferred(QStringLiteral("frameRefreshIntervals"), intervals);
+  AppSettings::setValueDeferred(QStringLiteral("frameKeepAlive"), keepAlive);
+  scheduleSessionSave();
+}
+
+void SplitWindow::beginBatch() {
+  ++batchDepth_;
+}
+
+void SplitWindow::commitBatch() {
+  if (batchDepth_ <= 0) {
+    qWarning() << "commitBatch: no batch is open";
+    return;
+  }
+  if (--batchDepth_ > 0) return;
+  PHRAIMS_TRACE_SCOPE("SplitWindow::commitBatch");
+  // exchange first: the steps below may request more work, which runs directly now
+  if (std::exchange(batchRelayout_, false)) layoutFrames(false);
+  if (std::exchange(batchRenumber_, false)) renumberFrames();
+  if (std::exchange(batchPersist_, false)) persistGlobalFrameState();
+  if (std::exchange(batchWindowList_, false)) {
+    updateWindowTitle();
+    rebuildAllWindowMenus();
   }
-  settings->setValue("addresses", addresses);
-  settings->setValue("frameScales", scales);
 }
 
-int SplitWindow::frameIndexFor(SplitFrameWidget *frame) const {
-  if (!frame) return -1;
-  const QVariant v = frame->property("logicalIndex");
-  if (!v.isValid()) return -1;
-  return v.toInt();
+void SplitWindow::requestRelayout() {
+  if (batchDepth_ > 0) {
+    batchRelayout_ = true;
+    return;
+  }
+  layoutFrames(false);
 }
 
-void SplitWindow::stopAllFramesMediaPlayback() {
-  if (!central_) {
-    qDebug() << "SplitWindow::stopAllFramesMediaPlayback: central_ is null, cannot stop media";
+void SplitWindow::requestRenumber() {
+  if (batchDepth_ > 0) {
+    batchRenumber_ = true;
     return;
   }
-  
-  // Find all SplitFrameWidget children and stop their media playback
-  const QList<SplitFrameWidget *> frames = central_->findChildren<SplitFrameWidget *>();
-  for (SplitFrameWidget *frame : frames) {
-    if (frame) {
-      frame->stopMediaPlayback();
-    }
+  renumberFrames();
+}
+
+void SplitWindow::requestWindowListRefresh() {
+  if (batchDepth_ > 0) {
+    batchWindowList_ = true;
+    return;
   }
-  qDebug() << "SplitWindow::stopAllFramesMediaPlayback: stopped media in" << frames.size() << "frame(s)";
+  updateWindowTitle();
+  rebuildAllWindowMenus();
 }
 
-void SplitWindow::saveCurrentSplitterSizes() {
-  saveCurrentSplitterSizes(QString());
+int SplitWindow::frameIndexFor(SplitFrameWidget *frame) const {
+  return frameRegistry_.indexOf(frame);
 }
 
-void SplitWindow::saveCurrentSplitterSizes(const QString &groupPrefix) {
+void SplitWindow::stopAllFramesMediaPlayback() {
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) frame->stopMediaPlayback();
+  qDebug() << "SplitWindow::stopAllFramesMediaPlayback: stopped media in" << frameRegistry_.size() << "frame(s)";
+}
+
+void SplitWindow::saveCurrentSplitterSizes() {
   if (currentSplitters_.empty()) return;
   AppSettings settings;
-  // If no groupPrefix provided, store under splitterSizes/<layout>/<index>
-  if (groupPrefix.isEmpty()) {
-    settings->beginGroup(QStringLiteral("splitterSizes"));
-    settings->beginGroup(layoutModeKey(layoutMode_));
-    for (int i = 0; i < (int)currentSplitters_.size(); ++i) {
-      QSplitter *s = currentSplitters_[i];
-      if (!s) continue;
-      const QList<int> sizes = s->sizes();
-      QVariantList vl;
-      for (int v : sizes) vl << v;
-      settings->setValue(QString::number(i), vl);
-    }
-    settings->endGroup();
-    settings->endGroup();
-  } else {
-    // Create nested groups for the provided prefix (e.g., windows/<id>/splitterSizes)
-    {
-      GroupScope _gs(settings, groupPrefix);
-      settings->beginGroup(layoutModeKey(layoutMode_));
-      for (int i = 0; i < (int)currentSplitters_.size(); ++i) {
-        QSplitter *s = currentSplitters_[i];
-        if (!s) continue;
-        const QList<int> sizes = s->sizes();
-        QVariantList vl;
-        for (int v : sizes) vl << v;
-        settings->setValue(QString::number(i), vl);
-      }
-      settings->endGroup();
-    }
-  }
+  // legacy (no window id) layout: splitterSizes/<layout>/<index>
+  settings->beginGroup(QStringLiteral("splitterSizes"));
+  settings->beginGroup(layoutModeKey(layoutMode_));
+  const QList<QList<int>> all = currentSplitterSizes();
+  for (int i = 0; i < all.size(); ++i) {
+    if (all[i].isEmpty()) continue;
+    QVariantList vl;
+    for (int v : all[i]) vl << v;
+    settings->setValue(QString::number(i), vl);
+  }
+  settings->endGroup();
+  settings->endGroup();
 }
 
-void SplitWindow::restoreSplitterSizes() { restoreSplitterSizes(QString()); }
+QList<QList<int>> SplitWindow::currentSplitterSizes() const {
+  QList<QList<int>> all;
+  all.reserve((int)currentSplitters_.size());
+  for (QSplitter *s : currentSplitters_) {
+    all << (s ? s->sizes() : QList<int>());
+  }
+  return all;
+}
 
-void SplitWindow::restoreSplitterSizes(const QString &groupPrefix) {
+void SplitWindow::restoreSplitterSizes() {
   if (currentSplitters_.empty()) return;
   AppSettings settings;
-  // If no groupPrefix provided, read from splitterSizes/<layout>/<index>
-  if (groupPrefix.isEmpty()) {
-    settings->beginGroup(QStringLiteral("splitterSizes"));
-    settings->beginGroup(layoutModeKey(layoutMode_));
-    for (int i = 0; i < (int)currentSplitters_.size(); ++i) {
-      QSplitter *s = currentSplitters_[i];
-      if (!s) continue;
-      const QVariant v = settings->value(QString::number(i));
-      if (!v.isValid()) continue;
-      const QVariantList vl = v.toList();
-      if (vl.isEmpty()) continue;
-      QList<int> sizes;
-      sizes.reserve(vl.size());
-      for (const QVariant &qv : vl) sizes << qv.toInt();
-      if (!sizes.isEmpty()) s->setSizes(sizes);
-    }
-    settings->endGroup();
-    settings->endGroup();
-  } else {
-    {
-      GroupScope _gs(settings, groupPrefix);
-      settings->beginGroup(layoutModeKey(layoutMode_));
-      for (int i = 0; i < (int)currentSplitters_.size(); ++i) {
-        QSplitter *s = currentSplitters_[i];
-        if (!s) continue;
-        const QVariant v = settings->value(QString::number(i));
-        if (!v.isValid()) continue;
-        const QVariantList vl = v.toList();
-        if (vl.isEmpty()) continue;
-        QList<int> sizes;
-        sizes.reserve(vl.size());
-        for (const QVariant &qv : vl) sizes << qv.toInt();
-        if (!sizes.isEmpty()) s->setSizes(sizes);
-      }
-      settings->endGroup();
-    }
+  // legacy (no window id) layout: splitterSizes/<layout>/<index>
+  settings->beginGroup(QStringLiteral("splitterSizes"));
+  settings->beginGroup(layoutModeKey(layoutMode_));
+  QList<QList<int>> all;
+  for (int i = 0; i < (int)currentSplitters_.size(); ++i) {
+    QList<int> sizes;
+    for (const QVariant &qv : settings->value(QString::number(i)).toList()) sizes << qv.toInt();
+    all << sizes;
+  }
+  settings->endGroup();
+  settings->endGroup();
+  restoreSplitterSizes(all);
+}
+
+void SplitWindow::restoreSplitterSizes(const QList<QList<int>> &sizes) {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::restoreSplitterSizes");
+  const int count = std::min((int)currentSplitters_.size(), (int)sizes.size());
+  for (int i = 0; i < count; ++i) {
+    QSplitter *s = currentSplitters_[i];
+    if (!s || sizes[i].isEmpty()) continue;
+    s->setSizes(sizes[i]);
   }
 }
 
 void SplitWindow::onSplitterDoubleClickResized() {
   // Save splitter sizes after double-click resize
   if (!windowId_.isEmpty()) {
-    saveCurrentSplitterSizes(QStringLiteral("windows/%1/splitterSizes").arg(windowId_));
+    scheduleSessionSave();
   } else {
     saveCurrentSplitterSizes();
   }
@@ -1180,7 +1502,11 @@ void SplitWindow::onSplitterDoubleClickResized() {
 SplitFrameWidget *SplitWindow::focusedFrameOrFirst() const {
   QWidget *fw = QApplication::focusWidget();
   while (fw) {
-    if (auto *frame = qobject_cast<SplitFrameWidget *>(fw)) return frame;
+    if (auto *frame = qobject_cast<SplitFrameWidget *>(fw)) {
+      // focus may sit in another window's frame (or a pooled spare)
+      if (frameRegistry_.contains(frame)) return frame;
+      break;
+    }
     fw = fw->parentWidget();
   }
   if (lastFocusedFrame_) return lastFocusedFrame_;
@@ -1188,32 +1514,14 @@ SplitFrameWidget *SplitWindow::focusedFrameOrFirst() const {
 }
 
 SplitFrameWidget *SplitWindow::firstFrameWidget() const {
-  if (!central_) return nullptr;
-  const QList<SplitFrameWidget *> frames = central_->findChildren<SplitFrameWidget *>();
-  SplitFrameWidget *best = nullptr;
-  int bestIndex = std::numeric_limits<int>::max();
-  for (SplitFrameWidget *frame : frames) {
-    bool ok = false;
-    const int idx = frame->property("logicalIndex").toInt(&ok);
-    if (ok && idx < bestIndex) {
-      bestIndex = idx;
-      best = frame;
-    }
-  }
-  if (best) return best;
-  return central_->findChild<SplitFrameWidget *>();
+  return frameRegistry_.first();
 }
 
 void SplitWindow::onFrameDevToolsRequested(SplitFrameWidget *who, QWebEnginePage *page, const QPoint &pos) {
   Q_UNUSED(who);
   Q_UNUSED(pos);
   if (!page) return;
-  createAndAttachSharedDevToolsForPage(page);
-  if (sharedDevToolsView_) {
-    sharedDevToolsView_->show();
-    sharedDevToolsView_->raise();
-    sharedDevToolsView_->activateWindow();
-  }
+  DevToolsHost::instance().show(page);
   page->triggerAction(QWebEnginePage::InspectElement);
 }
 
@@ -1228,42 +1536,35 @@ void SplitWindow::onFrameOpenLinkInNewFrameRequested(SplitFrameWidget *who, cons
   if (!linkUrl.isValid()) return;
   
   // Get the logical index of the requesting frame
-  const QVariant v = who->property("logicalIndex");
-  if (!v.isValid()) return;
-  int pos = v.toInt();
+  const int pos = frameIndexFor(who);
+  if (pos < 0) return;
   const int newFrameIndex = pos + 1;
   
-  // Try surgical addition first (works for Vertical/Horizontal modes)
-  if (addSingleFrame(pos)) {
-    // addSingleFrame created an empty frame; now set its address
-    if (newFrameIndex >= 0 && newFrameIndex < static_cast<int>(frames_.size())) {
-      frames_[newFrameIndex].address = linkUrl.toString();
-      persistGlobalFrameState();
-      
-      // Find the newly created frame widget and apply the address to it
-      const QString linkAddress = linkUrl.toString();
-      QMetaObject::invokeMethod(this, [this, newFrameIndex, linkAddress]() {
-        if (!central_) return;
-        if (newFrameIndex < 0 || newFrameIndex >= static_cast<int>(frames_.size())) return;
-        const QList<SplitFrameWidget *> frameWidgets = central_->findChildren<SplitFrameWidget *>();
-        for (SplitFrameWidget *frame : frameWidgets) {
-          if (frame->property("logicalIndex").toInt() == newFrameIndex) {
-            frame->setAddress(linkAddress);
-            break;
-          }
-        }
-      }, Qt::QueuedConnection);
-    }
+  // Adopt the page the context menu started loading, if it was for this link
+  SplitFrameWidget *prepared = FramePool::instance().takeSpeculative(profile_, linkUrl);
+  
+  // Surgical addition works in all layout modes
+  if (!addSingleFrame(pos, prepared)) {
+    if (prepared) prepared->deleteLater();
     return;
   }
   
-  // Fall back to rebuildSections for Grid mode
-  FrameState newFrame;
-  newFrame.address = linkUrl.toString();
-  newFrame.scale = 1.0;
-  frames_.insert(frames_.begin() + newFrameIndex, newFrame);
-  persistGlobalFrameState();
-  rebuildSections((int)frames_.size());
+  // addSingleFrame created an empty frame; now set its address
+  if (newFrameIndex >= 0 && newFrameIndex < static_cast<int>(frames_.size())) {
+    frames_[newFrameIndex].address = linkUrl.toString();
+    persistGlobalFrameState();
+    if (prepared) {
+      qDebug() << "onFrameOpenLinkInNewFrameRequested: adopted speculative frame for" << linkUrl;
+      return;
+    }
+    
+    // Apply the address to the newly created frame widget
+    QPointer<SplitFrameWidget> newFrame(frameRegistry_.at(newFrameIndex));
+    const QString linkAddress = linkUrl.toString();
+    QMetaObject::invokeMethod(this, [newFrame, linkAddress]() {
+      if (newFrame) newFrame->setAddress(linkAddress);
+    }, Qt::QueuedConnection);
+  }
 }
 
 void SplitWindow::onFrameInteraction(SplitFrameWidget *who) {
@@ -1272,50 +1573,6 @@ void SplitWindow::onFrameInteraction(SplitFrameWidget *who) {
   lastFocusedFrame_ = who;
 }
 
-void SplitWindow::createAndAttachSharedDevToolsForPage(QWebEnginePage *page) {
-  if (!page) return;
-  if (!sharedDevToolsView_) {
-    sharedDevToolsView_ = new QWebEngineView(this);
-    sharedDevToolsView_->setWindowFlag(Qt::Tool, true);
-    sharedDevToolsView_->setAttribute(Qt::WA_DeleteOnClose);
-
-    QWebEngineProfile *profile = page->profile();
-    auto *devPage = new MyWebEnginePage(profile, sharedDevToolsView_);
-    sharedDevToolsView_->setPage(devPage);
-
-    page->setDevToolsPage(devPage);
-    sharedDevToolsView_->resize(980, 720);
-    sharedDevToolsView_->setWindowTitle(tr("DevTools"));
-
-    // Add a Close action so Cmd/Ctrl+W will hide the DevTools window
-    // rather than destroying it. Hiding preserves the DevTools page
-    // and its localStorage/preferences (e.g., theme choice).
-    QAction *closeAct = new QAction(sharedDevToolsView_);
-    closeAct->setShortcut(QKeySequence::Close);
-    connect(closeAct, &QAction::triggered, sharedDevToolsView_, &QWidget::hide);
-    sharedDevToolsView_->addAction(closeAct);
-
-    // When the shared devtools view is destroyed (app shutdown), only
-    // clear the devToolsPage on the inspected page if it still points
-    // to the dev page we created here. Use QPointer guards so we do
-    // not dereference raw pointers that may already have been deleted
-    // by Qt's shutdown sequence which can cause crashes.
-    {
-      QPointer<QWebEnginePage> pageGuard(page);
-      QPointer<QWebEnginePage> devPageGuard(devPage);
-      connect(sharedDevToolsView_, &QObject::destroyed, this, [this, pageGuard, devPageGuard](QObject *) {
-        if (pageGuard && pageGuard->devToolsPage() == devPageGuard) pageGuard->setDevToolsPage(nullptr);
-        sharedDevToolsView_ = nullptr;
-      });
-    }
-  } else {
-    // reattach the existing shared devtools to the new inspected page
-    if (page->devToolsPage() != sharedDevToolsView_->page()) {
-      page->setDevToolsPage(sharedDevToolsView_->page());
-    }
-  }
-}
-
 void SplitWindow::showDomPatchesManager() {
   // Create the manager as a modeless dialog so the user can interact with
   // DevTools / frames while editing patches. Reapply patches when the
@@ -1324,8 +1581,7 @@ void SplitWindow::showDomPatchesManager() {
   dlg->setAttribute(Qt::WA_DeleteOnClose);
   dlg->show();
   connect(dlg, &QDialog::finished, this, [this](int) {
-    const QList<SplitFrameWidget *> frames = central_->findChildren<SplitFrameWidget *>();
-    for (SplitFrameWidget *f : frames) {
+    for (SplitFrameWidget *f : frameRegistry_.frames()) {
       if (auto *p = f->page()) applyDomPatchesToPage(p);
     }
   });
@@ -1336,21 +1592,8 @@ void SplitWindow::onCloseShortcut() {
   if ((int)frames_.size() > 1) {
     qDebug() << "onCloseShortcut: removing last frame (Cmd-W pressed)";
     
-    // Find the frame with the highest logical index (the last frame)
-    const QList<SplitFrameWidget *> allFrames = central_->findChildren<SplitFrameWidget *>();
-    SplitFrameWidget *lastFrame = nullptr;
-    int maxIndex = -1;
-    
-    for (SplitFrameWidget *frame : allFrames) {
-      const QVariant v = frame->property("logicalIndex");
-      if (v.isValid()) {
-        const int idx = v.toInt();
-        if (idx > maxIndex) {
-          maxIndex = idx;
-          lastFrame = frame;
-        }
-      }
-    }
+    // The last frame in logical order
+    SplitFrameWidget *lastFrame = frameRegistry_.last();
     
     // Remove the last frame surgically without rebuilding all frames
     if (lastFrame) {
@@ -1381,6 +1624,56 @@ void SplitWindow::resetFocusedFrameScale() {
   }
 }
 
+void SplitWindow::setAllFramesScale(double scale) {
+  FrameBatch batch(this);
+  // scaleChanged -> onFrameScaleChanged() records each scale; the batch persists once
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) frame->setScaleFactor(scale, true);
+}
+
+void SplitWindow::adjustAllFramesScale(double delta) {
+  FrameBatch batch(this);
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) frame->setScaleFactor(frame->scaleFactor() + delta, true);
+}
+
+void SplitWindow::reloadAllFrames(bool bypassCache) {
+  FrameBatch batch(this);
+  int reloaded = 0;
+  for (SplitFrameWidget *frame : frameRegistry_.frames()) {
+    if (frame->isContentParked()) continue;
+    frame->reload(bypassCache);
+    ++reloaded;
+  }
+  qDebug() << "reloadAllFrames: reloaded" << reloaded << "of" << frameRegistry_.size() << "frame(s) bypassCache=" << bypassCache;
+}
+
+void SplitWindow::setBackgroundPolicy(const QString &policyKey) {
+  auto &manager = FrameHibernationManager::instance();
+  backgroundPolicyKey_ = policyKey;
+  manager.setWindowPolicy(this, FrameHibernationManager::policyFromKey(policyKey, manager.defaultPolicy()));
+  scheduleSessionSave();
+}
+
+void SplitWindow::setFocusedFrameKeepAlive(bool keepAlive) {
+  SplitFrameWidget *frame = focusedFrameOrFirst();
+  const int pos = frameIndexFor(frame);
+  if (pos < 0 || pos >= (int)frames_.size()) return;
+  frames_[pos].keepAlive = keepAlive;
+  FrameHibernationManager::instance().setKeepAlive(frame, keepAlive);
+  persistGlobalFrameState();
+  qDebug() << "setFocusedFrameKeepAlive: frame" << pos << "keepAlive=" << keepAlive;
+}
+
+void SplitWindow::setFocusedFrameRefreshInterval(int seconds) {
+  SplitFrameWidget *frame = focusedFrameOrFirst();
+  const int pos = frameIndexFor(frame);
+  if (pos < 0 || pos >= (int)frames_.size()) return;
+  frames_[pos].refreshSeconds = std::max(0, seconds);
+  frame->setAutoRefreshHint(frames_[pos].refreshSeconds);
+  RefreshScheduler::instance().setInterval(frame, frames_[pos].refreshSeconds);
+  persistGlobalFrameState();
+  qDebug() << "setFocusedFrameRefreshInterval: frame" << pos << "refreshSeconds=" << frames_[pos].refreshSeconds;
+}
+
 void SplitWindow::showAboutDialog() {
   // Create a custom dialog so we can handle link clicks and open them in Phraims
   QDialog aboutDialog(this);
@@ -1497,44 +1790,27 @@ void SplitWindow::checkForUpdates() {
 
 void SplitWindow::updateWindowMenu() {
   if (!windowMenu_) return;
-  windowMenu_->clear();
-  QAction *minimizeAct = windowMenu_->addAction(tr("Minimize"));
-  minimizeAct->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_M));
-  connect(minimizeAct, &QAction::triggered, this, &QWidget::showMinimized);
-  QAction *closeAct = windowMenu_->addAction(tr("Close Window"));
-  closeAct->setShortcut(QKeySequence::Close);
-  connect(closeAct, &QAction::triggered, this, &SplitWindow::onCloseShortcut);
-  windowMenu_->addSeparator();
-
-  // Use the pre-created icons (created once at app startup) so we don't
-  // redraw the icon pixmaps on every menu update.
-
-  // List all windows
-  int idx = 1;
-  for (SplitWindow *w : g_windows) {
-    if (!w) continue;
-
-    // Build the visible title (no prefix); icon column will show diamond.
-    QString title = w->windowTitle();
-    if (title.isEmpty()) title = QStringLiteral("Window %1").arg(idx);
-
-    const bool minimized = (w->windowState() & Qt::WindowMinimized) || w->isMinimized();
-    const bool active = w->isActiveWindow();
-
-    // Use the title as-is; the icon column displays the minimized
-    // indicator (diamond) so we don't need a text-prefix fallback.
-    QAction *a = windowMenu_->addAction(title);
+  // Full rebuild of the window list; incremental changes go through the
+  // insert/remove/update helpers below.
+  removeWindowMenuEntries(0, (int)windowListActions_.size() - 1);
+  insertWindowMenuEntries(0, WindowListModel::instance().rowCount() - 1);
+}
 
+void SplitWindow::insertWindowMenuEntries(int first, int last) {
+  if (!windowMenu_ || first < 0 || last < first) return;
+  const WindowListModel &model = WindowListModel::instance();
+  for (int row = first; row <= last; ++row) {
+    QPointer<SplitWindow> w = model.windowAt(row);
+    // Use the title as-is; the icon column displays the active/minimized
+    // indicators (pre-created at startup) so we don't need a text prefix.
+    QAction *a = new QAction(windowMenu_);
     // Use our own icons instead of the platform check column so the
     // diamond and active indicator share the same icon column.
     a->setCheckable(false);
-
-    QIcon useIcon = g_windowEmptyIcon;
-    if (active && minimized) useIcon = g_windowCheckDiamondIcon;
-    else if (active) useIcon = g_windowCheckIcon;
-    else if (minimized) useIcon = g_windowDiamondIcon;
-    a->setIcon(useIcon);
     a->setIconVisibleInMenu(true);
+    QAction *before = row < (int)windowListActions_.size() ? windowListActions_[row] : nullptr;
+    windowMenu_->insertAction(before, a);
+    windowListActions_.insert(row, a);
 
     connect(a, &QAction::triggered, this, [w]() {
       if (!w) return;
@@ -1547,19 +1823,49 @@ void SplitWindow::updateWindowMenu() {
       w->raise();
       w->activateWindow();
     });
-    ++idx;
+  }
+  updateWindowMenuEntries(first, last);
+}
+
+void SplitWindow::removeWindowMenuEntries(int first, int last) {
+  if (first < 0 || last < first) return;
+  last = std::min(last, (int)windowListActions_.size() - 1);
+  for (int row = last; row >= first; --row) {
+    delete windowListActions_.takeAt(row);
+  }
+}
+
+void SplitWindow::updateWindowMenuEntries(int first, int last) {
+  const WindowListModel &model = WindowListModel::instance();
+  last = std::min(last, (int)windowListActions_.size() - 1);
+  for (int row = std::max(first, 0); row <= last; ++row) {
+    const QModelIndex idx = model.index(row);
+    QAction *a = windowListActions_[row];
+    a->setText(model.data(idx, Qt::DisplayRole).toString());
+    a->setIcon(model.data(idx, Qt::DecorationRole).value<QIcon>());
   }
 }
 
 void SplitWindow::changeEvent(QEvent *event) {
   if (event && event->type() == QEvent::WindowStateChange) {
     // Refresh menus so the minimized/active indicators update.
-    rebuildAllWindowMenus();
+    WindowListModel::instance().refreshStates();
+    // Freeze/wake frames right away instead of waiting for the next tick.
+    FrameHibernationManager::instance().evaluateWindow(this);
+  } else if (event && event->type() == QEvent::ActivationChange) {
+    // focusChanged doesn't fire for windows without a focus widget.
+    WindowListModel::instance().activeWindowMaybeChanged();
+    // Remember the most recently active window so session restore can
+    // load its frames first on next launch.
+    if (isActiveWindow() && !isIncognito_ && !windowId_.isEmpty()) {
+      SessionStore::instance().setLastActiveWindowId(windowId_);
+    }
   }
   QMainWindow::changeEvent(event);
 }
 
 void SplitWindow::updateProfilesMenu() {
+  PHRAIMS_TRACE_SCOPE("SplitWindow::updateProfilesMenu");
   if (!profilesMenu_) return;
   
   // Remove all profile-specific actions (those after the last separator)
@@ -1602,7 +1908,16 @@ void SplitWindow::switchToProfile(const QString &profileName) {
   }
   
   qDebug() << "switchToProfile: switching from" << currentProfileName_ << "to" << profileName;
-  
+  adoptProfile(profileName);
+
+  // Rebuild all frames with the new profile
+  rebuildSections((int)frames_.size());
+
+  // Persist the profile change immediately
+  savePersistentStateToSettings();
+}
+
+void SplitWindow::adoptProfile(const QString &profileName) {
   currentProfileName_ = profileName;
   profile_ = getProfileByName(profileName);
   
@@ -1611,9 +1926,7 @@ void SplitWindow::switchToProfile(const QString &profileName) {
   // making it the "active" profile application-wide. This provides consistent behavior
   // where the most recently selected profile becomes the default.
   setCurrentProfileName(profileName);
-  
-  // Rebuild all frames with the new profile
-  rebuildSections((int)frames_.size());
+  FramePool::instance().prewarm(profile_);
   
   // Update the profiles menu to reflect the change
   updateProfilesMenu();
@@ -1624,9 +1937,6 @@ void SplitWindow::switchToProfile(const QString &profileName) {
       w->updateProfilesMenu();
     }
   }
-  
-  // Persist the profile change immediately
-  savePersistentStateToSettings();
 }
 
 void SplitWindow::createNewProfile() {
@@ -1,16 +1,23 @@
 #pragma once
 
+#include "FrameRegistry.h"
+#include "SplitterDoubleClickFilter.h"
+#include <QList>
 #include <QMainWindow>
 #include <QString>
 #include <QPointer>
 #include <vector>
 
+struct SessionWindowState;
+class QScrollArea;
+class QTimer;
+
 class QVBoxLayout;
 class QWidget;
 class QWebEngineProfile;
-class QWebEngineView;
 class QWebEnginePage;
 class QSplitter;
+class QAction;
 class QMenu;
 class SplitFrameWidget;
 class SplitterDoubleClickFilter;
@@ -24,20 +31,22 @@ extern bool DEBUG_SHOW_WINDOW_ID;
  * SplitWindow provides the main application window with:
  * - Menu bar (File, View, Layout, Tools, Window)
  * - Splitter-based layout for multiple web view frames
- * - Layout modes: Vertical, Horizontal, and Grid
+ * - Layout modes: Vertical, Horizontal, Grid, and ScrollGrid (virtualized, for many frames)
  * - Persistent state (window geometry, frame addresses, splitter sizes)
  * - Multi-window coordination and Window menu management
- * - Shared DevTools view for debugging
+ * - Access to the application-wide DevToolsHost for debugging
  * - DOM patches management
  *
  * Each window has a unique ID for storing state separately in AppSettings.
  */
 class SplitWindow : public QMainWindow {
   Q_OBJECT
+  /// phraims-bench (bench/BenchMain.cpp) times the private frame operations directly.
+  friend class SplitWindowBench;
 
 public:
   /** @brief Available layout modes for organizing frames */
-  enum LayoutMode { Vertical = 0, Horizontal = 1, Grid = 2 };
+  enum LayoutMode { Vertical = 0, Horizontal = 1, Grid = 2, ScrollGrid = 3 };
 
   /**
    * @brief Constructs a SplitWindow.
@@ -46,17 +55,18 @@ public:
    * @param parent Optional parent widget
    *
    * If windowId is provided, the window loads its saved addresses, layout, geometry,
-   * and splitter sizes from AppSettings group "windows/<windowId>".
+   * and splitter sizes from SessionStore (the session snapshot).
    * Incognito windows use off-the-record profiles and do not persist state.
    */
   SplitWindow(const QString &windowId = QString(), bool isIncognito = false, QWidget *parent = nullptr);
 
   /**
-   * @brief Persists window state to AppSettings.
+   * @brief Persists window state to SessionStore.
    *
-   * Saves addresses, layout mode, window geometry, window state, and splitter sizes
-   * under AppSettings group "windows/<id>". If this window doesn't have an ID yet,
-   * a new UUID is generated so the window will be restorable on next launch.
+   * Saves addresses, layout mode, window geometry, window state, focused frame index,
+   * and splitter sizes as this window's session entry (one journal record). If this
+   * window doesn't have an ID yet, a new UUID is generated so the window will be
+   * restorable on next launch.
    */
   void savePersistentStateToSettings();
 
@@ -93,6 +103,97 @@ public:
    */
   void setFirstFrameAddress(const QString &address);
 
+  /**
+   * @brief Returns the persisted FrameState address for a frame.
+   * @param frame The frame to look up
+   * @return The address stored in frames_, or the frame's address bar text if it is unknown
+   *
+   * Used by FrameHibernationManager to revive discarded pages.
+   */
+  QString frameAddress(SplitFrameWidget *frame) const;
+
+  /**
+   * @brief Returns the window's frames in logical order.
+   * @return Reference to the frame list (valid until frames are added or removed)
+   */
+  const std::vector<SplitFrameWidget*> &frameWidgets() const { return frameRegistry_.frames(); }
+
+  /**
+   * @brief Returns the registry behind frameWidgets() (index, widget and stable ID lookups).
+   * @return Reference to this window's FrameRegistry
+   */
+  const FrameRegistry &frameRegistry() const { return frameRegistry_; }
+
+  /**
+   * @brief Looks up one of this window's frames by its stable ID.
+   * @param id ID from SplitFrameWidget::frameId()
+   * @return The frame, or nullptr if it is not (or no longer) in this window
+   */
+  SplitFrameWidget *frameById(FrameRegistry::FrameId id) const { return frameRegistry_.byId(id); }
+
+  /**
+   * @brief Returns the frame the user interacted with most recently.
+   * @return The frame, or nullptr if none was focused yet
+   */
+  SplitFrameWidget *lastFocusedFrame() const { return lastFocusedFrame_; }
+
+  /**
+   * @brief Opens a batch of addresses as new frames in one layout pass.
+   * @param urls Addresses to append; a lone empty frame is reused for the first one
+   * @param layoutKey `grid`, `scrollgrid`, `vertical` or `horizontal` to switch layouts, or empty to keep the current one
+   * @param profileName Profile to switch to, or empty to keep the current one (ignored for Incognito windows)
+   *
+   * Used by InstanceServer for URLs forwarded from another launch. Existing
+   * frames keep their pages unless the profile changes, which rebuilds all
+   * frames once.
+   */
+  void openFrames(const QStringList &urls, const QString &layoutKey, const QString &profileName);
+
+  /**
+   * @brief Opens a batch of frame operations.
+   *
+   * Until the matching commitBatch(), the relayout, frame renumbering,
+   * frame-state persistence and title/Window menu refresh that adding,
+   * removing, opening, scaling or reloading frames would each do are only
+   * recorded. Batches nest; the outermost commitBatch() performs each
+   * recorded step once, so N changes cost one relayout instead of N.
+   * Prefer FrameBatch, which commits on scope exit.
+   */
+  void beginBatch();
+
+  /**
+   * @brief Closes a batch opened by beginBatch() and applies its deferred work.
+   *
+   * Unbalanced calls are logged and ignored.
+   */
+  void commitBatch();
+
+  /**
+   * @brief Returns whether a batch is open.
+   * @return true between beginBatch() and the outermost commitBatch()
+   */
+  bool isInBatch() const { return batchDepth_ > 0; }
+
+  /**
+   * @brief Sets every frame to the same scale in one batch.
+   * @param scale Scale factor (clamped to the frame limits; 1.0 = 100%)
+   */
+  void setAllFramesScale(double scale);
+
+  /**
+   * @brief Changes every frame's scale by the same step in one batch.
+   * @param delta Amount added to each frame's current scale
+   */
+  void adjustAllFramesScale(double delta);
+
+  /**
+   * @brief Reloads every frame in one batch.
+   * @param bypassCache true to bypass the HTTP cache
+   *
+   * Parked ScrollGrid cells are skipped; they have no page on screen to refresh.
+   */
+  void reloadAllFrames(bool bypassCache = false);
+
 public slots:
   /**
    * @brief Resets the window to a single empty section.
@@ -115,9 +216,11 @@ private slots:
    * @brief Rebuilds the frame layout with the specified number of sections.
    * @param n The number of frames to create
    *
-   * Clears existing frames and creates n new SplitFrameWidget instances
+   * Destroys existing frames and creates n new SplitFrameWidget instances
    * arranged according to the current layoutMode_. Preserves addresses
-   * from the addresses_ vector.
+   * from the frames_ vector. Every page reloads, so this is reserved for
+   * initial construction and profile changes; reorders, additions, removals,
+   * and layout switches move the existing widgets via layoutFrames().
    */
   void rebuildSections(int n);
   
@@ -160,7 +263,7 @@ private slots:
    * @brief Handles the up button click from a frame.
    * @param who The frame that emitted the signal
    *
-   * Moves the frame up (towards index 0) in the addresses list and rebuilds.
+   * Moves the frame up (towards index 0) via swapFrames(); no page reloads.
    */
   void onUpFromFrame(SplitFrameWidget *who);
   
@@ -168,7 +271,7 @@ private slots:
    * @brief Handles the down button click from a frame.
    * @param who The frame that emitted the signal
    *
-   * Moves the frame down (towards higher indices) in the addresses list and rebuilds.
+   * Moves the frame down (towards higher indices) via swapFrames(); no page reloads.
    */
   void onDownFromFrame(SplitFrameWidget *who);
   
@@ -177,9 +280,19 @@ private slots:
    * @param m The new layout mode to apply
    *
    * If selecting the same mode again, resets splitters to default sizes.
-   * Otherwise, switches to the new mode and rebuilds the frame layout.
+   * Otherwise, switches to the new mode. Either way the existing frame
+   * widgets are reparented by layoutFrames() so pages keep their state.
    */
   void setLayoutMode(SplitWindow::LayoutMode m);
+
+  /**
+   * @brief Changes how splitter handle drags resize the frames.
+   * @param mode Opaque (live), Outline (rubber band) or Snapshot (scaled snapshots while dragging)
+   *
+   * Re-lays out the frames with layoutFrames(true) so every splitter gets a
+   * filter for the new mode. The caller persists `layout/splitterResizeMode`.
+   */
+  void setSplitterResizeMode(SplitterResizeMode mode);
   
   /**
    * @brief Sets the window height to match the screen's available height.
@@ -218,15 +331,17 @@ private slots:
   void updateFrameButtonStates(SplitFrameWidget *frame, int totalFrames);
   
   /**
-   * @brief Adds a single frame without rebuilding all frames (Vertical/Horizontal modes only).
+   * @brief Adds a single frame without rebuilding all frames.
    * @param afterIndex The index after which to insert the new frame
-   * @return true if surgical addition succeeded, false if rebuildSections is needed
+   * @param prepared Optional frame that is already loading its page (FramePool::takeSpeculative());
+   *        used as-is instead of a spare. The caller keeps ownership on failure.
+   * @return true on success, false if no layout exists yet
    *
    * Surgically inserts a new frame into the layout, updates logical indices for frames
-   * after the insertion point, and preserves all other frames' state. Only works for
-   * Vertical and Horizontal layout modes; Grid mode requires rebuildSections().
+   * after the insertion point, and preserves all other frames' state. In Grid mode the
+   * existing widgets are reflowed into the new grid shape via layoutFrames().
    */
-  bool addSingleFrame(int afterIndex);
+  bool addSingleFrame(int afterIndex, SplitFrameWidget *prepared = nullptr);
   
   /**
    * @brief Handles address editing from a frame.
@@ -252,7 +367,7 @@ private slots:
    * @param page The QWebEnginePage to inspect
    * @param pos The position where the request originated
    *
-   * Creates or reuses the shared DevTools view and attaches it to the page.
+   * Points the application-wide DevToolsHost at the page and inspects the element.
    */
   void onFrameDevToolsRequested(SplitFrameWidget *who, QWebEnginePage *page, const QPoint &pos);
   
@@ -280,15 +395,6 @@ private slots:
    */
   void onFrameInteraction(SplitFrameWidget *who);
   
-  /**
-   * @brief Creates and attaches the shared DevTools view to a page.
-   * @param page The QWebEnginePage to inspect
-   *
-   * Creates a new DevTools window if needed, or reattaches the existing
-   * DevTools to the new page. The DevTools window is shown as a Tool window.
-   */
-  void createAndAttachSharedDevToolsForPage(QWebEnginePage *page);
-  
   /**
    * @brief Shows the DOM patches manager dialog.
    *
@@ -296,15 +402,45 @@ private slots:
    * reapplies all patches to all frames.
    */
   void showDomPatchesManager();
+
+  /**
+   * @brief Asks for a file and writes the performance log to it (Tools -> Export Performance Log).
+   *
+   * The chosen suffix selects the format (`.json` or `.csv`, CSV by default);
+   * see FrameMetricsSampler::exportLog().
+   */
+  void exportPerformanceLog();
   
   /**
-   * @brief Updates the Window menu with all open windows.
+   * @brief Rebuilds the window list section of the Window menu.
    *
-   * Rebuilds the menu to show all windows in g_windows with appropriate
-   * indicators (checkmark for active, diamond for minimized).
+   * Recreates one entry per WindowListModel row with appropriate indicators
+   * (checkmark for active, diamond for minimized). Only used initially and on
+   * model reset; regular changes go through the incremental helpers below.
    */
   void updateWindowMenu();
 
+  /**
+   * @brief Adds Window menu entries for newly inserted WindowListModel rows.
+   * @param first First inserted row
+   * @param last Last inserted row (inclusive)
+   */
+  void insertWindowMenuEntries(int first, int last);
+
+  /**
+   * @brief Deletes the Window menu entries of removed WindowListModel rows.
+   * @param first First removed row
+   * @param last Last removed row (inclusive)
+   */
+  void removeWindowMenuEntries(int first, int last);
+
+  /**
+   * @brief Copies title and indicator icon from the model into existing entries.
+   * @param first First changed row
+   * @param last Last changed row (inclusive)
+   */
+  void updateWindowMenuEntries(int first, int last);
+
   /**
    * @brief Updates the Profiles menu with all available profiles.
    *
@@ -365,6 +501,26 @@ private slots:
    */
   void resetFocusedFrameScale();
 
+  /**
+   * @brief Sets the focused frame's auto-refresh interval and persists it.
+   * @param seconds Interval in seconds; 0 turns auto-refresh off
+   */
+  void setFocusedFrameRefreshInterval(int seconds);
+
+  /**
+   * @brief Sets what this window's pages do while it is in the background.
+   * @param policyKey FrameHibernationManager::policyKey() value, or empty to follow `background/defaultPolicy`
+   *
+   * Applies the policy right away and persists it with the window's session entry.
+   */
+  void setBackgroundPolicy(const QString &policyKey);
+
+  /**
+   * @brief Exempts the focused frame from background throttling (or removes the exemption).
+   * @param keepAlive true to keep the frame's page running while hidden
+   */
+  void setFocusedFrameKeepAlive(bool keepAlive);
+
   /**
    * @brief Shows the About dialog with version info and project link.
    *
@@ -400,7 +556,10 @@ protected:
    * @param event The change event
    *
    * Refreshes all Window menus when window state changes (minimized,
-   * activated) to update the indicators.
+   * activated) to update the indicators, and asks FrameHibernationManager
+   * to re-evaluate this window's frames so restored windows wake at once.
+   * On activation, records this window as SessionStore's last active
+   * window for prioritized session restore.
    */
   void changeEvent(QEvent *event) override;
 
@@ -411,14 +570,32 @@ private:
   struct FrameState {
     QString address;  ///< Last loaded address
     double scale = 1.0; ///< UI/content scale multiplier
+    int refreshSeconds = 0; ///< Auto-refresh interval in seconds (0 = off), driven by RefreshScheduler
+    bool keepAlive = false; ///< Exempt from background throttling (FrameHibernationManager::setKeepAlive)
   };
 
   /**
    * @brief Converts a layout mode enum to a settings key string.
    * @param m The layout mode
-   * @return String key: "vertical", "horizontal", or "grid"
+   * @return String key: "vertical", "horizontal", "grid", or "scrollgrid"
    */
   static QString layoutModeKey(SplitWindow::LayoutMode m);
+
+  /**
+   * @brief Parses a layout settings key.
+   * @param key "vertical", "horizontal", "grid" or "scrollgrid"
+   * @param ok Set to whether @p key was recognized
+   * @return The layout mode, or Vertical if @p key is unknown
+   */
+  static SplitWindow::LayoutMode layoutModeFromKey(const QString &key, bool *ok);
+
+  /**
+   * @brief Makes @p profileName this window's profile without rebuilding frames.
+   * @param profileName Existing profile name
+   *
+   * Shared by switchToProfile() and openFrames(); callers rebuild the frames.
+   */
+  void adoptProfile(const QString &profileName);
   
   /**
    * @brief Saves current splitter sizes to AppSettings.
@@ -428,10 +605,10 @@ private:
   void saveCurrentSplitterSizes();
   
   /**
-   * @brief Saves current splitter sizes to a specific settings path.
-   * @param groupPrefix The AppSettings group path prefix (e.g., "windows/id/splitterSizes")
+   * @brief Returns the sizes of every current splitter.
+   * @return Sizes per splitter index (empty entries for missing splitters)
    */
-  void saveCurrentSplitterSizes(const QString &groupPrefix);
+  QList<QList<int>> currentSplitterSizes() const;
   
   /**
    * @brief Restores splitter sizes from AppSettings.
@@ -441,10 +618,26 @@ private:
   void restoreSplitterSizes();
   
   /**
-   * @brief Restores splitter sizes from a specific settings path.
-   * @param groupPrefix The AppSettings group path prefix
+   * @brief Applies saved splitter sizes to the current splitters.
+   * @param sizes Sizes per splitter index; empty entries are skipped
    */
-  void restoreSplitterSizes(const QString &groupPrefix);
+  void restoreSplitterSizes(const QList<QList<int>> &sizes);
+
+  /**
+   * @brief Builds this window's session entry from its current state.
+   * @param id Window id to store the state under
+   * @return Full state; splitter sizes of other layouts are kept from the stored entry
+   */
+  SessionWindowState sessionState(const QString &id) const;
+
+  /**
+   * @brief Saves this window's session entry after a short quiet period.
+   *
+   * Live changes (navigation, scale, splitter drags) land in the session
+   * journal coalesced, not once per event. No-op for Incognito windows and
+   * windows without an id.
+   */
+  void scheduleSessionSave();
 
   /**
    * @brief Slot called when splitter is resized via double-click.
@@ -454,6 +647,58 @@ private:
    */
   void onSplitterDoubleClickResized();
 
+  /**
+   * @brief Creates a frame widget for frames_[index] and wires its signals.
+   * @param index Logical index of the frame (also used for the initial palette)
+   * @param spare Pre-initialized frame from FramePool::take() to use instead of constructing one
+   * @return The new frame; the caller loads its address and adds it to frameRegistry_
+   *
+   * A spare already has its page attached and shows the instruction page, so
+   * callers adding an empty frame can skip setAddress().
+   */
+  SplitFrameWidget *createFrameWidget(int index, SplitFrameWidget *spare = nullptr);
+
+  /**
+   * @brief Arranges frameWidgets_ into a fresh splitter tree for layoutMode_.
+   * @param preserveSizes Reapply the previous splitter sizes if the splitter shape is unchanged
+   *
+   * Existing frame widgets are reparented into the new splitters, so their pages,
+   * scroll positions, and media keep running. The old (now empty) container is
+   * swapped out of layout_ and deleted; otherwise sizes are distributed evenly.
+   */
+  void layoutFrames(bool preserveSizes);
+
+  /** @brief Returns whether the layout is one of the grids, whose shape depends on the frame count. */
+  bool isGridLayout() const { return layoutMode_ == Grid || layoutMode_ == ScrollGrid; }
+
+  /** @brief Coalesces viewport changes (scrolling, resizing) into one updateScrollGridViewport(). */
+  void scheduleViewportUpdate();
+
+  /**
+   * @brief Parks ScrollGrid cells outside the viewport (plus one row) and unparks the rest.
+   *
+   * Parked cells show a placeholder and their pages are discarded through
+   * FrameHibernationManager::discardHiddenFrame(); FrameState is untouched.
+   * Cells coming back into range are woken (or loaded) right away. In the
+   * other layouts every frame is unparked.
+   */
+  void updateScrollGridViewport();
+
+  /**
+   * @brief Syncs the alternating palette and button states with frameRegistry_ order.
+   */
+  void renumberFrames();
+
+  /**
+   * @brief Swaps two frames in the model and on screen without recreating them.
+   * @param a Logical index of the first frame
+   * @param b Logical index of the second frame
+   *
+   * Vertical/Horizontal layouts move the widgets with QSplitter::insertWidget();
+   * Grid reflows via layoutFrames(true). Slot sizes are kept in both cases.
+   */
+  void swapFrames(int a, int b);
+
   /**
    * @brief Finds the focused SplitFrameWidget or falls back to the first frame.
    * @return Pointer to the focused frame, or the first frame if none focused
@@ -476,13 +721,23 @@ private:
    * @brief Persists the shared frame state (addresses + scales) to root AppSettings.
    *
    * Used for default window templates and backwards compatibility when no window ID is set.
+   * Also schedules a session save for windows that have an id.
    */
   void persistGlobalFrameState();
 
+  /** @brief Calls layoutFrames(false) now, or at commit inside a batch. */
+  void requestRelayout();
+
+  /** @brief Calls renumberFrames() now, or at commit inside a batch. */
+  void requestRenumber();
+
+  /** @brief Refreshes the title and every Window menu now, or at commit inside a batch. */
+  void requestWindowListRefresh();
+
   /**
    * @brief Stops media playback in all frames.
    *
-   * Iterates through all SplitFrameWidget children and calls stopMediaPlayback()
+   * Iterates through all registered frames and calls stopMediaPlayback()
    * on each to ensure all audio/video stops immediately. This is called when the
    * window is closing to prevent continued playback after the window is gone.
    */
@@ -491,15 +746,55 @@ private:
   QWidget *central_ = nullptr;              ///< Central widget containing the layout
   QVBoxLayout *layout_ = nullptr;           ///< Main vertical layout
   std::vector<FrameState> frames_;          ///< Per-frame address + scale state
+  FrameRegistry frameRegistry_;             ///< Frame widgets in logical order (parallel to frames_) with stable IDs
+  QWidget *container_ = nullptr;            ///< Root splitter (or ScrollGrid scroll area) currently installed in layout_
+  QPointer<QScrollArea> scrollArea_;        ///< ScrollGrid viewport, null in the other layouts
+  QTimer *viewportTimer_ = nullptr;         ///< Debounces updateScrollGridViewport()
+  int scrollGridColumns_ = 4;               ///< layout/scrollGridColumns
+  int scrollGridRowHeight_ = 320;           ///< layout/scrollGridRowHeight (pixels)
+  SplitterResizeMode splitterResizeMode_ = SplitterResizeMode::Opaque; ///< layout/splitterResizeMode
+  int splitterResizeIntervalMs_ = 0;        ///< layout/splitterResizeIntervalMs (Snapshot mode throttle, 0 = on release)
   QWebEngineProfile *profile_ = nullptr;    ///< Shared web engine profile
   LayoutMode layoutMode_ = Vertical;        ///< Current layout mode
   std::vector<QSplitter*> currentSplitters_; ///< Active splitters for current layout
-  QWebEngineView *sharedDevToolsView_ = nullptr; ///< Shared DevTools window
   bool restoredOnStartup_ = false;          ///< Whether state was restored on construction
   bool isIncognito_ = false;                ///< Whether this is an Incognito (private) window
   QString windowId_;                        ///< Unique ID for this window instance
   QMenu *windowMenu_ = nullptr;             ///< The Window menu for this window
+  QList<QAction *> windowListActions_;      ///< Window menu entries, one per WindowListModel row
   QMenu *profilesMenu_ = nullptr;           ///< The Profiles menu for this window
   QString currentProfileName_;              ///< The profile currently used by this window
+  QString backgroundPolicyKey_;             ///< Session backgroundPolicy; empty follows background/defaultPolicy
   SplitFrameWidget *lastFocusedFrame_ = nullptr; ///< Tracks the most recently focused frame
+  bool deferFrameLoads_ = false;            ///< Route initial loads through RestoreScheduler (startup only)
+  int restoreFocusIndex_ = -1;              ///< Persisted focusedFrameIndex for prioritized restore
+  QTimer *sessionSaveTimer_ = nullptr;      ///< Coalesces scheduleSessionSave() calls
+  int batchDepth_ = 0;                      ///< Nesting depth of beginBatch()
+  bool batchRelayout_ = false;              ///< A relayout was requested inside the batch
+  bool batchRenumber_ = false;              ///< renumberFrames() was requested inside the batch
+  bool batchPersist_ = false;               ///< persistGlobalFrameState() was requested inside the batch
+  bool batchWindowList_ = false;            ///< A title/Window menu refresh was requested inside the batch
+};
+
+/**
+ * @brief RAII helper that keeps a SplitWindow batch open for its scope.
+ *
+ * Calls SplitWindow::beginBatch() on construction and commitBatch() on
+ * destruction, so early returns cannot leave a batch open. A null window
+ * makes it a no-op.
+ */
+struct FrameBatch {
+  QPointer<SplitWindow> window; ///< Window whose batch is open (cleared if it is destroyed)
+
+  /**
+   * @brief Opens a batch on @p w.
+   * @param w The window to batch, or nullptr
+   */
+  explicit FrameBatch(SplitWindow *w) : window(w) { if (window) window->beginBatch(); }
+
+  /** @brief Commits the batch. */
+  ~FrameBatch() { if (window) window->commitBatch(); }
+
+  FrameBatch(const FrameBatch &) = delete;
+  FrameBatch &operator=(const FrameBatch &) = delete;
 };
@@ -1,10 +1,111 @@
 #pragma once
 
 #include <QObject>
+#include <QElapsedTimer>
 #include <QEvent>
+#include <QList>
 #include <QMouseEvent>
+#include <QPainter>
+#include <QPixmap>
+#include <QPointer>
 #include <QSplitter>
 #include <QSplitterHandle>
+#include <QString>
+#include <QWidget>
+#include <algorithm>
+
+/**
+ * @brief How a splitter handle drag resizes the panes (`layout/splitterResizeMode`).
+ */
+enum class SplitterResizeMode {
+  Opaque,   ///< Qt's live resize: panes (and their pages) follow every mouse move
+  Outline,  ///< Qt's rubber band: panes resize once, on release
+  Snapshot  ///< Panes are painted as scaled snapshots while dragging; real sizes applied on release or throttled
+};
+
+/**
+ * @brief Paints scaled pane snapshots over a splitter during a Snapshot-mode drag.
+ *
+ * Mouse-transparent widget covering the splitter completely. The panes
+ * underneath keep their geometry, so Chromium does not relayout or
+ * re-raster until SplitterDoubleClickFilter applies the new sizes.
+ *
+ * QSplitter turns every child widget into a new pane, so the overlay is a
+ * child of the nearest ancestor that is not a splitter (see hostFor()) and
+ * follows the splitter's geometry through event filters on the splitter
+ * and the widgets between it and that host.
+ */
+class SplitterSnapshotOverlay : public QWidget {
+public:
+  /**
+   * @brief Returns the widget an overlay for @p splitter is parented to.
+   * @param splitter Splitter to cover
+   * @return Nearest ancestor that is not a QSplitter, or nullptr for a top-level splitter
+   */
+  static QWidget *hostFor(QSplitter *splitter) {
+    QWidget *host = splitter ? splitter->parentWidget() : nullptr;
+    while (host && qobject_cast<QSplitter *>(host)) host = host->parentWidget();
+    return host;
+  }
+
+  /**
+   * @brief Creates the overlay on top of a splitter.
+   * @param splitter Splitter to cover; hostFor() must not be null
+   * @param shots One grab per splitter widget, in widget order
+   */
+  SplitterSnapshotOverlay(QSplitter *splitter, const QList<QPixmap> &shots)
+    : QWidget(hostFor(splitter)), splitter_(splitter), shots_(shots), orientation_(splitter->orientation()),
+      handleWidth_(splitter->handleWidth()) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    // moving or resizing any of these changes where the splitter sits in the host
+    for (QWidget *w = splitter; w && w != parentWidget(); w = w->parentWidget()) w->installEventFilter(this);
+    syncGeometry();
+  }
+
+  /**
+   * @brief Updates the previewed pane sizes and repaints.
+   * @param sizes Pane extents along the splitter orientation, as for QSplitter::setSizes()
+   */
+  void setSizes(const QList<int> &sizes) {
+    sizes_ = sizes;
+    update();
+  }
+
+protected:
+  /** @brief Keeps the overlay over the splitter when it or an ancestor up to the host moves or resizes. */
+  bool eventFilter(QObject *watched, QEvent *event) override {
+    if (event->type() == QEvent::Move || event->type() == QEvent::Resize) syncGeometry();
+    return QWidget::eventFilter(watched, event);
+  }
+
+  /** @brief Draws each snapshot stretched into its previewed pane rectangle. */
+  void paintEvent(QPaintEvent *) override {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+    int pos = 0;
+    for (int i = 0; i < sizes_.size() && i < shots_.size(); ++i) {
+      const int extent = sizes_[i];
+      if (extent <= 0) continue;
+      const QRect pane = orientation_ == Qt::Horizontal ? QRect(pos, 0, extent, height()) : QRect(0, pos, width(), extent);
+      if (!shots_[i].isNull()) painter.drawPixmap(pane, shots_[i]);
+      pos += extent + handleWidth_;
+    }
+  }
+
+private:
+  /** @brief Places the overlay over the splitter, in host coordinates. */
+  void syncGeometry() {
+    if (!splitter_ || !parentWidget()) return;
+    setGeometry(QRect(splitter_->mapTo(parentWidget(), QPoint(0, 0)), splitter_->size()));
+  }
+
+  QPointer<QSplitter> splitter_;    ///< Splitter being covered
+  QList<QPixmap> shots_;            ///< Pane grabs taken when the drag started
+  QList<int> sizes_;                ///< Previewed pane extents
+  Qt::Orientation orientation_;     ///< Splitter orientation
+  int handleWidth_ = 0;             ///< Gap left between panes for the handles
+};
 
 /**
  * @brief Event filter to handle double-click on splitter handles for equal resizing.
@@ -13,6 +114,13 @@
  * resizes the two adjacent widgets to equal sizes. This provides a quick
  * way to reset custom splitter positions to a balanced 50/50 split.
  *
+ * It also applies the window's SplitterResizeMode. In Snapshot mode the
+ * filter takes over handle drags: it grabs every pane when the drag starts,
+ * paints the grabs scaled to the previewed sizes through a
+ * SplitterSnapshotOverlay, and calls QSplitter::setSizes() only when the
+ * mouse is released (or every @p applyIntervalMs while dragging), so dense
+ * grids don't relayout every web view on each mouse move.
+ *
  * Usage:
  * @code
  * QSplitter *splitter = new QSplitter();
@@ -27,14 +135,42 @@ public:
    * @brief Constructs a splitter double-click filter and installs it on all handles.
    * @param splitter The QSplitter whose handles should be monitored
    * @param parent Parent object for memory management
+   * @param mode How handle drags resize the panes
+   * @param applyIntervalMs Snapshot mode only: apply real sizes this often while dragging (0 = on release only)
    */
-  explicit SplitterDoubleClickFilter(QSplitter *splitter, QObject *parent = nullptr) 
-    : QObject(parent), splitter_(splitter) {
+  explicit SplitterDoubleClickFilter(QSplitter *splitter, QObject *parent = nullptr,
+                                     SplitterResizeMode mode = SplitterResizeMode::Opaque, int applyIntervalMs = 0)
+    : QObject(parent), splitter_(splitter), mode_(mode), applyIntervalMs_(applyIntervalMs) {
     if (splitter_) {
+      splitter_->setOpaqueResize(mode_ != SplitterResizeMode::Outline);
       installOnHandles();
     }
   }
 
+  /**
+   * @brief Parses a `layout/splitterResizeMode` value.
+   * @param key "opaque", "outline" or "snapshot"
+   * @return The mode, or Opaque for unknown keys
+   */
+  static SplitterResizeMode resizeModeFromKey(const QString &key) {
+    if (key == QLatin1String("outline")) return SplitterResizeMode::Outline;
+    if (key == QLatin1String("snapshot")) return SplitterResizeMode::Snapshot;
+    return SplitterResizeMode::Opaque;
+  }
+
+  /**
+   * @brief Returns the settings key for a resize mode.
+   * @param mode The mode
+   * @return "opaque", "outline" or "snapshot"
+   */
+  static QString resizeModeKey(SplitterResizeMode mode) {
+    switch (mode) {
+      case SplitterResizeMode::Outline: return QStringLiteral("outline");
+      case SplitterResizeMode::Snapshot: return QStringLiteral("snapshot");
+      case SplitterResizeMode::Opaque: default: return QStringLiteral("opaque");
+    }
+  }
+
 protected:
   /**
    * @brief Filters events to detect double-clicks on splitter handles.
@@ -48,18 +184,41 @@ protected:
    * will be persisted through the normal save mechanism.
    */
   bool eventFilter(QObject *obj, QEvent *event) override {
+    if (mode_ == SplitterResizeMode::Snapshot && splitter_) {
+      switch (event->type()) {
+        case QEvent::MouseButtonPress: {
+          auto *mouseEvent = static_cast<QMouseEvent *>(event);
+          const int handleIndex = handleIndexOf(obj);
+          if (mouseEvent->button() == Qt::LeftButton && handleIndex > 0) {
+            beginSnapshotDrag(handleIndex, mouseEvent->globalPosition().toPoint());
+            return true;
+          }
+          break;
+        }
+        case QEvent::MouseMove:
+          if (dragHandle_ > 0) {
+            updateSnapshotDrag(static_cast<QMouseEvent *>(event)->globalPosition().toPoint());
+            return true;
+          }
+          break;
+        case QEvent::MouseButtonRelease:
+          if (dragHandle_ > 0 && static_cast<QMouseEvent *>(event)->button() == Qt::LeftButton) {
+            updateSnapshotDrag(static_cast<QMouseEvent *>(event)->globalPosition().toPoint());
+            endSnapshotDrag();
+            return true;
+          }
+          break;
+        default:
+          break;
+      }
+    }
     if (event->type() == QEvent::MouseButtonDblClick) {
       QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
       if (mouseEvent->button() == Qt::LeftButton && splitter_) {
         // Find which handle was double-clicked.
         // QSplitter handles are indexed from 1, where handle(i) separates widgets i-1 and i.
-        int widgetIndex = -1;
-        for (int i = 1; i < splitter_->count(); ++i) {
-          if (splitter_->handle(i) == obj) {
-            widgetIndex = i - 1;  // Widget index for the left/top widget of this handle
-            break;
-          }
-        }
+        const int handleIndex = handleIndexOf(obj);
+        const int widgetIndex = handleIndex > 0 ? handleIndex - 1 : -1;  // Widget index for the left/top widget of this handle
 
         // Ensure we have valid adjacent widgets to resize
         if (widgetIndex >= 0 && widgetIndex + 1 < splitter_->count()) {
@@ -90,10 +249,12 @@ protected:
 
 signals:
   /**
-   * @brief Emitted when the splitter is resized via double-click.
+   * @brief Emitted when the filter resizes the panes itself.
    *
-   * This signal can be used by the parent window to trigger persistence
-   * of the new splitter sizes.
+   * That is a double-click, or a Snapshot-mode drag applying its sizes
+   * (throttled or on release). QSplitter::setSizes() does not emit
+   * QSplitter::splitterMoved, so this is the only notification of those
+   * changes; the parent window uses it to persist the new splitter sizes.
    */
   void splitterResized();
 
@@ -115,5 +276,95 @@ private:
     }
   }
 
+  /**
+   * @brief Returns the index of a splitter handle.
+   * @param obj Object that received the event
+   * @return Handle index (>= 1), or -1 if @p obj is not one of the splitter's handles
+   */
+  int handleIndexOf(QObject *obj) const {
+    for (int i = 1; i < splitter_->count(); ++i) {
+      if (splitter_->handle(i) == obj) return i;
+    }
+    return -1;
+  }
+
+  /** @brief Returns a pane's minimum extent along the splitter orientation. */
+  int minimumExtent(QWidget *widget) const {
+    if (!widget) return 0;
+    if (splitter_->orientation() == Qt::Horizontal) return std::max(widget->minimumWidth(), widget->minimumSizeHint().width());
+    return std::max(widget->minimumHeight(), widget->minimumSizeHint().height());
+  }
+
+  /** @brief Returns the coordinate of @p globalPos along the splitter orientation. */
+  int along(const QPoint &globalPos) const {
+    return splitter_->orientation() == Qt::Horizontal ? globalPos.x() : globalPos.y();
+  }
+
+  /**
+   * @brief Grabs every pane and covers the splitter with their snapshots.
+   * @param handleIndex Handle being dragged
+   * @param globalPos Mouse position at the press
+   */
+  void beginSnapshotDrag(int handleIndex, const QPoint &globalPos) {
+    dragHandle_ = handleIndex;
+    dragStart_ = along(globalPos);
+    startSizes_ = splitter_->sizes();
+    previewSizes_ = startSizes_;
+    QList<QPixmap> shots;
+    for (int i = 0; i < splitter_->count(); ++i) {
+      QWidget *pane = splitter_->widget(i);
+      shots.append(pane && pane->isVisible() ? pane->grab() : QPixmap());
+    }
+    // a top-level splitter has nowhere to put the overlay; the drag then
+    // shows no preview and still applies the sizes on release
+    if (SplitterSnapshotOverlay::hostFor(splitter_)) {
+      overlay_ = new SplitterSnapshotOverlay(splitter_, shots);
+      overlay_->setSizes(previewSizes_);
+      overlay_->show();
+      overlay_->raise();
+    }
+    sinceApply_.start();
+  }
+
+  /**
+   * @brief Moves the previewed boundary to the mouse, applying real sizes when the throttle allows.
+   * @param globalPos Current mouse position
+   */
+  void updateSnapshotDrag(const QPoint &globalPos) {
+    const int first = dragHandle_ - 1;
+    const int second = dragHandle_;
+    if (second >= startSizes_.size()) return;
+    const int total = startSizes_[first] + startSizes_[second];
+    const int low = std::min(minimumExtent(splitter_->widget(first)), total);
+    const int high = std::max(low, total - minimumExtent(splitter_->widget(second)));
+    const int extent = std::clamp(startSizes_[first] + along(globalPos) - dragStart_, low, high);
+    previewSizes_[first] = extent;
+    previewSizes_[second] = total - extent;
+    if (overlay_) overlay_->setSizes(previewSizes_);
+    if (applyIntervalMs_ > 0 && sinceApply_.elapsed() >= applyIntervalMs_) {
+      splitter_->setSizes(previewSizes_);
+      sinceApply_.restart();
+      // setSizes() does not emit splitterMoved
+      emit splitterResized();
+    }
+  }
+
+  /** @brief Applies the final sizes and removes the overlay. */
+  void endSnapshotDrag() {
+    delete overlay_.data();
+    dragHandle_ = -1;
+    if (previewSizes_ == splitter_->sizes()) return;
+    splitter_->setSizes(previewSizes_);
+    emit splitterResized();
+  }
+
   QSplitter *splitter_ = nullptr;  ///< The splitter being monitored
+  SplitterResizeMode mode_ = SplitterResizeMode::Opaque; ///< How handle drags resize the panes
+  int applyIntervalMs_ = 0;        ///< Snapshot mode: throttle for applying real sizes while dragging (0 = release only)
+  int dragHandle_ = -1;            ///< Handle being dragged in Snapshot mode, -1 when idle
+  int dragStart_ = 0;              ///< Mouse coordinate along the orientation at the press
+  QList<int> startSizes_;          ///< Pane sizes when the drag started
+  QList<int> previewSizes_;        ///< Pane sizes currently previewed
+  QElapsedTimer sinceApply_;       ///< Time since sizes were last applied during the drag
+  QPointer<SplitterSnapshotOverlay> overlay_; ///< Snapshot overlay while dragging
 };
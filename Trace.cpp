@@ -0,0 +1,158 @@
+#include "Trace.h"
+#include "AppSettings.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QThread>
+#include <atomic>
+#include <vector>
+
+namespace {
+  constexpr const char *TRACE_ENV_VAR = "PHRAIMS_TRACE";
+  constexpr int TRACE_RESERVE_EVENTS = 1024; // avoid reallocations during a typical cold start
+
+  struct TraceEvent {
+    const char *name;
+    char phase;    // 'X' complete, 'i' instant
+    qint64 tsUs;
+    qint64 durUs;
+    int tid;
+    QString detail;
+  };
+
+  std::atomic<bool> g_traceEnabled{false};
+  QElapsedTimer g_traceClock;
+  QString g_tracePath;
+  QMutex g_traceMutex;                  // guards the members below
+  std::vector<TraceEvent> g_traceEvents;
+  QHash<Qt::HANDLE, int> g_traceThreadIds;
+
+  qint64 nowUs() { return g_traceClock.nsecsElapsed() / 1000; }
+
+  // Chrome's viewer groups by tid; map native handles to small stable numbers.
+  // Caller holds g_traceMutex.
+  int traceThreadId() {
+    const Qt::HANDLE handle = QThread::currentThreadId();
+    auto it = g_traceThreadIds.constFind(handle);
+    if (it != g_traceThreadIds.constEnd()) return it.value();
+    const int id = g_traceThreadIds.size() + 1;
+    g_traceThreadIds.insert(handle, id);
+    return id;
+  }
+
+  void recordEvent(const char *name, char phase, qint64 tsUs, qint64 durUs, const QString &detail) {
+    QMutexLocker lock(&g_traceMutex);
+    g_traceEvents.push_back(TraceEvent{name, phase, tsUs, durUs, traceThreadId(), detail});
+  }
+}
+
+void initTracing() {
+  if (g_traceEnabled) return;
+  const QByteArray env = qgetenv(TRACE_ENV_VAR).trimmed();
+  bool enabled = false;
+  QString path;
+  if (!env.isEmpty() && env != "0") {
+    enabled = true;
+    if (env != "1" && env.toLower() != "true") path = QString::fromLocal8Bit(env);
+  } else {
+    AppSettings s;
+    enabled = s->value("trace/enabled", false).toBool();
+  }
+  if (!enabled) return;
+
+  if (path.isEmpty()) {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/traces");
+    path = dir + QStringLiteral("/trace-%1.json").arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss")));
+  }
+  g_tracePath = path;
+  {
+    QMutexLocker lock(&g_traceMutex);
+    g_traceEvents.reserve(TRACE_RESERVE_EVENTS);
+    traceThreadId(); // the calling (main) thread becomes tid 1
+  }
+  g_traceClock.start();
+  g_traceEnabled = true;
+  qDebug() << "initTracing: recording startup trace to" << g_tracePath;
+}
+
+bool isTracingEnabled() {
+  return g_traceEnabled;
+}
+
+void traceInstant(const char *name, const QString &detail) {
+  if (!g_traceEnabled) return;
+  recordEvent(name, 'i', nowUs(), 0, detail);
+}
+
+void writeTraceFile() {
+  if (!g_traceEnabled) return;
+
+  QJsonArray events;
+  const qint64 pid = QCoreApplication::applicationPid();
+  {
+    QMutexLocker lock(&g_traceMutex);
+    for (auto it = g_traceThreadIds.constBegin(); it != g_traceThreadIds.constEnd(); ++it) {
+      QJsonObject meta;
+      meta["name"] = QStringLiteral("thread_name");
+      meta["ph"] = QStringLiteral("M");
+      meta["pid"] = pid;
+      meta["tid"] = it.value();
+      meta["args"] = QJsonObject{{QStringLiteral("name"), it.value() == 1 ? QStringLiteral("main") : QStringLiteral("thread %1").arg(it.value())}};
+      events.append(meta);
+    }
+    for (const TraceEvent &e : g_traceEvents) {
+      QJsonObject o;
+      o["name"] = QString::fromLatin1(e.name);
+      o["cat"] = QStringLiteral("phraims");
+      o["ph"] = QString(QLatin1Char(e.phase));
+      o["ts"] = double(e.tsUs);
+      o["pid"] = pid;
+      o["tid"] = e.tid;
+      if (e.phase == 'X') o["dur"] = double(e.durUs);
+      if (e.phase == 'i') o["s"] = QStringLiteral("p"); // process-wide marker line
+      if (!e.detail.isEmpty()) o["args"] = QJsonObject{{QStringLiteral("detail"), e.detail}};
+      events.append(o);
+    }
+  }
+  QJsonObject process;
+  process["name"] = QStringLiteral("process_name");
+  process["ph"] = QStringLiteral("M");
+  process["pid"] = pid;
+  process["args"] = QJsonObject{{QStringLiteral("name"), QCoreApplication::applicationName()}};
+  events.prepend(process);
+
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = QStringLiteral("ms");
+
+  QDir().mkpath(QFileInfo(g_tracePath).absolutePath());
+  QFile file(g_tracePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning() << "writeTraceFile: cannot write" << g_tracePath << file.errorString();
+    return;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  qDebug() << "writeTraceFile: wrote" << events.size() << "event(s) to" << g_tracePath;
+}
+
+TraceScope::TraceScope(const char *name, const QString &detail) : name_(name) {
+  if (!g_traceEnabled) return;
+  detail_ = detail;
+  startUs_ = nowUs();
+}
+
+TraceScope::~TraceScope() {
+  if (startUs_ < 0) return;
+  recordEvent(name_, 'X', startUs_, nowUs() - startUs_, detail_);
+}
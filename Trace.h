@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * Lightweight scoped tracing for attributing startup time.
+ *
+ * Tracing is off unless the `PHRAIMS_TRACE` environment variable or the
+ * `trace/enabled` setting turns it on. When off, a trace scope costs one
+ * branch on a global flag. When on, each scope records a Chrome trace-format
+ * "complete" event (name, start, duration, thread) into an in-memory buffer,
+ * and writeTraceFile() dumps the buffer as JSON that can be loaded in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * `PHRAIMS_TRACE=1` writes to `<AppDataLocation>/traces/trace-<timestamp>.json`;
+ * any other value except `0` is used as the output file path.
+ *
+ * Usage:
+ * @code
+ *   void performLegacyMigration() {
+ *     PHRAIMS_TRACE_SCOPE("performLegacyMigration");
+ *     ...
+ *   }
+ * @endcode
+ */
+
+/**
+ * @brief Reads the environment/settings switches and starts the trace clock.
+ *
+ * Call once at the top of main(), after the application name is set (the
+ * settings file and default output path depend on it) and before the
+ * single-instance probe so the whole cold start is covered.
+ */
+void initTracing();
+
+/**
+ * @brief Returns whether trace events are currently being recorded.
+ * @return True if initTracing() enabled tracing
+ */
+bool isTracingEnabled();
+
+/**
+ * @brief Records a zero-duration marker event.
+ * @param name Event name; must be a string literal or otherwise outlive the trace
+ * @param detail Optional text shown in the event's args (e.g. a URL or id)
+ */
+void traceInstant(const char *name, const QString &detail = QString());
+
+/**
+ * @brief Writes every event recorded so far to the trace file.
+ *
+ * Rewrites the whole file each time, so it can be called at milestones
+ * (end of session restore) and again on quit. Does nothing when tracing
+ * is disabled.
+ */
+void writeTraceFile();
+
+/**
+ * @brief RAII helper recording the lifetime of a scope as one trace event.
+ *
+ * Prefer the PHRAIMS_TRACE_SCOPE / PHRAIMS_TRACE_SCOPE_DETAIL macros, which
+ * give the object a unique name.
+ */
+class TraceScope {
+public:
+  /**
+   * @brief Starts timing a scope.
+   * @param name Event name; must be a string literal or otherwise outlive the trace
+   * @param detail Optional text shown in the event's args (e.g. a profile name)
+   */
+  explicit TraceScope(const char *name, const QString &detail = QString());
+
+  /** @brief Records the event if tracing was enabled when the scope began. */
+  ~TraceScope();
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name_;      ///< Event name (not owned)
+  QString detail_;        ///< Optional args.detail text
+  qint64 startUs_ = -1;   ///< Start timestamp in microseconds, or -1 when not tracing
+};
+
+#define PHRAIMS_TRACE_CONCAT_INNER(a, b) a##b
+#define PHRAIMS_TRACE_CONCAT(a, b) PHRAIMS_TRACE_CONCAT_INNER(a, b)
+
+/// Traces the enclosing scope under @p name.
+#define PHRAIMS_TRACE_SCOPE(name) TraceScope PHRAIMS_TRACE_CONCAT(phraimsTraceScope_, __LINE__)(name)
+
+/// Traces the enclosing scope under @p name with extra @p detail text in the event args.
+#define PHRAIMS_TRACE_SCOPE_DETAIL(name, detail) \
+  TraceScope PHRAIMS_TRACE_CONCAT(phraimsTraceScope_, __LINE__)(name, detail)
@@ -1,5 +1,7 @@
 #include "UpdateChecker.h"
+#include "AppSettings.h"
 #include "version.h"
+#include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -23,6 +25,13 @@ void UpdateChecker::checkForUpdates() {
   QNetworkRequest request(apiUrl);
   request.setHeader(QNetworkRequest::UserAgentHeader, 
                    QString("Phraims/%1").arg(PHRAIMS_VERSION));
+  // Only revalidate when there is a cached body to fall back on
+  AppSettings s;
+  const QByteArray etag = s->value("updates/etag").toByteArray();
+  if (!etag.isEmpty() && s->contains("updates/cachedRelease")) {
+    request.setRawHeader("If-None-Match", etag);
+  }
+  retryAfterSeconds_ = 0;
   
   QNetworkReply *reply = networkManager_->get(request);
   connect(reply, &QNetworkReply::finished, this, &UpdateChecker::onNetworkReplyFinished);
@@ -37,11 +46,20 @@ void UpdateChecker::onNetworkReplyFinished() {
   reply->deleteLater();
   
   if (reply->error() != QNetworkReply::NoError) {
+    retryAfterSeconds_ = retryAfterFrom(reply);
     emit updateCheckFailed(tr("Failed to check for updates: %1").arg(reply->errorString()));
     return;
   }
   
-  const QByteArray data = reply->readAll();
+  QByteArray data;
+  const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  if (status == 304) {
+    data = AppSettings()->value("updates/cachedRelease").toByteArray();
+    qDebug() << "UpdateChecker: release unchanged (304), using cached response";
+  } else {
+    data = reply->readAll();
+    cacheRelease(data, reply->rawHeader("ETag"));
+  }
   const UpdateInfo info = parseGitHubResponse(data);
   
   if (info.latestVersion.isEmpty()) {
@@ -130,6 +148,44 @@ QString UpdateChecker::getDownloadUrlForPlatform(const QJsonArray &assets) {
   return QString(); // Return empty if no matching asset found
 }
 
+void UpdateChecker::cacheRelease(const QByteArray &jsonData, const QByteArray &etag) {
+  const QJsonObject root = QJsonDocument::fromJson(jsonData).object();
+  if (root.value("tag_name").toString().isEmpty()) return;
+  // Keep only what parseGitHubResponse() reads; the full response also lists
+  // uploader and per-asset metadata that would bloat settings.ini.
+  QJsonArray assets;
+  for (const QJsonValue &assetValue : root.value("assets").toArray()) {
+    const QJsonObject asset = assetValue.toObject();
+    assets.append(QJsonObject{{"name", asset.value("name")},
+                              {"browser_download_url", asset.value("browser_download_url")}});
+  }
+  const QJsonObject trimmed{{"tag_name", root.value("tag_name")},
+                            {"html_url", root.value("html_url")},
+                            {"body", root.value("body")},
+                            {"assets", assets}};
+  AppSettings s;
+  s->setValue("updates/cachedRelease", QJsonDocument(trimmed).toJson(QJsonDocument::Compact));
+  if (etag.isEmpty()) {
+    s->remove("updates/etag");
+  } else {
+    s->setValue("updates/etag", etag);
+  }
+}
+
+int UpdateChecker::retryAfterFrom(const QNetworkReply *reply) {
+  // Retry-After: delay in seconds (secondary rate limits, 429/503)
+  bool ok = false;
+  const int retryAfter = reply->rawHeader("Retry-After").toInt(&ok);
+  if (ok && retryAfter > 0) return retryAfter;
+  // Primary rate limit: 403/429 with no remaining requests until the reset time
+  if (reply->rawHeader("X-RateLimit-Remaining") == "0") {
+    const qint64 reset = reply->rawHeader("X-RateLimit-Reset").toLongLong(&ok);
+    const qint64 wait = reset - QDateTime::currentSecsSinceEpoch();
+    if (ok && wait > 0) return int(qMin<qint64>(wait, 24 * 60 * 60));
+  }
+  return 0;
+}
+
 int UpdateChecker::compareVersions(const QString &version1, const QString &version2) {
   // Strip any leading 'v' or 'V' prefix
   QString v1 = version1;
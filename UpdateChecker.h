@@ -13,6 +13,11 @@
  * - macOS: Delegates to Sparkle framework (if available)
  * - Windows: Downloads and verifies installer, then stages update
  * - Linux: Shows notification with download link (manual update)
+ *
+ * Requests are conditional: the last release's ETag and the fields Phraims
+ * uses from it are cached in AppSettings (`updates/etag`,
+ * `updates/cachedRelease`), and a `304 Not Modified` answer is served from
+ * that cache. GitHub does not count 304s against the API rate limit.
  */
 class UpdateChecker : public QObject {
   Q_OBJECT
@@ -44,6 +49,13 @@ public:
    */
   void checkForUpdates();
 
+  /**
+   * @brief Returns how long the server asked us to wait before the next request.
+   * @return Seconds from `Retry-After` or the rate limit reset time of the last
+   *         failed check, or 0 when it did not say
+   */
+  int retryAfterSeconds() const { return retryAfterSeconds_; }
+
   /**
    * @brief Compares two version strings.
    * @param version1 First version (e.g., "0.55")
@@ -88,5 +100,20 @@ private:
    */
   QString getDownloadUrlForPlatform(const QJsonArray &assets);
 
+  /**
+   * @brief Caches the parts of a release response that parseGitHubResponse() reads.
+   * @param jsonData The raw JSON response from GitHub
+   * @param etag The response's ETag header (may be empty)
+   */
+  static void cacheRelease(const QByteArray &jsonData, const QByteArray &etag);
+
+  /**
+   * @brief Reads the server's back-off hint from a failed reply.
+   * @param reply The finished reply
+   * @return Seconds to wait, or 0 when the reply has no hint
+   */
+  static int retryAfterFrom(const QNetworkReply *reply);
+
   QNetworkAccessManager *networkManager_ = nullptr; ///< Network manager for HTTP requests
+  int retryAfterSeconds_ = 0;                       ///< Back-off hint of the last failed check
 };
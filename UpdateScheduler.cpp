@@ -0,0 +1,108 @@
+#include "UpdateScheduler.h"
+#include "AppSettings.h"
+#include "RestoreScheduler.h"
+#include "SplitWindow.h"
+#include "UpdateDialog.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+  constexpr int STARTUP_GRACE_MS = 30 * 1000;          // no check in the first 30 s of a session
+  constexpr int IDLE_POLL_MS = 2000;                   // restore progress poll while waiting
+  constexpr int MAX_IDLE_WAIT_MS = 2 * 60 * 1000;      // check anyway after waiting this long
+  constexpr int MAX_INTERVAL_HOURS = 30 * 24;
+  constexpr qint64 BASE_BACKOFF_SECS = 15 * 60;        // first retry after a failure
+  constexpr qint64 MAX_BACKOFF_SECS = 24 * 60 * 60;
+  constexpr int MAX_TIMER_MS = 24 * 60 * 60 * 1000;    // re-armed when the due time is further out
+}
+
+UpdateScheduler &UpdateScheduler::instance() {
+  static UpdateScheduler *inst = new UpdateScheduler(qApp);
+  return *inst;
+}
+
+UpdateScheduler::UpdateScheduler(QObject *parent) : QObject(parent) {
+  AppSettings s;
+  enabled_ = s->value("updates/autoCheck", true).toBool();
+  intervalHours_ = std::clamp(s->value("updates/checkIntervalHours", 24).toInt(), 1, MAX_INTERVAL_HOURS);
+  timer_.setSingleShot(true);
+  connect(&timer_, &QTimer::timeout, this, [this]() {
+    const qint64 due = AppSettings()->value("updates/nextCheck", 0).toLongLong();
+    if (QDateTime::currentSecsSinceEpoch() < due) {
+      scheduleAt(due); // long waits are split into MAX_TIMER_MS steps
+      return;
+    }
+    idleWait_.start();
+    waitForIdle();
+  });
+}
+
+void UpdateScheduler::start() {
+  if (!enabled_ || started_) return;
+  started_ = true;
+  sinceStart_.start();
+  const qint64 due = AppSettings()->value("updates/nextCheck", 0).toLongLong();
+  qDebug() << "UpdateScheduler: next check"
+           << (due > 0 ? QDateTime::fromSecsSinceEpoch(due).toString(Qt::ISODate) : QStringLiteral("now"))
+           << "interval=" << intervalHours_ << "h";
+  scheduleAt(due);
+}
+
+void UpdateScheduler::scheduleAt(qint64 epochSecs) {
+  const qint64 waitMs = (epochSecs - QDateTime::currentSecsSinceEpoch()) * 1000;
+  const qint64 graceMs = STARTUP_GRACE_MS - sinceStart_.elapsed();
+  timer_.start(int(std::clamp<qint64>(std::max(waitMs, graceMs), 0, MAX_TIMER_MS)));
+}
+
+void UpdateScheduler::waitForIdle() {
+  if (RestoreScheduler::instance().isLoading() && idleWait_.elapsed() < MAX_IDLE_WAIT_MS) {
+    QTimer::singleShot(IDLE_POLL_MS, this, &UpdateScheduler::waitForIdle);
+    return;
+  }
+  check();
+}
+
+void UpdateScheduler::check() {
+  if (!checker_) {
+    checker_ = new UpdateChecker(this);
+    connect(checker_, &UpdateChecker::updateCheckCompleted, this, &UpdateScheduler::onCheckCompleted);
+    connect(checker_, &UpdateChecker::updateCheckFailed, this, &UpdateScheduler::onCheckFailed);
+  }
+  qDebug() << "UpdateScheduler: checking for updates";
+  checker_->checkForUpdates();
+}
+
+void UpdateScheduler::onCheckCompleted(const UpdateChecker::UpdateInfo &info) {
+  AppSettings s;
+  const qint64 next = QDateTime::currentSecsSinceEpoch() + qint64(intervalHours_) * 60 * 60;
+  s->setValue("updates/nextCheck", next);
+  s->remove("updates/failureCount");
+  qDebug() << "UpdateScheduler: latest" << info.latestVersion << "current" << info.currentVersion
+           << "updateAvailable=" << info.updateAvailable;
+  scheduleAt(next);
+
+  if (!info.updateAvailable || s->value("updates/notifiedVersion").toString() == info.latestVersion) return;
+  // Never pop up over a modal dialog the user is working in; offer it next time.
+  if (QApplication::activeModalWidget() || g_windows.empty()) return;
+  s->setValue("updates/notifiedVersion", info.latestVersion);
+  QWidget *parent = qobject_cast<SplitWindow *>(QApplication::activeWindow());
+  if (!parent) parent = g_windows.front();
+  auto *dialog = new UpdateDialog(info, parent);
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->show();
+}
+
+void UpdateScheduler::onCheckFailed(const QString &errorMessage) {
+  AppSettings s;
+  const int failures = s->value("updates/failureCount", 0).toInt() + 1;
+  const qint64 backoff = std::min(BASE_BACKOFF_SECS << std::min(failures - 1, 16), MAX_BACKOFF_SECS);
+  const qint64 wait = std::max<qint64>(backoff, checker_ ? checker_->retryAfterSeconds() : 0);
+  const qint64 next = QDateTime::currentSecsSinceEpoch() + wait;
+  s->setValue("updates/failureCount", failures);
+  s->setValue("updates/nextCheck", next);
+  qWarning() << "UpdateScheduler:" << errorMessage << "- failure" << failures << "retrying in" << wait << "s";
+  scheduleAt(next);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include "UpdateChecker.h"
+
+/**
+ * @brief Runs automatic update checks in the background, off the startup path.
+ *
+ * main.cpp calls start() once the session has been restored. Nothing
+ * network related is created until the first check is due; then the
+ * scheduler waits out a startup grace period and until RestoreScheduler has
+ * finished loading restored pages (or a cap expires), so a cold start on a
+ * slow network never waits for update plumbing. The platform updaters
+ * (Sparkle, WinSparkle) stay untouched until the user acts on an update in
+ * UpdateDialog.
+ *
+ * Checks use UpdateChecker's conditional requests. The next due time is
+ * stored in `updates/nextCheck`: `updates/checkIntervalHours` after a
+ * success, or an exponential back-off after a failure (at least as long as
+ * the server's `Retry-After` or rate limit reset). A newer release opens
+ * UpdateDialog once per version.
+ */
+class UpdateScheduler : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Returns the shared scheduler, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static UpdateScheduler &instance();
+
+  /** @brief Returns whether automatic checks are on (`updates/autoCheck`, read at startup). */
+  bool isEnabled() const { return enabled_; }
+
+  /**
+   * @brief Arms the timer for the next due check.
+   *
+   * A no-op when automatic checks are disabled. The first check of a session
+   * never starts before the startup grace period.
+   */
+  void start();
+
+private:
+  explicit UpdateScheduler(QObject *parent = nullptr);
+
+  /** @brief Arms timer_ for an absolute time (seconds since the epoch). */
+  void scheduleAt(qint64 epochSecs);
+
+  /** @brief Starts the check once restored pages have loaded, polling until then. */
+  void waitForIdle();
+
+  /** @brief Runs one check, creating the UpdateChecker on first use. */
+  void check();
+
+  /** @brief Records a successful check and offers a newer release once. */
+  void onCheckCompleted(const UpdateChecker::UpdateInfo &info);
+
+  /** @brief Records a failed check and backs off. */
+  void onCheckFailed(const QString &errorMessage);
+
+  bool enabled_ = true;                ///< updates/autoCheck
+  int intervalHours_ = 24;             ///< updates/checkIntervalHours
+  bool started_ = false;               ///< start() has run
+  QTimer timer_;                       ///< Fires when the next check is due
+  QElapsedTimer sinceStart_;           ///< Time since start(), for the grace period
+  QElapsedTimer idleWait_;             ///< Time spent waiting for restore to finish
+  UpdateChecker *checker_ = nullptr;   ///< Created by the first check
+};
@@ -1,6 +1,13 @@
 #include "AppSettings.h"
+#include "ContentBlocker.h"
+#include "DomPatch.h"
+#include "FrameMetrics.h"
+#include "FramePool.h"
+#include "LocalScheme.h"
 #include "SplitWindow.h"
+#include "Trace.h"
 #include "Utils.h"
+#include "WindowListModel.h"
 #include <algorithm>
 #include <QApplication>
 #include <QDateTime>
@@ -38,6 +45,7 @@ GroupScope::~GroupScope() {
 }
 
 void createWindowMenuIcons() {
+  PHRAIMS_TRACE_SCOPE("createWindowMenuIcons");
   QPixmap emptyPix(16, 16);
   emptyPix.fill(Qt::transparent);
   g_windowEmptyIcon = QIcon(emptyPix);
@@ -117,17 +125,13 @@ void createWindowMenuIcons() {
 }
 
 void rebuildAllWindowMenus() {
-  for (SplitWindow *w : g_windows) {
-    if (w) {
-      // Ensure window titles reflect current ordering and counts before
-      // rebuilding each window's Window menu.
-      w->updateWindowTitle();
-      w->refreshWindowMenu();
-    }
-  }
+  // The model refreshes every window title (they reflect ordering and frame
+  // counts) and notifies each Window menu of only the rows that changed.
+  WindowListModel::instance().refresh();
 }
 
-void createAndShowWindow(const QString &initialAddress, const QString &windowId, bool isIncognito) {
+SplitWindow *createAndShowWindow(const QString &initialAddress, const QString &windowId, bool isIncognito) {
+  PHRAIMS_TRACE_SCOPE_DETAIL("createAndShowWindow", windowId);
   QString id = windowId;
   // Generate a new ID for windows without one, or for Incognito windows.
   // Incognito windows always get a fresh ID and will not restore from AppSettings
@@ -136,11 +140,18 @@ void createAndShowWindow(const QString &initialAddress, const QString &windowId,
   // Construct the window with an id. The SplitWindow constructor will
   // attempt to restore saved per-window addresses/layout if the id exists
   // and the window is not Incognito.
-  SplitWindow *w = new SplitWindow(id, isIncognito);
+  SplitWindow *w = nullptr;
+  {
+    PHRAIMS_TRACE_SCOPE("SplitWindow constructor");
+    w = new SplitWindow(id, isIncognito);
+  }
   qDebug() << "createAndShowWindow: created window id=" << id 
            << " initialAddress=" << (initialAddress.isEmpty() ? QString("(none)") : initialAddress)
            << " isIncognito=" << isIncognito;
-  w->show();
+  {
+    PHRAIMS_TRACE_SCOPE("SplitWindow show");
+    w->show();
+  }
   if (!windowId.isEmpty() && !isIncognito) {
     // This is a restored window: the constructor already loaded addresses
     // and rebuilt sections. Do not reset or override addresses here.
@@ -165,6 +176,7 @@ void createAndShowWindow(const QString &initialAddress, const QString &windowId,
 
   // Ensure all Window menus show the latest list
   rebuildAllWindowMenus();
+  return w;
 }
 
 void createAndShowIncognitoWindow(const QString &initialAddress) {
@@ -172,17 +184,22 @@ void createAndShowIncognitoWindow(const QString &initialAddress) {
 }
 
 void performLegacyMigration() {
+  PHRAIMS_TRACE_SCOPE("performLegacyMigration");
   // No-op placeholder reserved for future settings schema migrations.
 }
 
 // Map of profile name -> profile instance for caching
 static QMap<QString, QWebEngineProfile*> g_profileCache;
 
+// QWebEngineProfile::setHttpCacheMaximumSize() takes an int byte count
+static constexpr int MAX_HTTP_CACHE_MB = 2047;
+
 QWebEngineProfile *getProfileByName(const QString &profileName) {
   // Check cache first
   if (g_profileCache.contains(profileName)) {
     return g_profileCache.value(profileName);
   }
+  PHRAIMS_TRACE_SCOPE_DETAIL("getProfileByName", profileName);
 
   const QString dataRoot = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
   const QString profileDir = dataRoot + QStringLiteral("/profiles/") + profileName;
@@ -190,22 +207,69 @@ QWebEngineProfile *getProfileByName(const QString &profileName) {
   QDir().mkpath(profileDir);
   QDir().mkpath(cacheDir);
 
+  const ProfileCachePolicy cache = profileCachePolicy(profileName);
   QWebEngineProfileBuilder builder;
   builder.setPersistentStoragePath(profileDir);
   builder.setCachePath(cacheDir);
-  builder.setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+  builder.setHttpCacheType(cache.memoryOnly ? QWebEngineProfile::MemoryHttpCache : QWebEngineProfile::DiskHttpCache);
+  builder.setHttpCacheMaximumSize(cache.maxSizeMB * 1024 * 1024);
   builder.setPersistentCookiesPolicy(QWebEngineProfile::ForcePersistentCookies);
   builder.setPersistentPermissionsPolicy(QWebEngineProfile::PersistentPermissionsPolicy::StoreOnDisk);
 
-  QWebEngineProfile *profile = builder.createProfile(QStringLiteral("phraims-") + profileName, qApp);
+  QWebEngineProfile *profile = nullptr;
+  {
+    // the first profile also starts the QtWebEngine context
+    PHRAIMS_TRACE_SCOPE("QWebEngineProfileBuilder::createProfile");
+    profile = builder.createProfile(QStringLiteral("phraims-") + profileName, qApp);
+  }
   qDebug() << "getProfileByName: created profile" << profileName << "storage=" << profile->persistentStoragePath()
-           << "cache=" << profile->cachePath() << "offTheRecord=" << profile->isOffTheRecord();
+           << "cache=" << profile->cachePath() << "offTheRecord=" << profile->isOffTheRecord()
+           << "httpCacheMemoryOnly=" << cache.memoryOnly << "httpCacheMaxMB=" << cache.maxSizeMB;
+  installDomPatchScript(profile);
+  ContentBlocker::instance().attach(profile);
+  FrameMetricsSampler::installPageScript(profile);
+  LocalSchemeHandler::instance().attach(profile);
 
   // Cache the profile
   g_profileCache.insert(profileName, profile);
   return profile;
 }
 
+ProfileCachePolicy profileCachePolicy(const QString &profileName) {
+  AppSettings s;
+  GroupScope g(s, QStringLiteral("profiles/") + profileName);
+  ProfileCachePolicy policy;
+  policy.memoryOnly = s->value("httpCacheMemoryOnly", false).toBool();
+  policy.maxSizeMB = std::clamp(s->value("httpCacheMaxMB", 0).toInt(), 0, MAX_HTTP_CACHE_MB);
+  policy.warmOnRestore = s->value("warmCacheOnRestore", false).toBool();
+  return policy;
+}
+
+void setProfileCachePolicy(const QString &profileName, const ProfileCachePolicy &policy) {
+  {
+    AppSettings s;
+    GroupScope g(s, QStringLiteral("profiles/") + profileName);
+    s->setValue("httpCacheMemoryOnly", policy.memoryOnly);
+    s->setValue("httpCacheMaxMB", std::clamp(policy.maxSizeMB, 0, MAX_HTTP_CACHE_MB));
+    s->setValue("warmCacheOnRestore", policy.warmOnRestore);
+  }
+  QWebEngineProfile *profile = g_profileCache.value(profileName);
+  if (!profile) return;
+  const auto type = policy.memoryOnly ? QWebEngineProfile::MemoryHttpCache : QWebEngineProfile::DiskHttpCache;
+  if (profile->httpCacheType() != type) profile->setHttpCacheType(type);
+  const int maxBytes = std::clamp(policy.maxSizeMB, 0, MAX_HTTP_CACHE_MB) * 1024 * 1024;
+  if (profile->httpCacheMaximumSize() != maxBytes) profile->setHttpCacheMaximumSize(maxBytes);
+  qDebug() << "setProfileCachePolicy:" << profileName << "memoryOnly=" << policy.memoryOnly
+           << "maxMB=" << policy.maxSizeMB << "warmOnRestore=" << policy.warmOnRestore;
+}
+
+QString profileNameFor(QWebEngineProfile *profile) {
+  for (auto it = g_profileCache.constBegin(); it != g_profileCache.constEnd(); ++it) {
+    if (it.value() == profile) return it.key();
+  }
+  return QString();
+}
+
 QString currentProfileName() {
   AppSettings s;
   return s->value("currentProfile", QStringLiteral("Default")).toString();
@@ -249,6 +313,7 @@ bool isValidProfileName(const QString &name) {
 }
 
 bool createProfile(const QString &profileName) {
+  PHRAIMS_TRACE_SCOPE_DETAIL("createProfile", profileName);
   if (!isValidProfileName(profileName)) return false;
   
   const QString dataRoot = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -297,6 +362,13 @@ bool renameProfile(const QString &oldName, const QString &newName) {
     QWebEngineProfile *profile = g_profileCache.take(oldName);
     g_profileCache.insert(newName, profile);
   }
+
+  // Per-profile settings follow the profile
+  setProfileCachePolicy(newName, profileCachePolicy(oldName));
+  {
+    AppSettings s;
+    s->remove(QStringLiteral("profiles/") + oldName);
+  }
   
   // Update current profile name if it was renamed
   if (currentProfileName() == oldName) {
@@ -334,6 +406,8 @@ bool deleteProfile(const QString &profileName) {
     // Design trade-off: During long sessions with frequent profile deletions,
     // this could accumulate QWebEngineProfile objects in memory. This is
     // acceptable for typical usage patterns where profiles are rarely deleted.
+    // Spare pooled frames are dropped though, so they don't keep using its storage.
+    FramePool::instance().releaseProfile(g_profileCache.value(profileName));
     g_profileCache.remove(profileName);
   }
   
@@ -359,6 +433,10 @@ bool deleteProfile(const QString &profileName) {
     return false;
   }
   
+  {
+    AppSettings s;
+    s->remove(QStringLiteral("profiles/") + profileName);
+  }
   qDebug() << "deleteProfile: deleted profile:" << profileName;
   return true;
 }
@@ -369,11 +447,21 @@ QWebEngineProfile *sharedWebEngineProfile() {
 }
 
 QWebEngineProfile *createIncognitoProfile() {
-  QWebEngineProfileBuilder builder;
-  // Off-the-record profile: no persistent storage, all data is ephemeral
-  QWebEngineProfile *profile = builder.createOffTheRecordProfile(qApp);
+  PHRAIMS_TRACE_SCOPE("createIncognitoProfile");
+  // Off-the-record profile: no persistent storage, all data is ephemeral.
+  // createOffTheRecordProfile() is static and ignores builder settings, so the
+  // cache size is applied to the returned profile.
+  QWebEngineProfile *profile = QWebEngineProfileBuilder::createOffTheRecordProfile(qApp);
+  // Off-the-record profiles always cache in memory; only the size is tunable
+  {
+    AppSettings s;
+    profile->setHttpCacheMaximumSize(std::clamp(s->value("incognito/httpCacheMaxMB", 0).toInt(), 0, MAX_HTTP_CACHE_MB) * 1024 * 1024);
+  }
   qDebug() << "createIncognitoProfile: created off-the-record profile"
            << "offTheRecord=" << profile->isOffTheRecord();
-  
+  installDomPatchScript(profile);
+  ContentBlocker::instance().attach(profile);
+  FrameMetricsSampler::installPageScript(profile);
+  LocalSchemeHandler::instance().attach(profile);
   return profile;
 }
@@ -71,10 +71,11 @@ extern QIcon g_windowCheckDiamondIcon;
 void createWindowMenuIcons();
 
 /**
- * @brief Rebuilds the Window menu for all open windows.
+ * @brief Brings the Window menu of every open window up to date.
  *
- * Updates window titles and refreshes the Window menu in all SplitWindow instances
- * to reflect current window states (active, minimized, ordering).
+ * Updates window titles and resyncs the shared WindowListModel with g_windows.
+ * Each SplitWindow's menu then updates only the entries whose title, active or
+ * minimized state changed. Cheap when nothing changed.
  */
 void rebuildAllWindowMenus();
 
@@ -83,12 +84,13 @@ void rebuildAllWindowMenus();
  * @param initialAddress Optional URL to load in the first frame
  * @param windowId Optional UUID for restoring saved window state
  * @param isIncognito If true, creates an Incognito (private) window
+ * @return The new window (already shown and tracked in g_windows)
  *
  * The window is shown immediately and ownership is managed by g_windows.
  * If windowId is provided, the window restores its saved state from AppSettings.
  * Incognito windows use ephemeral storage and do not persist state.
  */
-void createAndShowWindow(const QString &initialAddress = QString(), const QString &windowId = QString(), bool isIncognito = false);
+SplitWindow *createAndShowWindow(const QString &initialAddress = QString(), const QString &windowId = QString(), bool isIncognito = false);
 
 /**
  * @brief Creates a new Incognito (private) window.
@@ -185,6 +187,39 @@ bool renameProfile(const QString &oldName, const QString &newName);
  */
 bool deleteProfile(const QString &profileName);
 
+/**
+ * @brief HTTP cache settings of one profile (`profiles/<name>/...`).
+ */
+struct ProfileCachePolicy {
+  bool memoryOnly = false;     ///< httpCacheMemoryOnly: MemoryHttpCache instead of DiskHttpCache
+  int maxSizeMB = 0;           ///< httpCacheMaxMB: cache size cap; 0 = sized by QtWebEngine
+  bool warmOnRestore = false;  ///< warmCacheOnRestore: RestoreScheduler preloads hidden restored frames
+};
+
+/**
+ * @brief Reads a profile's cache policy from AppSettings.
+ * @param profileName Profile name
+ * @return The stored policy, or defaults
+ */
+ProfileCachePolicy profileCachePolicy(const QString &profileName);
+
+/**
+ * @brief Stores a profile's cache policy and applies it to the loaded profile, if any.
+ * @param profileName Profile name
+ * @param policy New policy
+ *
+ * Switching between disk and memory cache takes effect immediately; the
+ * previous cache's contents are not carried over.
+ */
+void setProfileCachePolicy(const QString &profileName, const ProfileCachePolicy &policy);
+
+/**
+ * @brief Returns the name a loaded profile is cached under.
+ * @param profile Profile returned by getProfileByName()
+ * @return The profile name, or empty for Incognito and unknown profiles
+ */
+QString profileNameFor(QWebEngineProfile *profile);
+
 /**
  * @brief Validates a profile name for creation or renaming.
  * @param name The profile name to validate
@@ -195,10 +230,11 @@ bool deleteProfile(const QString &profileName);
 bool isValidProfileName(const QString &name);
 
 /**
- * @brief Applies all enabled DOM patches to the given page immediately.
+ * @brief Brings the page's current document up to date with the DOM patches.
  * @param page The QWebEnginePage to apply patches to
  *
- * Loads patches from persistent storage and injects CSS rules via JavaScript.
- * Should be called after each page load and on URL changes for single-page apps.
+ * Patches are normally applied by the compiled document-creation script
+ * (see installDomPatchScript() in DomPatch.h); this re-syncs the current
+ * document. Call on URL changes (single-page apps) and after editing patches.
  */
 void applyDomPatchesToPage(QWebEnginePage *page);
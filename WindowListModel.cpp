@@ -0,0 +1,131 @@
+#include "WindowListModel.h"
+#include "SplitWindow.h"
+#include "Utils.h"
+#include <QApplication>
+#include <QDebug>
+#include <algorithm>
+
+WindowListModel &WindowListModel::instance() {
+  static WindowListModel *inst = new WindowListModel(qApp);
+  return *inst;
+}
+
+WindowListModel::WindowListModel(QObject *parent) : QAbstractListModel(parent) {}
+
+int WindowListModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return (int)entries_.size();
+}
+
+QVariant WindowListModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() < 0 || index.row() >= (int)entries_.size()) return QVariant();
+  const Entry &e = entries_[index.row()];
+  switch (role) {
+    case Qt::DisplayRole:
+      return e.title;
+    case Qt::DecorationRole:
+      if (e.active && e.minimized) return g_windowCheckDiamondIcon;
+      if (e.active) return g_windowCheckIcon;
+      if (e.minimized) return g_windowDiamondIcon;
+      return g_windowEmptyIcon;
+    case ActiveRole:
+      return e.active;
+    case MinimizedRole:
+      return e.minimized;
+    case WindowRole:
+      return QVariant::fromValue<QObject *>(e.window.data());
+    default:
+      return QVariant();
+  }
+}
+
+SplitWindow *WindowListModel::windowAt(int row) const {
+  if (row < 0 || row >= (int)entries_.size()) return nullptr;
+  return entries_[row].window;
+}
+
+WindowListModel::Entry WindowListModel::snapshot(SplitWindow *window, int row) {
+  Entry e;
+  e.window = window;
+  e.title = window->windowTitle();
+  if (e.title.isEmpty()) e.title = QStringLiteral("Window %1").arg(row + 1);
+  e.minimized = (window->windowState() & Qt::WindowMinimized) || window->isMinimized();
+  e.active = window->isActiveWindow();
+  return e;
+}
+
+void WindowListModel::refresh() {
+  std::vector<SplitWindow *> current;
+  current.reserve(g_windows.size());
+  for (SplitWindow *w : g_windows) {
+    if (!w) continue;
+    // Titles encode the window's position and frame count; keep them current
+    // before they are compared below.
+    w->updateWindowTitle();
+    current.push_back(w);
+  }
+
+  // Rows whose window is gone (destroyed or untracked) are removed first.
+  for (int row = (int)entries_.size() - 1; row >= 0; --row) {
+    SplitWindow *w = entries_[row].window;
+    if (w && std::find(current.begin(), current.end(), w) != current.end()) continue;
+    beginRemoveRows(QModelIndex(), row, row);
+    entries_.erase(entries_.begin() + row);
+    endRemoveRows();
+  }
+
+  // g_windows only appends, so the remaining rows must be a prefix of it.
+  // Anything else (should not happen) falls back to a reset.
+  bool prefix = entries_.size() <= current.size();
+  for (size_t i = 0; prefix && i < entries_.size(); ++i) {
+    prefix = entries_[i].window == current[i];
+  }
+  if (!prefix) {
+    qDebug() << "WindowListModel::refresh: window order changed, resetting model";
+    beginResetModel();
+    entries_.clear();
+    for (size_t i = 0; i < current.size(); ++i) entries_.push_back(snapshot(current[i], (int)i));
+    endResetModel();
+    lastActiveWindow_ = QApplication::activeWindow();
+    return;
+  }
+
+  for (int row = 0; row < (int)entries_.size(); ++row) updateRow(row, true);
+
+  const int first = (int)entries_.size();
+  if ((int)current.size() > first) {
+    beginInsertRows(QModelIndex(), first, (int)current.size() - 1);
+    for (int i = first; i < (int)current.size(); ++i) entries_.push_back(snapshot(current[i], i));
+    endInsertRows();
+  }
+  lastActiveWindow_ = QApplication::activeWindow();
+}
+
+void WindowListModel::refreshStates() {
+  lastActiveWindow_ = QApplication::activeWindow();
+  for (int row = 0; row < (int)entries_.size(); ++row) updateRow(row, false);
+}
+
+void WindowListModel::activeWindowMaybeChanged() {
+  if (QApplication::activeWindow() == lastActiveWindow_) return;
+  refreshStates();
+}
+
+void WindowListModel::updateRow(int row, bool includeTitle) {
+  Entry &e = entries_[row];
+  if (!e.window) return; // pruned by the next refresh()
+  const Entry fresh = snapshot(e.window, row);
+  QList<int> roles;
+  if (includeTitle && fresh.title != e.title) {
+    e.title = fresh.title;
+    roles << Qt::DisplayRole;
+  }
+  if (fresh.active != e.active || fresh.minimized != e.minimized) {
+    e.active = fresh.active;
+    e.minimized = fresh.minimized;
+    roles << ActiveRole << MinimizedRole << Qt::DecorationRole;
+  }
+  if (roles.isEmpty()) return;
+  const QModelIndex idx = index(row);
+  emit dataChanged(idx, idx, roles);
+}
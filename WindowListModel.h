@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QString>
+#include <vector>
+
+class QWidget;
+class SplitWindow;
+
+/**
+ * @brief Shared list of open windows backing every Window menu.
+ *
+ * One row per entry in g_windows, in the same order. Each row snapshots the
+ * window's title and its active/minimized state. refresh() and
+ * refreshStates() compare the live windows against those snapshots and only
+ * emit rowsInserted/rowsRemoved/dataChanged for rows that actually changed,
+ * so each SplitWindow can patch the few affected QActions instead of
+ * rebuilding its whole menu.
+ *
+ * Roles: Qt::DisplayRole (menu title), Qt::DecorationRole (active/minimized
+ * icon from createWindowMenuIcons()), plus ActiveRole, MinimizedRole and
+ * WindowRole.
+ */
+class WindowListModel : public QAbstractListModel {
+  Q_OBJECT
+
+public:
+  /** @brief Extra data roles exposed by the model. */
+  enum Roles {
+    ActiveRole = Qt::UserRole + 1, ///< bool: window is the active window
+    MinimizedRole,                 ///< bool: window is minimized
+    WindowRole                     ///< SplitWindow*: the window itself (as QObject*)
+  };
+
+  /**
+   * @brief Returns the shared model, creating it on first use.
+   * @return Reference to the application-wide instance (parented to qApp)
+   */
+  static WindowListModel &instance();
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  /**
+   * @brief Returns the window shown in a row.
+   * @param row Row index
+   * @return The window, or nullptr if the row is out of range or the window is gone
+   */
+  SplitWindow *windowAt(int row) const;
+
+  /**
+   * @brief Resyncs rows with g_windows, refreshing every window's title first.
+   *
+   * Use after windows are added, removed or closed, or when a window's frame
+   * count or profile changes.
+   */
+  void refresh();
+
+  /**
+   * @brief Resyncs only the active/minimized flags of existing rows.
+   *
+   * Cheap enough for window-state changes; titles and row structure are left alone.
+   */
+  void refreshStates();
+
+  /**
+   * @brief Calls refreshStates() only if the application's active window changed.
+   *
+   * Connected to QApplication::focusChanged so moving focus between frames
+   * of the same window is just a pointer comparison.
+   */
+  void activeWindowMaybeChanged();
+
+private:
+  /** @brief Snapshot of one window's menu-relevant state. */
+  struct Entry {
+    QPointer<SplitWindow> window; ///< Window this row represents
+    QString title;                ///< Title shown in the menu
+    bool active = false;          ///< Was the active window at the last refresh
+    bool minimized = false;       ///< Was minimized at the last refresh
+  };
+
+  explicit WindowListModel(QObject *parent = nullptr);
+
+  /** @brief Builds a fresh snapshot for a window shown at @p row. */
+  static Entry snapshot(SplitWindow *window, int row);
+
+  /** @brief Updates a row from a fresh snapshot, emitting dataChanged if it differs. */
+  void updateRow(int row, bool includeTitle);
+
+  std::vector<Entry> entries_;        ///< One snapshot per row, in g_windows order
+  QPointer<QWidget> lastActiveWindow_; ///< QApplication::activeWindow() at the last state refresh
+};
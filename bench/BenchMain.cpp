@@ -0,0 +1,542 @@
+/**
+ * phraims-bench: headless frame/window scaling benchmark.
+ *
+ * Opens N windows x M frames against a local HTTP fixture server and times
+ * the SplitWindow frame operations (rebuildSections, addSingleFrame,
+ * removeSingleFrame, setLayoutMode) plus a full session restore. Peak RSS
+ * (browser + renderer processes) and per-frame load/first-paint times are
+ * recorded, and everything is written as JSON so results can be compared
+ * across Qt/WebEngine releases.
+ *
+ * Runs on the offscreen platform unless --visible is given. Uses its own
+ * application name so the user's Phraims settings and profiles are untouched.
+ */
+#include "AppSettings.h"
+#include "FrameMetrics.h"
+#include "RestoreScheduler.h"
+#include "SessionStore.h"
+#include "SplitFrameWidget.h"
+#include "SplitWindow.h"
+#include "Utils.h"
+#include "version.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QPointer>
+#include <QSet>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QWebEnginePage>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace {
+  constexpr int DEFAULT_WINDOWS = 3;
+  constexpr int DEFAULT_FRAMES = 4;
+  constexpr int DEFAULT_ITERATIONS = 5;
+  constexpr int LOAD_TIMEOUT_MS = 60000;  // give up waiting for pages after this long
+  constexpr int RSS_SAMPLE_MS = 250;      // peak RSS sampling period while waiting
+  constexpr int FIXTURE_PARAGRAPHS = 200; // body size of each fixture page
+
+  // Reads first-paint / first-contentful-paint from the Paint Timing API.
+  constexpr const char *kPaintTimingScript = R"JS(
+(function(){
+  var out = { firstPaint: -1, firstContentfulPaint: -1 };
+  try {
+    performance.getEntriesByType('paint').forEach(function(e) {
+      if (e.name === 'first-paint') out.firstPaint = e.startTime;
+      if (e.name === 'first-contentful-paint') out.firstContentfulPaint = e.startTime;
+    });
+  } catch (e) {}
+  return out;
+})();
+)JS";
+}
+
+/**
+ * @brief Forwards to SplitWindow's private frame operations (friend of SplitWindow).
+ */
+class SplitWindowBench {
+public:
+  static void rebuildSections(SplitWindow *w, int n) { w->rebuildSections(n); }
+  static bool addSingleFrame(SplitWindow *w, int afterIndex) { return w->addSingleFrame(afterIndex); }
+  static void removeSingleFrame(SplitWindow *w, SplitFrameWidget *frame) { w->removeSingleFrame(frame); }
+  static void setLayoutMode(SplitWindow *w, SplitWindow::LayoutMode m) { w->setLayoutMode(m); }
+  static QString windowId(SplitWindow *w) { return w->windowId_; }
+};
+
+/**
+ * @brief Drops SessionStore's in-memory state so load() reads the files again (friend of SessionStore).
+ */
+class SessionStoreBench {
+public:
+  /** @brief Blocks until every queued journal append and snapshot is on disk. */
+  static void waitForWrites() { SessionStore::instance().writer_.waitForDone(); }
+
+  /** @brief Waits for pending writes, then forgets everything loaded or saved so far. */
+  static void forget() {
+    SessionStore &store = SessionStore::instance();
+    store.writer_.waitForDone();
+    store.windows_.clear();
+    store.order_.clear();
+    store.lastActiveWindowId_.clear();
+    store.journalRecords_ = 0;
+    store.loaded_ = false;
+  }
+};
+
+namespace {
+
+/**
+ * @brief Minimal HTTP/1.0 server returning a generated HTML page for any path.
+ */
+class FixtureServer : public QTcpServer {
+public:
+  explicit FixtureServer(QObject *parent = nullptr) : QTcpServer(parent) {
+    connect(this, &QTcpServer::newConnection, this, [this]() {
+      while (QTcpSocket *socket = nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QObject::destroyed, this, [socket]() { pending().remove(socket); });
+        connect(socket, &QTcpSocket::readyRead, socket, [socket]() {
+          QByteArray &buffer = pending()[socket];
+          buffer += socket->readAll();
+          if (!buffer.contains("\r\n\r\n")) return; // wait for the full header block
+          const QByteArray requestLine = buffer.left(buffer.indexOf("\r\n"));
+          pending().remove(socket);
+          const QList<QByteArray> parts = requestLine.split(' ');
+          const QByteArray path = parts.size() > 1 ? parts[1] : QByteArray("/");
+          const QByteArray body = page(path);
+          QByteArray response = "HTTP/1.0 200 OK\r\nContent-Type: text/html; charset=utf-8\r\n";
+          response += "Cache-Control: no-store\r\nConnection: close\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\n\r\n";
+          response += body;
+          socket->write(response);
+          socket->disconnectFromHost();
+        });
+      }
+    });
+  }
+
+  /** @brief Returns the URL of the fixture page for a window/frame pair. */
+  QString urlFor(int window, int frame) const {
+    return QStringLiteral("http://127.0.0.1:%1/w%2/f%3").arg(serverPort()).arg(window).arg(frame);
+  }
+
+private:
+  static QHash<QTcpSocket *, QByteArray> &pending() {
+    static QHash<QTcpSocket *, QByteArray> buffers;
+    return buffers;
+  }
+
+  static QByteArray page(const QByteArray &path) {
+    const QByteArray escaped = QString::fromUtf8(path).toHtmlEscaped().toUtf8();
+    QByteArray html = "<!doctype html><html><head><title>fixture " + escaped + "</title>";
+    html += "<style>body{font-family:sans-serif;margin:16px}p{margin:4px 0}.card{border:1px solid #ccc;padding:8px}</style>";
+    html += "</head><body><h1>Phraims bench fixture " + escaped + "</h1><div class=\"card\">";
+    for (int i = 0; i < FIXTURE_PARAGRAPHS; ++i) {
+      html += "<p>Paragraph " + QByteArray::number(i) + " of the benchmark fixture page.</p>";
+    }
+    html += "</div></body></html>";
+    return html;
+  }
+};
+
+/** @brief Summarizes a list of millisecond samples. */
+QJsonObject stats(std::vector<double> samples) {
+  QJsonObject o;
+  o["count"] = int(samples.size());
+  if (samples.empty()) return o;
+  std::sort(samples.begin(), samples.end());
+  o["minMs"] = samples.front();
+  o["medianMs"] = samples[samples.size() / 2];
+  o["meanMs"] = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+  o["maxMs"] = samples.back();
+  return o;
+}
+
+double elapsedMs(const QElapsedTimer &t) { return t.nsecsElapsed() / 1e6; }
+
+/**
+ * @brief Drives the benchmark scenarios and collects results.
+ */
+class Bench {
+public:
+  Bench(FixtureServer *server, int windows, int frames, int iterations)
+    : server_(server), windowCount_(windows), frameCount_(frames), iterations_(iterations) {}
+
+  QJsonObject run() {
+    QJsonObject result;
+    result["phraimsVersion"] = QStringLiteral(PHRAIMS_VERSION);
+    result["qtVersion"] = QString::fromLatin1(qVersion());
+    result["platform"] = QGuiApplication::platformName();
+    result["windows"] = windowCount_;
+    result["framesPerWindow"] = frameCount_;
+    result["iterations"] = iterations_;
+
+    openWindows();
+    QJsonObject timings;
+    timings["openWindow"] = stats(openWindowMs_);
+    timings["addSingleFrameWhileOpening"] = stats(addFrameMs_);
+    timings["initialLoadAll"] = stats({initialLoadMs_});
+    const QJsonArray initialFrames = collectFrameTimings();
+
+    benchLayoutModes();
+    timings["setLayoutMode"] = stats(layoutMs_);
+    benchAddRemove();
+    timings["addSingleFrame"] = stats(addFrameMs_);
+    timings["removeSingleFrame"] = stats(removeFrameMs_);
+    benchRebuild();
+    timings["rebuildSections"] = stats(rebuildMs_);
+    result["timings"] = timings;
+    result["initialFrames"] = initialFrames;
+
+    result["restore"] = benchRestore();
+    result["peakRssBytes"] = double(peakRssBytes_);
+    return result;
+  }
+
+private:
+  /** @brief Spins the event loop until @p done returns true or the timeout passes. */
+  bool waitUntil(const std::function<bool()> &done, int timeoutMs = LOAD_TIMEOUT_MS) {
+    QElapsedTimer t;
+    t.start();
+    QElapsedTimer sinceSample;
+    sinceSample.start();
+    sampleRss();
+    while (!done()) {
+      if (t.elapsed() > timeoutMs) {
+        qWarning() << "phraims-bench: timed out after" << timeoutMs << "ms";
+        return false;
+      }
+      QEventLoop loop;
+      QTimer::singleShot(10, &loop, &QEventLoop::quit);
+      loop.exec();
+      if (sinceSample.elapsed() >= RSS_SAMPLE_MS) {
+        sampleRss();
+        sinceSample.restart();
+      }
+    }
+    sampleRss();
+    return true;
+  }
+
+  /** @brief Lets queued events (layout, deferred deletes) run once. */
+  void settle() {
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QCoreApplication::processEvents();
+  }
+
+  std::vector<SplitFrameWidget *> allFrames() const {
+    std::vector<SplitFrameWidget *> out;
+    for (SplitWindow *w : g_windows) {
+      if (!w) continue;
+      const auto &frames = w->frameWidgets();
+      out.insert(out.end(), frames.begin(), frames.end());
+    }
+    return out;
+  }
+
+  /** @brief Sums resident memory of this process and every renderer; keeps the peak. */
+  void sampleRss() {
+    QSet<qint64> pids;
+    pids.insert(QCoreApplication::applicationPid());
+    for (SplitFrameWidget *frame : allFrames()) {
+      if (QWebEnginePage *page = frame->page()) {
+        if (page->renderProcessPid() > 0) pids.insert(page->renderProcessPid());
+      }
+    }
+    qint64 total = 0;
+    for (qint64 pid : std::as_const(pids)) {
+      qint64 resident = 0;
+      qint64 cpuNs = 0;
+      if (FrameMetricsSampler::readProcessStats(pid, &resident, &cpuNs)) total += resident;
+    }
+    peakRssBytes_ = std::max(peakRssBytes_, total);
+  }
+
+  /** @brief Starts tracking load completion for every current frame. */
+  void trackLoads() {
+    loaded_.clear();
+    loadClock_.start();
+    for (SplitFrameWidget *frame : allFrames()) watchFrame(frame);
+  }
+
+  void watchFrame(SplitFrameWidget *frame) {
+    QObject::connect(frame, &SplitFrameWidget::pageLoadFinished, frame, [this](SplitFrameWidget *who, bool) {
+      // ignore the instruction page empty frames show; only fixture loads count
+      QWebEnginePage *page = who->page();
+      if (!page || !page->url().scheme().startsWith(QStringLiteral("http"))) return;
+      if (!loaded_.contains(who)) loaded_.insert(who, elapsedMs(loadClock_));
+    }, Qt::UniqueConnection);
+  }
+
+  bool waitForAllLoaded() {
+    return waitUntil([this]() {
+      const auto frames = allFrames();
+      return std::all_of(frames.begin(), frames.end(), [this](SplitFrameWidget *f) { return loaded_.contains(f); });
+    });
+  }
+
+  void openWindows() {
+    loadClock_.start();
+    QElapsedTimer total;
+    total.start();
+    for (int wi = 0; wi < windowCount_; ++wi) {
+      QElapsedTimer t;
+      t.start();
+      createAndShowWindow(server_->urlFor(wi, 0));
+      openWindowMs_.push_back(elapsedMs(t));
+      SplitWindow *w = g_windows.back();
+      for (SplitFrameWidget *frame : w->frameWidgets()) watchFrame(frame);
+      settle(); // runs the queued setFirstFrameAddress
+      for (int fi = 1; fi < frameCount_; ++fi) {
+        QElapsedTimer ta;
+        ta.start();
+        SplitWindowBench::addSingleFrame(w, fi - 1);
+        addFrameMs_.push_back(elapsedMs(ta));
+        SplitFrameWidget *frame = w->frameWidgets()[fi];
+        watchFrame(frame);
+        frame->setAddress(server_->urlFor(wi, fi));
+      }
+    }
+    waitForAllLoaded();
+    initialLoadMs_ = elapsedMs(total);
+  }
+
+  /** @brief Reads paint timings for every frame (one script per frame). */
+  QJsonArray collectFrameTimings() {
+    // Shared so late callbacks after a timeout don't touch a dead stack frame.
+    struct Replies {
+      QJsonArray frames;
+      int pending = 0;
+    };
+    auto replies = std::make_shared<Replies>();
+    QJsonArray &out = replies->frames;
+    int wi = 0;
+    for (SplitWindow *w : g_windows) {
+      int fi = 0;
+      for (SplitFrameWidget *frame : w->frameWidgets()) {
+        const int index = out.size();
+        QJsonObject o;
+        o["window"] = wi;
+        o["frame"] = fi++;
+        o["loadMs"] = loaded_.value(frame, -1);
+        out.append(o);
+        QWebEnginePage *page = frame->page();
+        if (!page) continue;
+        ++replies->pending;
+        page->runJavaScript(QString::fromLatin1(kPaintTimingScript), [replies, index](const QVariant &v) {
+          QJsonObject o = replies->frames[index].toObject();
+          const QVariantMap map = v.toMap();
+          o["firstPaintMs"] = map.value(QStringLiteral("firstPaint"), -1).toDouble();
+          o["firstContentfulPaintMs"] = map.value(QStringLiteral("firstContentfulPaint"), -1).toDouble();
+          replies->frames[index] = o;
+          --replies->pending;
+        });
+      }
+      ++wi;
+    }
+    if (!waitUntil([replies]() { return replies->pending == 0; }, 10000)) {
+      qWarning() << "phraims-bench: paint timings incomplete," << replies->pending << "missing";
+    }
+    return replies->frames;
+  }
+
+  void benchLayoutModes() {
+    const SplitWindow::LayoutMode modes[] = {SplitWindow::Grid, SplitWindow::Horizontal, SplitWindow::Vertical};
+    for (int i = 0; i < iterations_; ++i) {
+      for (SplitWindow *w : g_windows) {
+        for (SplitWindow::LayoutMode m : modes) {
+          QElapsedTimer t;
+          t.start();
+          SplitWindowBench::setLayoutMode(w, m);
+          layoutMs_.push_back(elapsedMs(t));
+          settle();
+        }
+      }
+    }
+  }
+
+  void benchAddRemove() {
+    addFrameMs_.clear();
+    for (int i = 0; i < iterations_; ++i) {
+      for (SplitWindow *w : g_windows) {
+        const int last = int(w->frameWidgets().size()) - 1;
+        QElapsedTimer ta;
+        ta.start();
+        SplitWindowBench::addSingleFrame(w, last);
+        addFrameMs_.push_back(elapsedMs(ta));
+        settle();
+        SplitFrameWidget *added = w->frameWidgets().back();
+        QElapsedTimer tr;
+        tr.start();
+        SplitWindowBench::removeSingleFrame(w, added);
+        removeFrameMs_.push_back(elapsedMs(tr));
+        settle();
+      }
+    }
+  }
+
+  void benchRebuild() {
+    for (int i = 0; i < iterations_; ++i) {
+      for (SplitWindow *w : g_windows) {
+        QElapsedTimer t;
+        t.start();
+        SplitWindowBench::rebuildSections(w, frameCount_);
+        rebuildMs_.push_back(elapsedMs(t));
+      }
+      // rebuildSections reloads every page; let them finish before the next round
+      trackLoads();
+      waitForAllLoaded();
+    }
+  }
+
+  QJsonObject benchRestore() {
+    QJsonObject o;
+    for (SplitWindow *w : g_windows) w->savePersistentStateToSettings();
+    AppSettings::flushDeferred();
+
+    // Quit path: encode and write the snapshot, truncate the journal.
+    SessionStore &store = SessionStore::instance();
+    QElapsedTimer flushClock;
+    flushClock.start();
+    store.flush();
+    o["sessionFlushMs"] = elapsedMs(flushClock);
+
+    // Journal one more save per window on top of the snapshot, then read
+    // both back from disk the way startup does.
+    for (SplitWindow *w : g_windows) w->savePersistentStateToSettings();
+    SessionStoreBench::waitForWrites();
+    o["sessionSnapshotBytes"] = double(QFileInfo(SessionStore::snapshotPath()).size());
+    o["sessionJournalBytes"] = double(QFileInfo(SessionStore::journalPath()).size());
+    SessionStoreBench::forget();
+    QElapsedTimer loadClock;
+    loadClock.start();
+    store.load();
+    o["sessionLoadMs"] = elapsedMs(loadClock);
+    // load() folds the replayed records into a new snapshot; keep that write out of the restore timing
+    SessionStoreBench::waitForWrites();
+    const QStringList ids = store.windowIds();
+
+    // Destroy windows without closeEvent, which would remove them from the session.
+    const std::vector<SplitWindow *> windows = g_windows;
+    for (SplitWindow *w : windows) delete w;
+    settle();
+
+    QElapsedTimer restoreClock;
+    restoreClock.start();
+    RestoreScheduler::instance().beginRestore(restoreClock);
+    for (const QString &id : std::as_const(ids)) createAndShowWindow(QString(), id);
+    RestoreScheduler::instance().commitRestore();
+    o["constructMs"] = elapsedMs(restoreClock);
+
+    trackLoads();
+    const bool ok = waitForAllLoaded();
+    o["allFramesLoadedMs"] = elapsedMs(restoreClock);
+    o["complete"] = ok;
+    o["firstInteractiveMs"] = double(RestoreScheduler::instance().firstInteractiveMs());
+    o["frames"] = collectFrameTimings();
+    return o;
+  }
+
+  FixtureServer *server_;
+  int windowCount_;
+  int frameCount_;
+  int iterations_;
+  QElapsedTimer loadClock_;
+  QHash<SplitFrameWidget *, double> loaded_;
+  std::vector<double> openWindowMs_;
+  std::vector<double> addFrameMs_;
+  std::vector<double> removeFrameMs_;
+  std::vector<double> layoutMs_;
+  std::vector<double> rebuildMs_;
+  double initialLoadMs_ = -1;
+  qint64 peakRssBytes_ = 0;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // Headless by default; --visible must be known before QApplication exists.
+  bool visible = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--visible") == 0) visible = true;
+  }
+  if (!visible && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QCoreApplication::setOrganizationName(QStringLiteral("LookAtWhatAiCanDo"));
+  QCoreApplication::setOrganizationDomain("LookAtWhatAiCanDo.llc");
+  // Separate application name keeps settings.ini and profiles away from the real app.
+  QCoreApplication::setApplicationName(QStringLiteral("phraims-bench"));
+  QApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral("Phraims frame/window scaling benchmark"));
+  parser.addHelpOption();
+  QCommandLineOption windowsOpt(QStringLiteral("windows"), QStringLiteral("Number of windows (N)."), QStringLiteral("n"), QString::number(DEFAULT_WINDOWS));
+  QCommandLineOption framesOpt(QStringLiteral("frames"), QStringLiteral("Frames per window (M)."), QStringLiteral("m"), QString::number(DEFAULT_FRAMES));
+  QCommandLineOption iterOpt(QStringLiteral("iterations"), QStringLiteral("Repetitions per operation."), QStringLiteral("k"), QString::number(DEFAULT_ITERATIONS));
+  QCommandLineOption outputOpt(QStringLiteral("output"), QStringLiteral("Write JSON results to this file instead of stdout."), QStringLiteral("file"));
+  QCommandLineOption visibleOpt(QStringLiteral("visible"), QStringLiteral("Show windows instead of using the offscreen platform."));
+  parser.addOptions({windowsOpt, framesOpt, iterOpt, outputOpt, visibleOpt});
+  parser.process(app);
+
+  const int windows = std::max(1, parser.value(windowsOpt).toInt());
+  const int frames = std::max(1, parser.value(framesOpt).toInt());
+  const int iterations = std::max(1, parser.value(iterOpt).toInt());
+
+  // Start from a clean bench data directory every run.
+  const QString dataRoot = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  QDir(dataRoot).removeRecursively();
+  QDir().mkpath(dataRoot);
+
+  createWindowMenuIcons();
+  // as in main(): the store must be loaded before windows save into it
+  SessionStore::instance().load();
+
+  FixtureServer server;
+  if (!server.listen(QHostAddress::LocalHost, 0)) {
+    qWarning() << "phraims-bench: cannot start fixture server:" << server.errorString();
+    return 1;
+  }
+  qDebug() << "phraims-bench: fixture server on port" << server.serverPort() << "windows=" << windows
+           << "frames=" << frames << "iterations=" << iterations;
+
+  Bench bench(&server, windows, frames, iterations);
+  const QByteArray json = QJsonDocument(bench.run()).toJson(QJsonDocument::Indented);
+
+  if (parser.isSet(outputOpt)) {
+    QFile f(parser.value(outputOpt));
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qWarning() << "phraims-bench: cannot write" << f.fileName();
+      return 1;
+    }
+    f.write(json);
+    qDebug() << "phraims-bench: wrote results to" << f.fileName();
+  } else {
+    std::cout << json.constData() << std::endl;
+  }
+
+  // Saved windows live in the bench's own data directory; drop everything.
+  const std::vector<SplitWindow *> remaining = g_windows;
+  for (SplitWindow *w : remaining) delete w;
+  AppSettings::flushDeferred();
+  return 0;
+}
@@ -2,51 +2,69 @@
  * Qt6 Widgets web browser that divides each window into multiple resizable web page frames.
  */
 #include "AppSettings.h"
+#include "EngineConfig.h"
+#include "InstanceIpc.h"
+#include "LocalScheme.h"
+#include "MemoryBudget.h"
+#include "RestoreScheduler.h"
+#include "SessionStore.h"
+#include "SnapshotCache.h"
 #include "SplitWindow.h"
+#include "Trace.h"
+#include "UpdateScheduler.h"
 #include "Utils.h"
+#include "WindowListModel.h"
 #include "version.h"
 #include <QApplication>
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QGuiApplication>
 #include <QIcon>
 #include <QLoggingCategory>
-#include <QLocalServer>
-#include <QLocalSocket>
+#include <QMessageBox>
 #include <QStandardPaths>
-#include <QThread>
+#include <QTimer>
+#include <optional>
 
 int main(int argc, char **argv) {
+  // Measures startup from process entry; RestoreScheduler reports
+  // time-to-first-interactive-frame against this clock.
+  QElapsedTimer startupClock;
+  startupClock.start();
+
   QCoreApplication::setOrganizationName(QStringLiteral("LookAtWhatAiCanDo"));
   QCoreApplication::setOrganizationDomain("LookAtWhatAiCanDo.llc");
   QCoreApplication::setApplicationName(QStringLiteral("Phraims"));
-  // Single-instance guard (activation-only): if another process is already
-  // running, ask it to activate/focus itself and exit. We do NOT forward
-  // command-line args in this simplified mode -- we only request activation.
-  const QString serverName = QStringLiteral("LookAtWhatAiCanDo_Phraims_server");
+  // Optional chrome://tracing output (PHRAIMS_TRACE=1 or trace/enabled).
+  initTracing();
+  // Single-instance guard: if another process is already running, forward
+  // our command line (URLs, --new-frame, --layout, --profile; or just
+  // "activate") to it and exit. Fails fast when no server exists.
+  QStringList startupArgs;
+  for (int i = 1; i < argc; ++i) startupArgs << QString::fromLocal8Bit(argv[i]);
+  const InstanceCommand startupCommand = InstanceCommand::fromArguments(startupArgs);
   {
-    QLocalSocket probe;
-    const int maxAttempts = 6;
-    bool connected = false;
-    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
-      probe.connectToServer(serverName);
-      if (probe.waitForConnected(250)) { connected = true; break; }
-      // give the primary a moment to finish starting up
-      QThread::msleep(100);
-    }
-    if (connected) {
-      // Send a tiny activation message (server will ignore payload content).
-      const QByteArray msg = QByteArrayLiteral("ACT");
-      probe.write(msg);
-      probe.flush();
-      probe.waitForBytesWritten(200);
+    PHRAIMS_TRACE_SCOPE("singleInstanceProbe");
+    if (sendToRunningInstance(startupCommand)) {
+      traceInstant("secondInstanceExit");
+      writeTraceFile();
       return 0; // exit second instance
     }
   }
 
+  // Chromium reads its switches once, so engine/* settings (and the crash
+  // sentinel that falls back to safe mode) must be applied before QApplication.
+  applyEngineConfig();
+  // Custom URL schemes must also be registered before QApplication.
+  LocalSchemeHandler::registerScheme();
+
   QLoggingCategory::setFilterRules(QStringLiteral("qt.webenginecontext.debug=true"));
+  // app must outlive any block, so this scope is ended by hand
+  std::optional<TraceScope> appConstructTrace(std::in_place, "QApplication");
   QApplication app(argc, argv);
+  appConstructTrace.reset();
   app.setWindowIcon(QIcon(QStringLiteral(":/icons/phraims.ico")));
 
   // Log application version at startup
@@ -57,12 +75,13 @@ int main(int argc, char **argv) {
   app.setAttribute(Qt::AA_DontShowIconsInMenus, false);
 
   // Refresh Window menus when application focus or state changes so the
-  // active/minimized indicators remain accurate across platforms.
+  // active/minimized indicators remain accurate across platforms. Focus moves
+  // that stay within one window don't touch the menus at all.
   QObject::connect(&app, &QApplication::focusChanged, [](QObject *, QObject *) {
-    rebuildAllWindowMenus();
+    WindowListModel::instance().activeWindowMaybeChanged();
   });
   QObject::connect(qApp, &QGuiApplication::applicationStateChanged, [](Qt::ApplicationState) {
-    rebuildAllWindowMenus();
+    WindowListModel::instance().refreshStates();
   });
 
   // Create the small icons used by the Window menu once here (after the
@@ -75,16 +94,25 @@ int main(int argc, char **argv) {
   AppSettings settings; // unified handle to shared settings
   qDebug() << "  AppSettings - format:" << settings->format() << "-> fileName:" << settings->fileName();
 
+  // Listen before the (possibly slow) session restore so a second launch
+  // forwards to us instead of starting another instance; commands that
+  // arrive meanwhile are applied once the event loop runs.
+  InstanceServer::instance().listen();
+
   // Perform idempotent legacy migration if required.
   // This centralizes migration behavior (atomic, logged, and only runs once).
   performLegacyMigration();
 
-  // Restore saved windows from last session if present. We store per-window
-  // data under AppSettings group "windows/<id>".
+  // Restore saved windows from last session if present. Per-window data
+  // lives in SessionStore (snapshot + journal; imported from the old
+  // "windows/<id>" settings groups on first run). Page loads are deferred to
+  // RestoreScheduler, which loads the last active window's focused frame
+  // first and the rest with bounded concurrency once windows are shown.
+  SessionStore::instance().load();
+  RestoreScheduler::instance().beginRestore(startupClock);
   {
-    settings->beginGroup(QStringLiteral("windows"));
-    QStringList ids = settings->childGroups();
-    settings->endGroup();
+    PHRAIMS_TRACE_SCOPE("restoreWindows");
+    const QStringList ids = SessionStore::instance().windowIds();
     qDebug() << "Startup: persisted window ids:" << ids;
     if (ids.isEmpty()) {
       // Fallback: check explicit migrated index (written during migration)
@@ -104,56 +132,50 @@ int main(int argc, char **argv) {
       }
     }
   }
+  RestoreScheduler::instance().commitRestore();
+  // Budget enforcement starts once restored frames are tracked by their windows.
+  MemoryBudget::instance().start();
+  // Background update checks wait until restored pages have loaded.
+  UpdateScheduler::instance().start();
 
-  // Create and start the QLocalServer for subsequent instances to connect
-  // and ask this process to open windows/URLs.
-  QLocalServer *localServer = new QLocalServer(&app);
-  // Remove any stale server socket before listening
-  QLocalServer::removeServer(serverName);
-  if (!localServer->listen(serverName)) {
-    qWarning() << "Failed to listen on local server:" << localServer->errorString();
-  } else {
-    QObject::connect(localServer, &QLocalServer::newConnection, &app, [localServer]() {
-      QLocalSocket *client = localServer->nextPendingConnection();
-      if (!client) return;
-      QObject::connect(client, &QLocalSocket::disconnected, client, &QLocalSocket::deleteLater);
-      QObject::connect(client, &QLocalSocket::readyRead, client, [client]() {
-        // Activation-only: ignore any payload content and just raise/activate
-        // an existing window in this process.
-        QMetaObject::invokeMethod(qApp, []() {
-          if (!g_windows.empty()) {
-            SplitWindow *best = nullptr;
-            // prefer an already-active window, otherwise first available
-            for (SplitWindow *w : g_windows) {
-              if (!w) continue;
-              if (w->isActiveWindow()) { best = w; break; }
-              if (!best) best = w;
-            }
-            if (best) {
-              if (!best->isVisible()) best->show();
-              if (best->isMinimized()) best->showNormal();
-              best->raise();
-              best->activateWindow();
-            }
-          }
-        }, Qt::QueuedConnection);
-        client->disconnectFromServer();
-      });
+  if (isEngineSafeMode()) {
+    QTimer::singleShot(0, &app, []() {
+      auto *box = new QMessageBox(QMessageBox::Warning, QCoreApplication::applicationName(),
+                                  QObject::tr("Phraims started in safe mode because it crashed during startup. "
+                                              "Custom engine settings are ignored until you save them again in "
+                                              "Tools -> Engine Settings."),
+                                  QMessageBox::Ok, g_windows.empty() ? nullptr : g_windows.front());
+      box->setAttribute(Qt::WA_DeleteOnClose);
+      box->show();
     });
   }
 
+  // Our own URLs/options are handled like a forwarded launch, after the
+  // restored windows exist.
+  if (!startupCommand.isActivateOnly()) InstanceServer::instance().submit(startupCommand);
+
   // Before quitting, persist state for all open windows so the session
   // (window geometry, layout, addresses and splitter sizes) is restored
   // on next launch. This will create per-window groups for windows that
   // did not previously have a persistent id.
   QObject::connect(&app, &QCoreApplication::aboutToQuit, []() {
-    qDebug() << "aboutToQuit: saving" << g_windows.size() << "windows to AppSettings";
+    qDebug() << "aboutToQuit: saving" << g_windows.size() << "windows to the session";
     for (SplitWindow *w : g_windows) {
       if (!w) continue;
       // Use the new public helper to save each window's persistent state.
       w->savePersistentStateToSettings();
     }
+    // Guarantee coalesced write-behind values reach disk before exit.
+    AppSettings::flushDeferred();
+    SessionStore::instance().flush();
+    SnapshotCache::instance().flush();
+    // quitting cleanly (even mid-restore) is not a startup crash
+    markEngineStartupSucceeded();
+    qDebug() << "aboutToQuit: write-behind coalesced" << AppSettings::deferredSetCount()
+             << "deferred sets into" << AppSettings::deferredWriteCount() << "settings writes";
+    writeTraceFile();
   });
 
+  traceInstant("enterEventLoop");
   return app.exec();
 }